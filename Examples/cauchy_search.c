@@ -0,0 +1,129 @@
+/* *
+ * Copyright (c) 2014, James S. Plank and Kevin Greenan
+ * All rights reserved.
+ *
+ * Jerasure - A C/C++ Library for a Variety of Reed-Solomon and RAID-6 Erasure
+ * Coding Techniques
+ *
+ * Revision 2.0: Galois Field backend now links to GF-Complete
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *  - Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ *  - Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ *
+ *  - Neither the name of the University of Tennessee nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY
+ * WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/* Jerasure's authors:
+
+   Revision 2.x - 2014: James S. Plank and Kevin M. Greenan.
+   Revision 1.2 - 2008: James S. Plank, Scott Simmerman and Catherine D. Schuman.
+   Revision 1.0 - 2007: James S. Plank.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "jerasure.h"
+#include "cauchy.h"
+
+#define talloc(type, num) (type *) malloc(sizeof(type)*(num))
+
+static void usage(char *s)
+{
+  fprintf(stderr, "usage: cauchy_search m w min-k max-k iterations threads seed\n");
+  fprintf(stderr, "       \n");
+  fprintf(stderr, "For every k from min-k to max-k, this searches for Cauchy matrices in GF(2^w)\n");
+  fprintf(stderr, "with m coding rows whose bitmatrices have few ones, using iterations candidates\n");
+  fprintf(stderr, "per k and the given number of threads.  It prints the X and Y sets as the\n");
+  fprintf(stderr, "rows of a C table, like the ones that cauchy_best_coding_matrix() uses.\n");
+  fprintf(stderr, "Each row starts with X, then Y, padded with zeros to m+max-k entries, and\n");
+  fprintf(stderr, "is { -1 } when k+m > 2^w.  The comments give the number of ones and the\n");
+  fprintf(stderr, "number of ones of cauchy_original_coding_matrix() after improvement.\n");
+  fprintf(stderr, "       \n");
+  fprintf(stderr, "This demonstrates: cauchy_search_xy()\n");
+  fprintf(stderr, "                   cauchy_xy_coding_matrix()\n");
+  fprintf(stderr, "                   cauchy_improve_coding_matrix()\n");
+  fprintf(stderr, "                   cauchy_n_ones()\n");
+  if (s != NULL) fprintf(stderr, "%s\n", s);
+  exit(1);
+}
+
+static int matrix_ones(int k, int m, int w, int *matrix)
+{
+  int i, no;
+
+  cauchy_improve_coding_matrix(k, m, w, matrix);
+  no = 0;
+  for (i = 0; i < k*m; i++) no += cauchy_n_ones(matrix[i], w);
+  return no;
+}
+
+int main(int argc, char **argv)
+{
+  int m, w, mink, maxk, iterations, threads, k, i, no, orig, check;
+  int *X, *Y, *matrix;
+  unsigned int seed;
+
+  if (argc != 8) usage(NULL);
+  if (sscanf(argv[1], "%d", &m) == 0 || m <= 0) usage("Bad m");
+  if (sscanf(argv[2], "%d", &w) == 0 || w <= 0 || w > 32) usage("Bad w");
+  if (sscanf(argv[3], "%d", &mink) == 0 || mink <= 0) usage("Bad min-k");
+  if (sscanf(argv[4], "%d", &maxk) == 0 || maxk < mink) usage("Bad max-k");
+  if (sscanf(argv[5], "%d", &iterations) == 0 || iterations <= 0) usage("Bad iterations");
+  if (sscanf(argv[6], "%d", &threads) == 0 || threads <= 0) usage("Bad threads");
+  if (sscanf(argv[7], "%u", &seed) == 0) usage("Bad seed");
+
+  X = talloc(int, m);
+  Y = talloc(int, maxk);
+
+  printf("  { /* w = %d */\n", w);
+  for (k = mink; k <= maxk; k++) {
+    if (w < 31 && k+m > (1 << w)) {
+      printf("    { -1 }%s /* k = %d */\n", (k < maxk) ? "," : "", k);
+      continue;
+    }
+    no = cauchy_search_xy(k, m, w, iterations, threads, seed, X, Y);
+    matrix = cauchy_original_coding_matrix(k, m, w);
+    orig = matrix_ones(k, m, w, matrix);
+    free(matrix);
+    matrix = cauchy_xy_coding_matrix(k, m, w, X, Y);
+    check = matrix_ones(k, m, w, matrix);
+    free(matrix);
+    if (check != no) {
+      fprintf(stderr, "Internal error: k = %d: %d ones reported, %d found\n", k, no, check);
+      exit(1);
+    }
+
+    printf("    { ");
+    for (i = 0; i < m; i++) printf("%d, ", X[i]);
+    for (i = 0; i < maxk; i++) printf("%d%s", (i < k) ? Y[i] : 0, (i < maxk-1) ? ", " : "");
+    printf(" }%s /* k = %d: %d ones, was %d */\n", (k < maxk) ? "," : "", k, no, orig);
+    fflush(stdout);
+  }
+  printf("  },\n");
+  return 0;
+}
@@ -0,0 +1,225 @@
+/* *
+ * Copyright (c) 2014, James S. Plank and Kevin Greenan
+ * All rights reserved.
+ *
+ * Jerasure - A C/C++ Library for a Variety of Reed-Solomon and RAID-6 Erasure
+ * Coding Techniques
+ *
+ * Revision 2.0: Galois Field backend now links to GF-Complete
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *  - Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ *  - Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ *
+ *  - Neither the name of the University of Tennessee nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY
+ * WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/* Jerasure's authors:
+
+   Revision 2.x - 2014: James S. Plank and Kevin M. Greenan.
+   Revision 1.2 - 2008: James S. Plank, Scott Simmerman and Catherine D. Schuman.
+   Revision 1.0 - 2007: James S. Plank.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <gf_rand.h>
+#include "jerasure.h"
+#include "clay.h"
+
+#define talloc(type, num) (type *) malloc(sizeof(type)*(num))
+
+static void usage(char *s)
+{
+  fprintf(stderr, "usage: clay_01 k m w seed - Encodes, decodes and repairs with a Clay code.\n");
+  fprintf(stderr, "       \n");
+  fprintf(stderr, "It encodes k random data chunks into m coding chunks, then erases m random\n");
+  fprintf(stderr, "devices and decodes them.  Then it erases one random device and repairs it.\n");
+  fprintf(stderr, "Each of the other devices is a helper process that sends its repair\n");
+  fprintf(stderr, "sub-chunks over a pipe.  It prints how many bytes the repair read,\n");
+  fprintf(stderr, "compared to the k chunks that a Reed-Solomon repair reads.\n");
+  fprintf(stderr, "       \n");
+  fprintf(stderr, "This demonstrates: clay_create()\n");
+  fprintf(stderr, "                   clay_encode()\n");
+  fprintf(stderr, "                   clay_decode()\n");
+  fprintf(stderr, "                   clay_repair_sub_chunks()\n");
+  fprintf(stderr, "                   clay_repair_pack()\n");
+  fprintf(stderr, "                   clay_repair()\n");
+  if (s != NULL) fprintf(stderr, "%s\n", s);
+  exit(1);
+}
+
+/* Forks a helper that sends its packed repair sub-chunks to fd */
+
+static pid_t start_helper(clay_code_t *c, int lost, char *chunk, int size, int *fd)
+{
+  int p[2], n, done;
+  char *out;
+  pid_t pid;
+
+  if (pipe(p) < 0) { perror("pipe"); exit(1); }
+  pid = fork();
+  if (pid < 0) { perror("fork"); exit(1); }
+  if (pid == 0) {
+    close(p[0]);
+    out = talloc(char, size/c->m);
+    clay_repair_pack(c, lost, chunk, out, size);
+    for (done = 0; done < size/c->m; done += n) {
+      n = write(p[1], out+done, size/c->m-done);
+      if (n <= 0) _exit(1);
+    }
+    _exit(0);
+  }
+  close(p[1]);
+  *fd = p[0];
+  return pid;
+}
+
+static int read_all(int fd, char *buf, int size)
+{
+  int n, done;
+
+  for (done = 0; done < size; done += n) {
+    n = read(fd, buf+done, size-done);
+    if (n <= 0) return done;
+  }
+  return done;
+}
+
+int main(int argc, char **argv)
+{
+  int k, m, w, i, j, size, lost, total, nsc;
+  int *erasures, *erased, *sub_chunks, *fds;
+  char **data, **coding, **copy, **helpers, *dest;
+  pid_t *pids;
+  clay_code_t *c;
+  uint32_t seed;
+
+  if (argc != 5) usage(NULL);
+  if (sscanf(argv[1], "%d", &k) == 0 || k <= 0) usage("Bad k");
+  if (sscanf(argv[2], "%d", &m) == 0 || m < 2) usage("Bad m");
+  if (sscanf(argv[3], "%d", &w) == 0 || (w != 8 && w != 16 && w != 32)) usage("Bad w");
+  if (sscanf(argv[4], "%u", &seed) == 0) usage("Bad seed");
+
+  c = clay_create(k, m, w);
+  if (c == NULL) usage("Bad parameters for a Clay code");
+  size = clay_sub_chunks(c) * sizeof(long) * 4;
+
+  printf("clay_01 %d %d %d %d\n\n", k, m, w, seed);
+  printf("Virtual devices: %d.  Sub-chunks per chunk: %d.  Chunk size: %d bytes.\n\n",
+         c->nu, clay_sub_chunks(c), size);
+
+  MOA_Seed(seed);
+  data = talloc(char *, k);
+  coding = talloc(char *, m);
+  copy = talloc(char *, k+m);
+  for (i = 0; i < k; i++) {
+    data[i] = talloc(char, size);
+    MOA_Fill_Random_Region(data[i], size);
+  }
+  for (i = 0; i < m; i++) coding[i] = talloc(char, size);
+  if (clay_encode(c, data, coding, size) < 0) {
+    fprintf(stderr, "clay_encode failed\n");
+    exit(1);
+  }
+  for (i = 0; i < k+m; i++) {
+    copy[i] = talloc(char, size);
+    memcpy(copy[i], (i < k) ? data[i] : coding[i-k], size);
+  }
+
+  /* Erase and decode m random devices */
+
+  erasures = talloc(int, m+1);
+  erased = talloc(int, k+m);
+  for (i = 0; i < k+m; i++) erased[i] = 0;
+  for (i = 0; i < m; ) {
+    j = MOA_Random_W(31, 0)%(k+m);
+    if (erased[j] == 0) {
+      erased[j] = 1;
+      erasures[i++] = j;
+    }
+  }
+  erasures[i] = -1;
+  printf("Erased:");
+  for (i = 0; i < m; i++) {
+    printf(" %d", erasures[i]);
+    memset((erasures[i] < k) ? data[erasures[i]] : coding[erasures[i]-k], 0, size);
+  }
+  printf("\n");
+  if (clay_decode(c, erasures, data, coding, size) < 0) {
+    printf("ERROR: clay_decode failed\n");
+  }
+  for (i = 0; i < k+m; i++) {
+    if (memcmp((i < k) ? data[i] : coding[i-k], copy[i], size) != 0) {
+      printf("ERROR: Device %d after decoding does not match its state before decoding!\n", i);
+    }
+  }
+  printf("Decoding read %d bytes.\n\n", k*size);
+
+  /* Repair one random device from helper processes */
+
+  lost = MOA_Random_W(31, 0)%(k+m);
+  sub_chunks = talloc(int, clay_sub_chunks(c));
+  nsc = clay_repair_sub_chunks(c, lost, sub_chunks);
+  printf("Lost device %d.  Each helper sends sub-chunks:", lost);
+  for (i = 0; i < nsc && i < 16; i++) printf(" %d", sub_chunks[i]);
+  if (nsc > 16) printf(" ...");
+  printf("\n");
+
+  fds = talloc(int, k+m);
+  pids = talloc(pid_t, k+m);
+  helpers = talloc(char *, k+m);
+  for (i = 0; i < k+m; i++) {
+    helpers[i] = talloc(char, size/m);
+    if (i != lost) pids[i] = start_helper(c, lost, copy[i], size, fds+i);
+  }
+  total = 0;
+  for (i = 0; i < k+m; i++) {
+    if (i == lost) continue;
+    j = read_all(fds[i], helpers[i], size/m);
+    if (j != size/m) printf("ERROR: Helper %d sent %d bytes\n", i, j);
+    total += j;
+    close(fds[i]);
+    waitpid(pids[i], NULL, 0);
+  }
+
+  dest = talloc(char, size);
+  if (clay_repair(c, lost, helpers, dest, size) < 0) {
+    printf("ERROR: clay_repair failed\n");
+  } else if (memcmp(dest, copy[lost], size) != 0) {
+    printf("ERROR: Device %d after repair does not match its state before repair!\n", lost);
+  }
+  printf("Repair read %d bytes from %d helpers.  Reed-Solomon would read %d bytes (%.2f%%).\n",
+         total, k+m-1, k*size, 100.0 * total / (k*size));
+
+  clay_free(c);
+  return 0;
+}
@@ -53,6 +53,10 @@ reads in the k+m files or marks the file as erased. It then
 recreates the original file and creates a new file with the
 suffix "decoded" with the decoded contents of the file.
 
+If the files were written in the chunk format of jerasure_chunk.h, every
+stripe of every file is checked against its CRC32C, and a stripe that
+fails the check is treated as erased, just like a missing file.
+
 This program does not error check command line arguments because 
 it is assumed that encoder.c has been called previously with the
 same arguments, and encoder.c does error check.
@@ -70,23 +74,30 @@ same arguments, and encoder.c does error check.
 #include <unistd.h>
 #include "jerasure.h"
 #include "reed_sol.h"
+#include "reed_sol_fft.h"
 #include "galois.h"
 #include "cauchy.h"
 #include "liberation.h"
+#include "jerasure_stripe.h"
+#include "jerasure_chunk.h"
 #include "timing.h"
 
-#define N 10
+#define N 11
 
-enum Coding_Technique {Reed_Sol_Van, Reed_Sol_R6_Op, Cauchy_Orig, Cauchy_Good, Liberation, Blaum_Roth, Liber8tion, RDP, EVENODD, No_Coding};
+enum Coding_Technique {Reed_Sol_Van, Reed_Sol_R6_Op, Cauchy_Orig, Cauchy_Good, Liberation, Blaum_Roth, Liber8tion, RDP, EVENODD, No_Coding, Reed_Sol_FFT};
 
-char *Methods[N] = {"reed_sol_van", "reed_sol_r6_op", "cauchy_orig", "cauchy_good", "liberation", "blaum_roth", "liber8tion", "rdp", "evenodd", "no_coding"};
+char *Methods[N] = {"reed_sol_van", "reed_sol_r6_op", "cauchy_orig", "cauchy_good", "liberation", "blaum_roth", "liber8tion", "rdp", "evenodd", "no_coding", "reed_sol_fft"};
 
 /* Global variables for signal handler */
 enum Coding_Technique method;
 int readins, n;
 
-/* Function prototype */
+/* Function prototypes */
 void ctrl_bs_handler(int dummy);
+int read_chunk_header(char *fname, jerasure_chunk_header_t *h);
+FILE *open_chunk_file(char *fname, int index, int blocksize, jerasure_chunk_header_t *h);
+int read_chunk_segment(FILE *fp, jerasure_chunk_header_t *h, char *fname, int stripe,
+                       int blocksize, char *buf);
 
 int main (int argc, char **argv) {
 	FILE *fp;				// File pointer
@@ -94,6 +105,7 @@ int main (int argc, char **argv) {
 	/* Jerasure arguments */
 	char **data;
 	char **coding;
+	jerasure_stripe_t *stripe;
 	int *erasures;
 	int *erased;
 	int *matrix;
@@ -110,6 +122,11 @@ int main (int argc, char **argv) {
 	int total;				// used to write data, not padding to file
 	struct stat status;		// used to find size of individual files
 	int numerased;			// number of erased files
+	int ok;				// whether a file or stripe was read
+	int chunked;			// files are in the chunk format
+	jerasure_chunk_header_t header;
+	FILE **chunk_fp;		// open chunk files, NULL if unusable
+	jerasure_chunk_header_t *chunk_h;	// and their headers
 		
 	/* Used to recreate file names */
 	char *temp;
@@ -206,18 +223,42 @@ int main (int argc, char **argv) {
 
 	data = (char **)malloc(sizeof(char *)*k);
 	coding = (char **)malloc(sizeof(char *)*m);
-	if (buffersize != origsize) {
+
+	sprintf(temp, "%d", k);
+	md = strlen(temp);
+
+	/* The files are in the chunk format if the first one that is there
+	   starts with a chunk header */
+	chunked = 0;
+	for (i = 0; i < k+m && !chunked; i++) {
+		if (i < k) {
+			sprintf(fname, "%s/Coding/%s_k%0*d%s", curdir, cs1, md, i+1, extension);
+		} else {
+			sprintf(fname, "%s/Coding/%s_m%0*d%s", curdir, cs1, md, i-k+1, extension);
+		}
+		if (read_chunk_header(fname, &header) == 0) chunked = 1;
+	}
+	if (chunked && (header.k != k || header.m != m || header.w != w ||
+	                header.packetsize != packetsize || header.nstripes != readins)) {
+		fprintf(stderr, "Chunk headers do not match the metadata file\n");
+		exit(1);
+	}
+
+	stripe = NULL;
+	chunk_fp = NULL;
+	chunk_h = NULL;
+	if (chunked || buffersize != origsize) {
+		blocksize = (chunked) ? header.blocksize : buffersize/k;
+		stripe = jerasure_alloc_stripe(k, m, blocksize, 0);
+		if (stripe == NULL) { perror("jerasure_alloc_stripe"); exit(1); }
 		for (i = 0; i < k; i++) {
-			data[i] = (char *)malloc(sizeof(char)*(buffersize/k));
+			data[i] = stripe->data[i];
 		}
 		for (i = 0; i < m; i++) {
-			coding[i] = (char *)malloc(sizeof(char)*(buffersize/k));
+			coding[i] = stripe->coding[i];
 		}
-		blocksize = buffersize/k;
 	}
 
-	sprintf(temp, "%d", k);
-	md = strlen(temp);
 	timing_set(&t3);
 
 	/* Create coding matrix or bitmatrix */
@@ -250,6 +291,20 @@ int main (int argc, char **argv) {
 	timing_set(&t4);
 	totalsec += timing_delta(&t3, &t4);
 	
+	/* Each chunk file is opened, and its header checked, once */
+	if (chunked) {
+		chunk_fp = (FILE **)malloc(sizeof(FILE *)*(k+m));
+		chunk_h = (jerasure_chunk_header_t *)malloc(sizeof(jerasure_chunk_header_t)*(k+m));
+		for (i = 0; i < k+m; i++) {
+			if (i < k) {
+				sprintf(fname, "%s/Coding/%s_k%0*d%s", curdir, cs1, md, i+1, extension);
+			} else {
+				sprintf(fname, "%s/Coding/%s_m%0*d%s", curdir, cs1, md, i-k+1, extension);
+			}
+			chunk_fp[i] = open_chunk_file(fname, i, blocksize, chunk_h+i);
+		}
+	}
+
 	/* Begin decoding process */
 	total = 0;
 	n = 1;	
@@ -258,14 +313,19 @@ int main (int argc, char **argv) {
 		/* Open files, check for erasures, read in data/coding */	
 		for (i = 1; i <= k; i++) {
 			sprintf(fname, "%s/Coding/%s_k%0*d%s", curdir, cs1, md, i, extension);
-			fp = fopen(fname, "rb");
-			if (fp == NULL) {
+			if (chunked) {
+				ok = (read_chunk_segment(chunk_fp[i-1], chunk_h+i-1, fname, n-1, blocksize, data[i-1]) == 0);
+			} else {
+				fp = fopen(fname, "rb");
+				ok = (fp != NULL);
+			}
+			if (!ok) {
 				erased[i-1] = 1;
 				erasures[numerased] = i-1;
 				numerased++;
 				//printf("%s failed\n", fname);
 			}
-			else {
+			else if (!chunked) {
 				if (buffersize == origsize) {
 					stat(fname, &status);
 					blocksize = status.st_size;
@@ -281,14 +341,19 @@ int main (int argc, char **argv) {
 		}
 		for (i = 1; i <= m; i++) {
 			sprintf(fname, "%s/Coding/%s_m%0*d%s", curdir, cs1, md, i, extension);
+			if (chunked) {
+				ok = (read_chunk_segment(chunk_fp[k+i-1], chunk_h+k+i-1, fname, n-1, blocksize, coding[i-1]) == 0);
+			} else {
 				fp = fopen(fname, "rb");
-			if (fp == NULL) {
+				ok = (fp != NULL);
+			}
+			if (!ok) {
 				erased[k+(i-1)] = 1;
 				erasures[numerased] = k+i-1;
 				numerased++;
 				//printf("%s failed\n", fname);
 			}
-			else {
+			else if (!chunked) {
 				if (buffersize == origsize) {
 					stat(fname, &status);
 					blocksize = status.st_size;
@@ -303,7 +368,7 @@ int main (int argc, char **argv) {
 			}
 		}
 		/* Finish allocating data/coding if needed */
-		if (n == 1) {
+		if (n == 1 && stripe == NULL) {
 			for (i = 0; i < numerased; i++) {
 				if (erasures[i] < k) {
 					data[erasures[i]] = (char *)malloc(sizeof(char)*blocksize);
@@ -318,12 +383,33 @@ int main (int argc, char **argv) {
 		timing_set(&t3);
 	
 		/* Choose proper decoding method */
-		if (tech == Reed_Sol_Van || tech == Reed_Sol_R6_Op) {
+		if (tech == Reed_Sol_Van) {
 			i = jerasure_matrix_decode(k, m, w, matrix, 1, erasures, data, coding, blocksize);
 		}
-		else if (tech == Cauchy_Orig || tech == Cauchy_Good || tech == Liberation || tech == Blaum_Roth || tech == Liber8tion) {
+		else if (tech == Reed_Sol_R6_Op) {
+			i = reed_sol_r6_decode(k, w, erasures, data, coding, blocksize);
+		}
+		else if (tech == Reed_Sol_FFT) {
+			i = reed_sol_fft_decode(k, m, erasures, data, coding, blocksize);
+		}
+		else if (tech == Cauchy_Orig || tech == Cauchy_Good) {
 			i = jerasure_schedule_decode_lazy(k, m, w, bitmatrix, erasures, data, coding, blocksize, packetsize, 1);
 		}
+		else if (tech == Liberation) {
+			i = liberation_decode(k, w, erasures, data, coding, blocksize, packetsize);
+		}
+		else if (tech == Blaum_Roth) {
+			i = blaum_roth_decode(k, w, erasures, data, coding, blocksize, packetsize);
+		}
+		else if (tech == Liber8tion) {
+			i = liber8tion_decode(k, erasures, data, coding, blocksize, packetsize);
+		}
+		else if (tech == RDP) {
+			i = rdp_decode(k, w, erasures, data, coding, blocksize, packetsize);
+		}
+		else if (tech == EVENODD) {
+			i = evenodd_decode(k, w, erasures, data, coding, blocksize, packetsize);
+		}
 		else {
 			fprintf(stderr, "Not a valid coding technique.\n");
 			exit(0);
@@ -368,6 +454,13 @@ int main (int argc, char **argv) {
 	}
 	
 	/* Free allocated memory */
+	if (chunked) {
+		for (i = 0; i < k+m; i++) {
+			if (chunk_fp[i] != NULL) fclose(chunk_fp[i]);
+		}
+		free(chunk_fp);
+		free(chunk_h);
+	}
 	free(cs1);
 	free(extension);
 	free(fname);
@@ -375,6 +468,8 @@ int main (int argc, char **argv) {
 	free(coding);
 	free(erasures);
 	free(erased);
+	jerasure_free_stripe(stripe);
+	jerasure_stripe_pool_drain();
 	
 	/* Stop timing and print time */
 	timing_set(&t2);
@@ -385,6 +480,73 @@ int main (int argc, char **argv) {
 	return 0;
 }	
 
+/* Reads the header of a chunk file.  Returns -1 if the file is missing
+   or does not start with a good header. */
+
+int read_chunk_header(char *fname, jerasure_chunk_header_t *h)
+{
+	FILE *fp;
+	unsigned char buf[JERASURE_CHUNK_HEADER_SIZE];
+	int rv;
+
+	fp = fopen(fname, "rb");
+	if (fp == NULL) return -1;
+	rv = -1;
+	if (fread(buf, 1, JERASURE_CHUNK_HEADER_SIZE, fp) == JERASURE_CHUNK_HEADER_SIZE) {
+		rv = jerasure_chunk_unpack_header(buf, h);
+	}
+	fclose(fp);
+	return rv;
+}
+
+/* Opens the chunk file of device index and reads its header.  Returns
+   NULL if the file is missing, or its header is bad or is not for this
+   device, so that the caller treats the device as erased. */
+
+FILE *open_chunk_file(char *fname, int index, int blocksize, jerasure_chunk_header_t *h)
+{
+	FILE *fp;
+	unsigned char buf[JERASURE_CHUNK_HEADER_SIZE];
+
+	fp = fopen(fname, "rb");
+	if (fp == NULL) return NULL;
+	if (fread(buf, 1, JERASURE_CHUNK_HEADER_SIZE, fp) != JERASURE_CHUNK_HEADER_SIZE ||
+	    jerasure_chunk_unpack_header(buf, h) != 0) {
+		fprintf(stderr, "%s: bad chunk header, treating it as erased\n", fname);
+		fclose(fp);
+		return NULL;
+	}
+	if (h->index != index || h->blocksize != blocksize) {
+		fprintf(stderr, "%s: chunk header does not match, treating it as erased\n", fname);
+		fclose(fp);
+		return NULL;
+	}
+	return fp;
+}
+
+/* Reads one stripe from an open chunk file into buf, and checks its CRC.
+   Returns -1 if the file is not open or the stripe is bad, so that the
+   caller treats the device as erased. */
+
+int read_chunk_segment(FILE *fp, jerasure_chunk_header_t *h, char *fname, int stripe,
+                       int blocksize, char *buf)
+{
+	unsigned char trailer[JERASURE_CHUNK_CRC_SIZE];
+	int rv;
+
+	if (fp == NULL) return -1;
+	rv = -1;
+	if (fseeko(fp, jerasure_chunk_segment_offset(h, stripe), SEEK_SET) == 0 &&
+	    fread(buf, 1, blocksize, fp) == (size_t) blocksize &&
+	    fread(trailer, 1, JERASURE_CHUNK_CRC_SIZE, fp) == JERASURE_CHUNK_CRC_SIZE) {
+		rv = jerasure_chunk_check_segment(buf, blocksize, trailer);
+	}
+	if (rv != 0) {
+		fprintf(stderr, "%s: stripe %d failed its CRC check, treating it as erased\n", fname, stripe);
+	}
+	return rv;
+}
+
 void ctrl_bs_handler(int dummy) {
 	time_t mytime;
 	mytime = time(0);
@@ -19,3 +19,37 @@ trap "rm -fr T Coding"  EXIT
 dd if=/dev/urandom of=T bs=4096 count=1
 ./encoder T 3 2 reed_sol_van 8 0  0
 ./decoder T
+cmp T Coding/T_decoded
+
+# A damaged stripe is caught by its CRC and decoded around, along with
+# a missing file.
+./encoder T 3 2 reed_sol_van 8 0 1536
+printf 'X' | dd of=Coding/T_k2 bs=1 seek=100 conv=notrunc
+rm Coding/T_m1
+./decoder T
+cmp T Coding/T_decoded
+
+# Reed-Solomon in GF(2^4), with three devices lost.
+./encoder T 8 3 reed_sol_van 4 0 0
+rm Coding/T_k2 Coding/T_k5 Coding/T_m1
+./decoder T
+cmp T Coding/T_decoded
+
+# Reed-Solomon with the additive FFT, with six of 20+6 devices lost.
+./encoder T 20 6 reed_sol_fft 16 0 0
+rm Coding/T_k01 Coding/T_k07 Coding/T_k08 Coding/T_k19 Coding/T_m02 Coding/T_m06
+./decoder T
+cmp T Coding/T_decoded
+
+# The RAID-6 codes, with every kind of loss: one data device, P, Q, data
+# and P, data and Q, two data devices, and P and Q.  Data and P loses the
+# third data device, so that reed_sol_r6_op has to divide by 2^2.
+for spec in "reed_sol_r6_op 8" "reed_sol_r6_op 16" "rdp 6" "evenodd 6" "liberation 7" "blaum_roth 6" "liber8tion 8"; do
+  set -- $spec
+  for lost in "T_k2" "T_m1" "T_m2" "T_k3 T_m1" "T_k4 T_m2" "T_k1 T_k3" "T_m1 T_m2"; do
+    ./encoder T 4 2 $1 $2 8 0
+    (cd Coding && rm $lost)
+    ./decoder T
+    cmp T Coding/T_decoded
+  done
+done
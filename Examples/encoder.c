@@ -53,6 +53,8 @@ the original file and m of the files are encoded based on
 the given coding technique. The format of the created files 
 is the file name with "_k#" or "_m#" and then the extension.  
 (For example, inputfile test.txt would yield file "test_k1.txt".)
+Each file is in the chunk format of jerasure_chunk.h: a header with
+the coding parameters, then each block followed by its CRC32C.
 */
 
 #include <assert.h>
@@ -69,15 +71,18 @@ is the file name with "_k#" or "_m#" and then the extension.
 #include <unistd.h>
 #include "jerasure.h"
 #include "reed_sol.h"
+#include "reed_sol_fft.h"
 #include "cauchy.h"
 #include "liberation.h"
+#include "jerasure_stripe.h"
+#include "jerasure_chunk.h"
 #include "timing.h"
 
-#define N 10
+#define N 11
 
-enum Coding_Technique {Reed_Sol_Van, Reed_Sol_R6_Op, Cauchy_Orig, Cauchy_Good, Liberation, Blaum_Roth, Liber8tion, RDP, EVENODD, No_Coding};
+enum Coding_Technique {Reed_Sol_Van, Reed_Sol_R6_Op, Cauchy_Orig, Cauchy_Good, Liberation, Blaum_Roth, Liber8tion, RDP, EVENODD, No_Coding, Reed_Sol_FFT};
 
-char *Methods[N] = {"reed_sol_van", "reed_sol_r6_op", "cauchy_orig", "cauchy_good", "liberation", "blaum_roth", "liber8tion", "no_coding"};
+char *Methods[N] = {"reed_sol_van", "reed_sol_r6_op", "cauchy_orig", "cauchy_good", "liberation", "blaum_roth", "liber8tion", "rdp", "evenodd", "no_coding", "reed_sol_fft"};
 
 /* Global variables for signal handler */
 int readins, n;
@@ -86,19 +91,20 @@ enum Coding_Technique method;
 /* Function prototypes */
 int is_prime(int w);
 void ctrl_bs_handler(int dummy);
+void write_chunk_segment(char *fname, int n, jerasure_chunk_header_t *h, char *buf);
 
 int jfread(void *ptr, int size, int nmembers, FILE *stream)
 {
   if (stream != NULL) return fread(ptr, size, nmembers, stream);
 
-  MOA_Fill_Random_Region(ptr, size);
-  return size;
+  MOA_Fill_Random_Region(ptr, size*nmembers);
+  return nmembers;
 }
 
 
 int main (int argc, char **argv) {
 	FILE *fp, *fp2;				// file pointers
-	char *block;				// padding file
+	jerasure_stripe_t *stripe;		// data and coding buffers
 	int size, newsize;			// size of file and temp size 
 	struct stat status;			// finding file size
 
@@ -109,7 +115,8 @@ int main (int argc, char **argv) {
 	int i;						// loop control variables
 	int blocksize;					// size of k+m files
 	int total;
-	int extra;
+	int extra, want;
+	jerasure_chunk_header_t header;		// header of the k+m files
 	
 	/* Jerasure Arguments */
 	char **data;				
@@ -147,7 +154,7 @@ int main (int argc, char **argv) {
 	/* Error check Arguments*/
 	if (argc != 8) {
 		fprintf(stderr,  "usage: inputfile k m coding_technique w packetsize buffersize\n");
-		fprintf(stderr,  "\nChoose one of the following coding techniques: \nreed_sol_van, \nreed_sol_r6_op, \ncauchy_orig, \ncauchy_good, \nliberation, \nblaum_roth, \nliber8tion");
+		fprintf(stderr,  "\nChoose one of the following coding techniques: \nreed_sol_van, \nreed_sol_r6_op, \ncauchy_orig, \ncauchy_good, \nliberation, \nblaum_roth, \nliber8tion, \nrdp, \nevenodd, \nreed_sol_fft");
 		fprintf(stderr,  "\n\nPacketsize is ignored for the reed_sol's");
 		fprintf(stderr,  "\nBuffersize of 0 means the buffersize is chosen automatically.\n");
 		fprintf(stderr,  "\nIf you just want to test speed, use an inputfile of \"-number\" where number is the size of the fake file you want to test.\n\n");
@@ -229,8 +236,15 @@ int main (int argc, char **argv) {
 	}
 	else if (strcmp(argv[4], "reed_sol_van") == 0) {
 		tech = Reed_Sol_Van;
-		if (w != 8 && w != 16 && w != 32) {
-			fprintf(stderr,  "w must be one of {8, 16, 32}\n");
+		if (w != 4 && w != 8 && w != 16 && w != 32) {
+			fprintf(stderr,  "w must be one of {4, 8, 16, 32}\n");
+			exit(0);
+		}
+	}
+	else if (strcmp(argv[4], "reed_sol_fft") == 0) {
+		tech = Reed_Sol_FFT;
+		if (w != 16) {
+			fprintf(stderr,  "w must be 16\n");
 			exit(0);
 		}
 	}
@@ -316,8 +330,31 @@ int main (int argc, char **argv) {
 		}
 		tech = Liber8tion;
 	}
+	else if (strcmp(argv[4], "rdp") == 0 || strcmp(argv[4], "evenodd") == 0) {
+		tech = (strcmp(argv[4], "rdp") == 0) ? RDP : EVENODD;
+		if (m != 2) {
+			fprintf(stderr, "m must equal 2\n");
+			exit(0);
+		}
+		if (w <= 1 || !((w+1)%2) || !is_prime(w+1)) {
+			fprintf(stderr,  "w must be greater than one and w+1 must be prime\n");
+			exit(0);
+		}
+		if (k > ((tech == RDP) ? w : w+1)) {
+			fprintf(stderr, "k must be less than or equal to %s\n", (tech == RDP) ? "w" : "w+1");
+			exit(0);
+		}
+		if (packetsize == 0) {
+			fprintf(stderr, "Must include packetsize.\n");
+			exit(0);
+		}
+		if ((packetsize%(sizeof(long))) != 0) {
+			fprintf(stderr,  "packetsize must be a multiple of sizeof(long)\n");
+			exit(0);
+		}
+	}
 	else {
-		fprintf(stderr,  "Not a valid coding technique. Choose one of the following: reed_sol_van, reed_sol_r6_op, cauchy_orig, cauchy_good, liberation, blaum_roth, liber8tion, no_coding\n");
+		fprintf(stderr,  "Not a valid coding technique. Choose one of the following: reed_sol_van, reed_sol_r6_op, cauchy_orig, cauchy_good, liberation, blaum_roth, liber8tion, rdp, evenodd, reed_sol_fft, no_coding\n");
 		exit(0);
 	}
 
@@ -390,13 +427,11 @@ int main (int argc, char **argv) {
 		else {
 			readins = newsize/buffersize;
 		}
-		block = (char *)malloc(sizeof(char)*buffersize);
 		blocksize = buffersize/k;
 	}
 	else {
 		readins = 1;
 		buffersize = size;
-		block = (char *)malloc(sizeof(char)*newsize);
 	}
 	
 	/* Break inputfile name into the filename and extension */	
@@ -422,13 +457,12 @@ int main (int argc, char **argv) {
 	sprintf(temp, "%d", k);
 	md = strlen(temp);
 	
-	/* Allocate data and coding */
-	data = (char **)malloc(sizeof(char*)*k);
-	coding = (char **)malloc(sizeof(char*)*m);
-	for (i = 0; i < m; i++) {
-		coding[i] = (char *)malloc(sizeof(char)*blocksize);
-                if (coding[i] == NULL) { perror("malloc"); exit(1); }
-	}
+	/* Allocate data and coding.  The same aligned stripe is reused for
+	   every read-in. */
+	stripe = jerasure_alloc_stripe(k, m, blocksize, 0);
+	if (stripe == NULL) { perror("jerasure_alloc_stripe"); exit(1); }
+	data = stripe->data;
+	coding = stripe->coding;
 
 	
 
@@ -441,6 +475,7 @@ int main (int argc, char **argv) {
 			matrix = reed_sol_vandermonde_coding_matrix(k, m, w);
 			break;
 		case Reed_Sol_R6_Op:
+		case Reed_Sol_FFT:
 			break;
 		case Cauchy_Orig:
 			matrix = cauchy_original_coding_matrix(k, m, w);
@@ -466,7 +501,7 @@ int main (int argc, char **argv) {
 			break;
 		case RDP:
 		case EVENODD:
-			assert(0);
+			break;
 	}
 	timing_set(&start);
 	timing_set(&t4);
@@ -474,31 +509,31 @@ int main (int argc, char **argv) {
 
 	
 
+	/* Every one of the k+m files gets a chunk header */
+	header.k = k;
+	header.m = m;
+	header.w = w;
+	header.packetsize = packetsize;
+	header.technique = tech;
+	header.blocksize = blocksize;
+	header.nstripes = readins;
+	header.size = size;
+
 	/* Read in data until finished */
 	n = 1;
 	total = 0;
 
 	while (n <= readins) {
-		/* Check if padding is needed, if so, add appropriate 
-		   number of zeros */
-		if (total < size && total+buffersize <= size) {
-			total += jfread(block, sizeof(char), buffersize, fp);
-		}
-		else if (total < size && total+buffersize > size) {
-			extra = jfread(block, sizeof(char), buffersize, fp);
-			for (i = extra; i < buffersize; i++) {
-				block[i] = '0';
-			}
-		}
-		else if (total == size) {
-			for (i = 0; i < buffersize; i++) {
-				block[i] = '0';
-			}
-		}
-	
-		/* Set pointers to point to file data */
+		/* Read the next k blocks.  Past the end of the file, pad
+		   with zeros */
 		for (i = 0; i < k; i++) {
-			data[i] = block+(i*blocksize);
+			extra = 0;
+			if (total < size) {
+				want = (size-total < blocksize) ? size-total : blocksize;
+				extra = jfread(data[i], sizeof(char), want, fp);
+				total += extra;
+			}
+			memset(data[i]+extra, '0', blocksize-extra);
 		}
 
 		timing_set(&t3);
@@ -512,6 +547,9 @@ int main (int argc, char **argv) {
 			case Reed_Sol_R6_Op:
 				reed_sol_r6_encode(k, w, data, coding, blocksize);
 				break;
+			case Reed_Sol_FFT:
+				reed_sol_fft_encode(k, m, data, coding, blocksize);
+				break;
 			case Cauchy_Orig:
 				jerasure_schedule_encode(k, m, w, schedule, data, coding, blocksize, packetsize);
 				break;
@@ -528,8 +566,11 @@ int main (int argc, char **argv) {
 				jerasure_schedule_encode(k, m, w, schedule, data, coding, blocksize, packetsize);
 				break;
 			case RDP:
+				rdp_encode(k, w, data, coding, blocksize, packetsize);
+				break;
 			case EVENODD:
-				assert(0);
+				evenodd_encode(k, w, data, coding, blocksize, packetsize);
+				break;
 		}
 		timing_set(&t4);
 	
@@ -539,14 +580,8 @@ int main (int argc, char **argv) {
 				bzero(data[i-1], blocksize);
  			} else {
 				sprintf(fname, "%s/Coding/%s_k%0*d%s", curdir, s1, md, i, extension);
-				if (n == 1) {
-					fp2 = fopen(fname, "wb");
-				}
-				else {
-					fp2 = fopen(fname, "ab");
-				}
-				fwrite(data[i-1], sizeof(char), blocksize, fp2);
-				fclose(fp2);
+				header.index = i-1;
+				write_chunk_segment(fname, n, &header, data[i-1]);
 			}
 			
 		}
@@ -555,14 +590,8 @@ int main (int argc, char **argv) {
 				bzero(data[i-1], blocksize);
  			} else {
 				sprintf(fname, "%s/Coding/%s_m%0*d%s", curdir, s1, md, i, extension);
-				if (n == 1) {
-					fp2 = fopen(fname, "wb");
-				}
-				else {
-					fp2 = fopen(fname, "ab");
-				}
-				fwrite(coding[i-1], sizeof(char), blocksize, fp2);
-				fclose(fp2);
+				header.index = k+i-1;
+				write_chunk_segment(fname, n, &header, coding[i-1]);
 			}
 		}
 		n++;
@@ -587,7 +616,8 @@ int main (int argc, char **argv) {
 	/* Free allocated memory */
 	free(s1);
 	free(fname);
-	free(block);
+	jerasure_free_stripe(stripe);
+	jerasure_stripe_pool_drain();
 	free(curdir);
 	
 	/* Calculate rate in MB/sec and print */
@@ -614,6 +644,30 @@ int is_prime(int w) {
 	assert(0);
 }
 
+/* Appends one block to a chunk file, followed by its CRC.  The first
+   block of a file is preceded by the header. */
+
+void write_chunk_segment(char *fname, int n, jerasure_chunk_header_t *h, char *buf)
+{
+	FILE *fp2;
+	unsigned char hbuf[JERASURE_CHUNK_HEADER_SIZE];
+
+	if (n == 1) {
+		fp2 = fopen(fname, "wb");
+		if (fp2 == NULL) { perror(fname); exit(1); }
+		jerasure_chunk_pack_header(h, hbuf);
+		fwrite(hbuf, 1, JERASURE_CHUNK_HEADER_SIZE, fp2);
+	}
+	else {
+		fp2 = fopen(fname, "ab");
+		if (fp2 == NULL) { perror(fname); exit(1); }
+	}
+	fwrite(buf, sizeof(char), h->blocksize, fp2);
+	jerasure_chunk_segment_trailer(buf, h->blocksize, hbuf);
+	fwrite(hbuf, 1, JERASURE_CHUNK_CRC_SIZE, fp2);
+	fclose(fp2);
+}
+
 /* Handles ctrl-\ event */
 void ctrl_bs_handler(int dummy) {
 	time_t mytime;
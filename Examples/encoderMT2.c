@@ -88,6 +88,7 @@ Reference Doc: See PPT file Jerasure2,0_setup_math_perf at Quantum/Box repositor
 #include <gf_rand.h>
 #include <unistd.h>
 #include "jerasure.h"
+#include "jerasure_mt.h"
 #include "reed_sol.h"
 #include "cauchy.h"
 #include "liberation.h"
@@ -111,60 +112,10 @@ double get_time_usec() /* This is for debugging purposes - time optimization (no
     return 1000000.0 * tv.tv_sec + tv.tv_usec;
 }
 
-/* This is for multi-threading implementation (original encoder does not have it) */
-/* Better to put into a header file. We decided to make minimum changes though */
-typedef struct{ 
-    int k;
-    int w;
-    int *matrix_row;
-    int dest_id;
-    char** data;
-    char** coding;
-    int blocksize;
-}jinput_args;
-
-/* The following function is a modified version of jerasure_matrix_dotprod_mt 
-to utilize multi-thread capabilities of modern CPUs.*/
-void *jerasure_matrix_dotprod_mt(void *x_void_ptr){ 
-    jinput_args *x_ptr = (jinput_args *)x_void_ptr;
-    
-    int k = x_ptr->k;
-    int w = x_ptr->w;
-    int dest_id = x_ptr->dest_id;
-    int *matrix_row = x_ptr->matrix_row;
-    char** data_ptrs = x_ptr->data;
-    char** coding_ptrs = x_ptr->coding;
-    int blocksize = x_ptr->blocksize;
-    
-    int init = 0;
-    char *dptr, *sptr;
-    int i;
-    int j = dest_id-k;
-    
-    dptr = coding_ptrs[j];
-    for (i = 0; i < k; i++) {
-        sptr = data_ptrs[i];
-        if (matrix_row[i+j*k] == 1) {
-            if (init == 0) {
-                memcpy(dptr, sptr, blocksize);
-                init = 1;
-            }else{
-                galois_region_xor(sptr, dptr, blocksize);
-            } 
-        }
-        if (matrix_row[i+j*k] > 1) {
-             switch (w) {
-                case 8:  galois_w08_region_multiply(sptr, matrix_row[i+j*k], blocksize, dptr, init); break;
-                case 16: galois_w16_region_multiply(sptr, matrix_row[i+j*k], blocksize, dptr, init); break;
-                case 32: galois_w32_region_multiply(sptr, matrix_row[i+j*k], blocksize, dptr, init); break;
-            }
-            init = 1;   
-        }
-    }
-    
-    return NULL;
-}
-
+/* Multi-threading is done by the thread pool in jerasure_mt.h.  The pool's
+   threads are spread over the NUMA nodes, and the data and coding buffers
+   are allocated with jerasure_mt_alloc, so that each thread encodes memory
+   that is local to its node. */
 
 int jfread(void *ptr, int size, int nmembers, FILE *stream)
 {
@@ -178,6 +129,8 @@ int jfread(void *ptr, int size, int nmembers, FILE *stream)
 int main (int argc, char **argv) {
 	FILE *fp, *fp2;					// file pointers
 	char *block;					// padding file
+	char *codingblock;				// the m coding blocks
+	jerasure_mt_pool_t *pool;		// encoding threads
 	unsigned int size, newsize;		// size of file and temp size - we made it unsigned to cover large files.
 	struct stat status;				// finding file size
 
@@ -373,14 +326,22 @@ int main (int argc, char **argv) {
 	if (size > buffersize && buffersize != 0) {
 		/* We figured the conditional statement here has no effect */
 		readins = newsize/buffersize;
-		block = (char *)malloc(sizeof(char)*buffersize);
 		blocksize = buffersize/k;
 	}
 	else {
 		readins = 1;
 		buffersize = size;
-		block = (char *)malloc(sizeof(char)*newsize);
 	}
+
+	/* Start the thread pool, with the threads spread over the NUMA nodes, and
+	   let its threads place the k data blocks, which are contiguous in block */
+	pool = jerasure_mt_pool_create_affinity(0, JERASURE_MT_AFFINITY_SCATTER);
+	if (pool == NULL) {
+		fprintf(stderr, "Unable to create the thread pool.\n");
+		exit(1);
+	}
+	block = jerasure_mt_alloc(pool, k, blocksize);
+	if (block == NULL) { perror("jerasure_mt_alloc"); exit(1); }
 	
 	/* Break inputfile name into the filename and extension */	
 	s1 = (char*)malloc(sizeof(char)*(strlen(argv[1])+20));
@@ -408,9 +369,10 @@ int main (int argc, char **argv) {
 	/* Allocate data and coding */
 	data = (char **)malloc(sizeof(char*)*k);
 	coding = (char **)malloc(sizeof(char*)*m);
+	codingblock = jerasure_mt_alloc(pool, m, blocksize);
+	if (codingblock == NULL) { perror("jerasure_mt_alloc"); exit(1); }
 	for (i = 0; i < m; i++) {
-		coding[i] = (char *)malloc(sizeof(char)*blocksize);
-                if (coding[i] == NULL) { perror("malloc"); exit(1); }
+		coding[i] = codingblock+(i*blocksize);
 	}
 	
 	
@@ -427,10 +389,6 @@ int main (int argc, char **argv) {
 	/* Read in data until finished */ 
 	n = 1;
 	total = 0;
-	/* input values for MT-implementation */
-	jinput_args args[m];
-	pthread_t jme_mt_thread[m];
-	
 	while (n <= readins) {
 		/* Check if padding is needed, if so, add appropriate 
 		   number of zeros */
@@ -455,28 +413,14 @@ int main (int argc, char **argv) {
 		}
 		
 		t3 = (double)get_time_usec();	
-		/* Since we use a subfunction of jerasure_matrix_encode function in multi-threaded mode, we
-		needed to change this part of the code using a for loop. */
+		/* The encoding is split into tiles, which are encoded by the threads of the pool */
 		if (n==1){
 		    gettimeofday(&tstart, NULL);
 		    #if defined(MULTIPROCESS)
 			sstart = (double) tstart.tv_sec + ((double) tstart.tv_usec) / 1000000;
 		    #endif
 		}
-		for (i = 0; i < m; i++){
-			args[i].k = k; args[i].w = w;args[i].matrix_row = matrix;args[i].dest_id = k+i;
-			args[i].data = data;args[i].coding = coding;args[i].blocksize = blocksize;
-			if(pthread_create(&jme_mt_thread[i], NULL, jerasure_matrix_dotprod_mt, &args[i])){
-				fprintf(stderr, "Error creating thread %d\n", i);
-				return 1;
-				}
-		}	
-		for (i = 0; i < m; i++){
-			if(pthread_join(jme_mt_thread[i], NULL)) {
-				fprintf(stderr, "Error joining thread %d\n", i);
-				return 2;
-			}
-		}
+		jerasure_matrix_encode_mt(pool, k, m, w, matrix, data, coding, blocksize);
 		gettimeofday(&tfinish, NULL);
 		t4 = (double)get_time_usec();	
 		if ((t4 - t3) < 0)
@@ -530,7 +474,9 @@ int main (int argc, char **argv) {
 	/* Free allocated memory */
 	free(s1);
 	free(fname);
-	free(block);
+	jerasure_mt_free(block, k, blocksize);
+	jerasure_mt_free(codingblock, m, blocksize);
+	jerasure_mt_pool_destroy(pool);
 	free(curdir);
 	
 	/* Calculate rate in MB/sec and print */
@@ -0,0 +1,86 @@
+/* *
+ * Copyright (c) 2014, James S. Plank and Kevin Greenan
+ * All rights reserved.
+ *
+ * Jerasure - A C/C++ Library for a Variety of Reed-Solomon and RAID-6 Erasure
+ * Coding Techniques
+ *
+ * Revision 2.0: Galois Field backend now links to GF-Complete
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *  - Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ *  - Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ *
+ *  - Neither the name of the University of Tennessee nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY
+ * WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/* Jerasure's authors:
+
+   Revision 2.x - 2014: James S. Plank and Kevin M. Greenan.
+   Revision 1.2 - 2008: James S. Plank, Scott Simmerman and Catherine D. Schuman.
+   Revision 1.0 - 2007: James S. Plank.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "galois.h"
+#include "galois_tune.h"
+
+static void usage(char *s)
+{
+  fprintf(stderr, "usage: galois_autotune blocksize cache-file|- w ... - Picks the fastest region multiply for each w.\n");
+  fprintf(stderr, "       \n");
+  fprintf(stderr, "Each w must be 8, 16 or 32, and blocksize a multiple of w/8.  For each w,\n");
+  fprintf(stderr, "it times the GF-Complete techniques that keep the standard word layout on\n");
+  fprintf(stderr, "regions of blocksize bytes and prints the fastest.  Winners are kept in the\n");
+  fprintf(stderr, "cache file, and later runs on the same host read them from there.  Use -\n");
+  fprintf(stderr, "to always time and not keep anything.\n");
+  fprintf(stderr, "       \n");
+  fprintf(stderr, "This demonstrates: galois_autotune()\n");
+  fprintf(stderr, "                   galois_autotune_cached()\n");
+  if (s != NULL) fprintf(stderr, "%s\n", s);
+  exit(1);
+}
+
+int main(int argc, char **argv)
+{
+  int blocksize, w, i;
+  char *cache;
+  galois_tune_result_t r;
+
+  if (argc < 4) usage(NULL);
+  if (sscanf(argv[1], "%d", &blocksize) == 0 || blocksize <= 0) usage("Bad blocksize");
+  cache = (strcmp(argv[2], "-") == 0) ? NULL : argv[2];
+
+  for (i = 3; i < argc; i++) {
+    if (sscanf(argv[i], "%d", &w) == 0 || (w != 8 && w != 16 && w != 32)) usage("Bad w");
+    if (galois_autotune_cached(w, blocksize, cache, &r) < 0) usage("Bad w or blocksize");
+    printf("w=%-2d blocksize=%d technique=%-18s %10.1f MB/s%s\n", w, blocksize, r.technique,
+           r.mb_per_sec, r.from_cache ? " (cached)" : "");
+  }
+  return 0;
+}
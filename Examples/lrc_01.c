@@ -0,0 +1,174 @@
+/* *
+ * Copyright (c) 2014, James S. Plank and Kevin Greenan
+ * All rights reserved.
+ *
+ * Jerasure - A C/C++ Library for a Variety of Reed-Solomon and RAID-6 Erasure
+ * Coding Techniques
+ *
+ * Revision 2.0: Galois Field backend now links to GF-Complete
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *  - Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ *  - Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ *
+ *  - Neither the name of the University of Tennessee nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY
+ * WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/* Jerasure's authors:
+
+   Revision 2.x - 2014: James S. Plank and Kevin M. Greenan.
+   Revision 1.2 - 2008: James S. Plank, Scott Simmerman and Catherine D. Schuman.
+   Revision 1.0 - 2007: James S. Plank.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <gf_rand.h>
+#include "jerasure.h"
+#include "lrc.h"
+
+#define talloc(type, num) (type *) malloc(sizeof(type)*(num))
+
+#define SIZE 1024
+
+static void usage(char *s)
+{
+  fprintf(stderr, "usage: lrc_01 k l r w seed - Encodes and repairs with a locally repairable code.\n");
+  fprintf(stderr, "       \n");
+  fprintf(stderr, "The k data devices are split into l local groups, each with an XOR parity,\n");
+  fprintf(stderr, "and there are r global parities.  w must be 8, 16 or 32.  It encodes, then\n");
+  fprintf(stderr, "erases one random data device and repairs it, and then erases r random\n");
+  fprintf(stderr, "devices and repairs them, printing which devices each repair reads.\n");
+  fprintf(stderr, "       \n");
+  fprintf(stderr, "This demonstrates: lrc_coding_matrix()\n");
+  fprintf(stderr, "                   lrc_repair_plan()\n");
+  fprintf(stderr, "                   lrc_decode()\n");
+  if (s != NULL) fprintf(stderr, "%s\n", s);
+  exit(1);
+}
+
+/* Erases the devices in erasures, repairs them and checks the result */
+
+static void repair(int k, int l, int r, int w, int *matrix, int *erasures,
+                   char **data, char **coding, char **dcopy, char **ccopy)
+{
+  int *reads, i, n;
+
+  printf("Erased:");
+  for (i = 0; erasures[i] != -1; i++) {
+    printf(" %d", erasures[i]);
+    memset((erasures[i] < k) ? data[erasures[i]] : coding[erasures[i]-k], 0, SIZE);
+  }
+  printf("\n");
+
+  reads = talloc(int, k+l+r+1);
+  n = lrc_repair_plan(k, l, r, w, matrix, erasures, reads);
+  if (n < 0) {
+    printf("These erasures cannot be repaired.\n\n");
+    for (i = 0; i < k; i++) memcpy(data[i], dcopy[i], SIZE);
+    for (i = 0; i < l+r; i++) memcpy(coding[i], ccopy[i], SIZE);
+    free(reads);
+    return;
+  }
+  printf("Repair reads %d of %d devices:", n, k+l+r);
+  for (i = 0; reads[i] != -1; i++) printf(" %d", reads[i]);
+  printf("\n");
+
+  lrc_decode(k, l, r, w, matrix, erasures, data, coding, SIZE);
+  for (i = 0; i < k; i++) if (memcmp(data[i], dcopy[i], SIZE) != 0) {
+    printf("ERROR: D%d after decoding does not match its state before decoding!\n", i);
+  }
+  for (i = 0; i < l+r; i++) if (memcmp(coding[i], ccopy[i], SIZE) != 0) {
+    printf("ERROR: C%d after decoding does not match its state before decoding!\n", i);
+  }
+  printf("\n");
+  free(reads);
+}
+
+int main(int argc, char **argv)
+{
+  int k, l, r, w, i, j, m;
+  int *matrix, *erasures, *erased;
+  char **data, **coding, **dcopy, **ccopy;
+  uint32_t seed;
+
+  if (argc != 6) usage(NULL);
+  if (sscanf(argv[1], "%d", &k) == 0 || k <= 0) usage("Bad k");
+  if (sscanf(argv[2], "%d", &l) == 0 || l <= 0 || l > k) usage("Bad l");
+  if (sscanf(argv[3], "%d", &r) == 0 || r < 0) usage("Bad r");
+  if (sscanf(argv[4], "%d", &w) == 0 || (w != 8 && w != 16 && w != 32)) usage("Bad w");
+  if (sscanf(argv[5], "%u", &seed) == 0) usage("Bad seed");
+  if (w <= 16 && k >= (1 << w)) usage("k is too big");
+
+  m = l+r;
+  matrix = lrc_coding_matrix(k, l, r, w);
+
+  printf("lrc_01 %d %d %d %d %d\n\n", k, l, r, w, seed);
+  printf("Coding matrix (local rows, then global rows):\n\n");
+  jerasure_print_matrix(matrix, m, k, w);
+  printf("\n");
+
+  MOA_Seed(seed);
+  data = talloc(char *, k);
+  dcopy = talloc(char *, k);
+  for (i = 0; i < k; i++) {
+    data[i] = talloc(char, SIZE);
+    dcopy[i] = talloc(char, SIZE);
+    MOA_Fill_Random_Region(data[i], SIZE);
+    memcpy(dcopy[i], data[i], SIZE);
+  }
+  coding = talloc(char *, m);
+  ccopy = talloc(char *, m);
+  for (i = 0; i < m; i++) {
+    coding[i] = talloc(char, SIZE);
+    ccopy[i] = talloc(char, SIZE);
+  }
+
+  jerasure_matrix_encode(k, m, w, matrix, data, coding, SIZE);
+  for (i = 0; i < m; i++) memcpy(ccopy[i], coding[i], SIZE);
+
+  erasures = talloc(int, r+2);
+  erased = talloc(int, k+m);
+
+  erasures[0] = MOA_Random_W(31, 0)%k;
+  erasures[1] = -1;
+  repair(k, l, r, w, matrix, erasures, data, coding, dcopy, ccopy);
+
+  for (i = 0; i < k+m; i++) erased[i] = 0;
+  for (i = 0; i < r; ) {
+    j = MOA_Random_W(31, 0)%(k+m);
+    if (erased[j] == 0) {
+      erased[j] = 1;
+      erasures[i++] = j;
+    }
+  }
+  erasures[i] = -1;
+  if (r > 0) repair(k, l, r, w, matrix, erasures, data, coding, dcopy, ccopy);
+
+  return 0;
+}
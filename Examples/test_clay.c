@@ -0,0 +1,77 @@
+#include <assert.h>
+#include <stdlib.h>
+#include <string.h>
+#include <gf_rand.h>
+#include "clay.h"
+#include "test_regions.h"
+
+#define talloc(type, num) (type *) malloc(sizeof(type)*(num))
+
+static char *device(int k, char **data, char **coding, int id)
+{
+  return (id < k) ? data[id] : coding[id-k];
+}
+
+/* Encodes with every chunk shift bytes past a malloc'd address and
+   compares with an aligned encode.  Then decodes m lost devices, and
+   repairs each device from packed helper answers, which are shifted the
+   same way. */
+
+static void test_clay(int k, int m, int w, int shift)
+{
+  clay_code_t *c;
+  char **data, **coding, **adata, **ref, **helpers, **dest;
+  int *erasures, size, i, j;
+
+  c = clay_create(k, m, w);
+  assert(c != NULL);
+  size = clay_sub_chunks(c) * 16 * 3;
+  data = alloc_regions_at(k, size, shift);
+  coding = alloc_regions_at(m, size, shift);
+  adata = alloc_regions(k, size);
+  ref = alloc_regions(m, size);
+  for (i = 0; i < k; i++) memcpy(adata[i], data[i], size);
+  assert(clay_encode(c, adata, ref, size) == 0);
+  assert(clay_encode(c, data, coding, size) == 0);
+  for (i = 0; i < m; i++) assert(memcmp(coding[i], ref[i], size) == 0);
+
+  erasures = talloc(int, m+1);
+  for (i = 0; i < m; i++) {
+    erasures[i] = (i % 2 == 0) ? i : k+i;
+    memset(device(k, data, coding, erasures[i]), 0, size);
+  }
+  erasures[m] = -1;
+  assert(clay_decode(c, erasures, data, coding, size) == 0);
+  for (i = 0; i < m; i++) assert(memcmp(coding[i], ref[i], size) == 0);
+
+  helpers = alloc_regions_at(k+m, size/m, shift);
+  dest = alloc_regions_at(1, size, shift);
+  for (i = 0; i < k+m; i++) {
+    for (j = 0; j < k+m; j++) {
+      if (j != i) clay_repair_pack(c, i, device(k, data, coding, j), helpers[j], size);
+    }
+    assert(clay_repair(c, i, helpers, dest[0], size) == 0);
+    assert(memcmp(dest[0], device(k, data, coding, i), size) == 0);
+  }
+
+  free_regions_at(data, k, shift);
+  free_regions_at(coding, m, shift);
+  free_regions_at(helpers, k+m, shift);
+  free_regions_at(dest, 1, shift);
+  free_regions(adata, k);
+  free_regions(ref, m);
+  free(erasures);
+  clay_free(c);
+}
+
+int main(int argc, char **argv)
+{
+  MOA_Seed(45);
+
+  test_clay(4, 2, 8, 0);
+  test_clay(4, 2, 8, 8);
+  test_clay(5, 3, 16, 8);
+  test_clay(6, 2, 32, 4);
+
+  return 0;
+}
@@ -1,5 +1,70 @@
 #include <assert.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
 #include "galois.h"
+#include "galois_tune.h"
+
+/* The prepared multiply must match the GF-Complete one, including the odd
+   words at the end of a region. */
+
+static void test_prepared(int w, int multby)
+{
+  char src[1000], dst1[1000], dst2[1000];
+  galois_prepared_t p;
+  int i, add;
+
+  for (i = 0; i < 1000; i++) src[i] = i*37+11;
+  galois_prepare_multiply(multby, w, &p);
+  for (add = 0; add < 2; add++) {
+    memset(dst1, 3, 1000);
+    memset(dst2, 3, 1000);
+    switch (w) {
+      case 8:  galois_w08_region_multiply(src, multby, 996, dst1, add); break;
+      case 16: galois_w16_region_multiply(src, multby, 996, dst1, add); break;
+      case 32: galois_w32_region_multiply(src, multby, 996, dst1, add); break;
+    }
+    galois_region_multiply_prepared(src, &p, 996, dst2, add);
+    assert(memcmp(dst1, dst2, 1000) == 0);
+  }
+}
+
+/* Tunes w = 8 with a fresh cache file.  Region multiplies with the
+   installed technique must match galois_single_multiply, and a second
+   call must take the same technique from the cache. */
+
+static void test_autotune(void)
+{
+  char path[] = "/tmp/test_galois_XXXXXX";
+  unsigned char src[1024], dst[1024], ref[1024];
+  galois_tune_result_t r1, r2;
+  int fd, i, add, multby;
+
+  fd = mkstemp(path);
+  assert(fd >= 0);
+  close(fd);
+
+  assert(galois_autotune_cached(8, 4096, path, &r1) == 0);
+  assert(!r1.from_cache && r1.w == 8 && r1.blocksize == 4096);
+
+  for (i = 0; i < 1024; i++) src[i] = i*37+11;
+  for (multby = 0; multby < 256; multby += 51) {
+    for (add = 0; add < 2; add++) {
+      memset(dst, 0x5a, 1024);
+      for (i = 0; i < 1024; i++) {
+        ref[i] = galois_single_multiply(src[i], multby, 8) ^ (add ? 0x5a : 0);
+      }
+      galois_w08_region_multiply((char *) src, multby, 1024, (char *) dst, add);
+      assert(memcmp(dst, ref, 1024) == 0);
+    }
+  }
+
+  assert(galois_autotune_cached(8, 4096, path, &r2) == 0);
+  assert(r2.from_cache);
+  assert(strcmp(r1.technique, r2.technique) == 0);
+
+  unlink(path);
+}
 
 int main(int argc, char **argv)
 {
@@ -13,6 +78,12 @@ int main(int argc, char **argv)
   assert(galois_init_default_field(8) == 0);
   assert(galois_uninit_field(8) == 0);
 
+  test_prepared(8, 0x8e);
+  test_prepared(16, 0x1234);
+  test_prepared(32, 0x7f00ff31);
+
+  test_autotune();
+
   return 0;
 }
 /*
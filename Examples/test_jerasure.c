@@ -0,0 +1,282 @@
+#include <assert.h>
+#include <stdlib.h>
+#include <string.h>
+#include <gf_rand.h>
+#include "jerasure.h"
+#include "reed_sol.h"
+#include "cauchy.h"
+#include "test_regions.h"
+
+/* Coding written with non-temporal stores, above the threshold, must be
+   the same as coding written normally, below it.  Every region is off
+   bytes past a malloc'd address. */
+
+static void test_nontemporal(int k, int m, int w, int size, int off)
+{
+  int *matrix, *bitmatrix;
+  int **schedule;
+  char **data, **coding, **ref;
+  int i, packetsize;
+
+  matrix = cauchy_good_general_coding_matrix(k, m, w);
+  assert(matrix != NULL);
+  bitmatrix = jerasure_matrix_to_bitmatrix(k, m, w, matrix);
+  schedule = jerasure_smart_bitmatrix_to_schedule(k, m, w, bitmatrix);
+  packetsize = size / w;
+  data = alloc_regions_at(k, size, off);
+  coding = alloc_regions_at(m, size, off);
+  ref = alloc_regions_at(m, size, off);
+
+  jerasure_set_nontemporal_threshold(0);
+  jerasure_matrix_encode(k, m, w, matrix, data, ref, size);
+  jerasure_set_nontemporal_threshold(size);
+  jerasure_matrix_encode(k, m, w, matrix, data, coding, size);
+  for (i = 0; i < m; i++) assert(memcmp(coding[i], ref[i], size) == 0);
+
+  jerasure_set_nontemporal_threshold(0);
+  jerasure_schedule_encode(k, m, w, schedule, data, ref, size, packetsize);
+  jerasure_set_nontemporal_threshold(size);
+  for (i = 0; i < m; i++) memset(coding[i], 0, size);
+  jerasure_schedule_encode(k, m, w, schedule, data, coding, size, packetsize);
+  for (i = 0; i < m; i++) assert(memcmp(coding[i], ref[i], size) == 0);
+  jerasure_set_nontemporal_threshold(0);
+
+  free_regions_at(data, k, off);
+  free_regions_at(coding, m, off);
+  free_regions_at(ref, m, off);
+  jerasure_free_schedule(schedule);
+  free(bitmatrix);
+  free(matrix);
+}
+
+/* Encoding partly zero data with zero detection on must give the same
+   coding as with it off: one data device is all zeros, and the others
+   have zero tiles at different places. */
+
+static void test_zero_detection(int k, int m, int w, int size)
+{
+  int *matrix;
+  char **data, **coding, **ref;
+  int i, off;
+
+  matrix = reed_sol_vandermonde_coding_matrix(k, m, w);
+  assert(matrix != NULL);
+  data = alloc_regions(k, size);
+  coding = alloc_regions(m, size);
+  ref = alloc_regions(m, size);
+
+  memset(data[0], 0, size);
+  for (i = 1; i < k; i++) {
+    for (off = 0; off < size; off += 3*4096*i) {
+      memset(data[i] + off, 0, (size - off < 4096*i) ? size - off : 4096*i);
+    }
+  }
+  memset(data[k-1] + size/2, 0, size/4);
+
+  jerasure_set_zero_detection(0);
+  jerasure_matrix_encode(k, m, w, matrix, data, ref, size);
+  jerasure_set_zero_detection(1);
+  jerasure_matrix_encode(k, m, w, matrix, data, coding, size);
+  for (i = 0; i < m; i++) assert(memcmp(coding[i], ref[i], size) == 0);
+  jerasure_set_zero_detection(0);
+
+  free_regions(data, k);
+  free_regions(coding, m);
+  free_regions(ref, m);
+  free(matrix);
+}
+
+/* Checks the device and offset that verify reports after flipping bytes:
+   one byte near the end, then two in one tile, where the earliest offset
+   wins even on a higher device, and then two at the same offset, where
+   the lower device wins.  Every region is shift bytes past a malloc'd
+   address. */
+
+static int verify(int k, int m, int w, int *matrix, int **schedule, char **data, char **coding,
+                  int size, int packetsize, int *dev, int *off)
+{
+  if (schedule == NULL) {
+    return jerasure_matrix_verify(k, m, w, matrix, data, coding, size, dev, off);
+  }
+  return jerasure_schedule_verify(k, m, w, schedule, data, coding, size, packetsize, dev, off);
+}
+
+static void test_verify(int k, int m, int w, int size, int packetsize, int shift)
+{
+  int *matrix, *bitmatrix;
+  int **schedule;
+  char **data, **coding;
+  int dev, off, s;
+
+  assert(m >= 3);
+  matrix = cauchy_good_general_coding_matrix(k, m, w);
+  assert(matrix != NULL);
+  bitmatrix = jerasure_matrix_to_bitmatrix(k, m, w, matrix);
+  data = alloc_regions_at(k, size, shift);
+  coding = alloc_regions_at(m, size, shift);
+
+  for (s = 0; s < 2; s++) {
+    schedule = NULL;
+    if (s == 1) {
+      schedule = jerasure_smart_bitmatrix_to_schedule(k, m, w, bitmatrix);
+      jerasure_schedule_encode(k, m, w, schedule, data, coding, size, packetsize);
+    } else {
+      jerasure_matrix_encode(k, m, w, matrix, data, coding, size);
+    }
+    assert(verify(k, m, w, matrix, schedule, data, coding, size, packetsize, &dev, &off) == 0);
+
+    coding[1][size-3] ^= 0x10;
+    assert(verify(k, m, w, matrix, schedule, data, coding, size, packetsize, &dev, &off) == -1);
+    assert(dev == k+1 && off == size-3);
+    coding[1][size-3] ^= 0x10;
+
+    coding[0][200] ^= 1;
+    coding[2][100] ^= 1;
+    assert(verify(k, m, w, matrix, schedule, data, coding, size, packetsize, &dev, &off) == -1);
+    assert(dev == k+2 && off == 100);
+    coding[0][200] ^= 1;
+
+    coding[1][100] ^= 0x80;
+    assert(verify(k, m, w, matrix, schedule, data, coding, size, packetsize, &dev, &off) == -1);
+    assert(dev == k+1 && off == 100);
+    coding[1][100] ^= 0x80;
+    coding[2][100] ^= 1;
+
+    assert(verify(k, m, w, matrix, schedule, data, coding, size, packetsize, NULL, NULL) == 0);
+    if (schedule != NULL) jerasure_free_schedule(schedule);
+  }
+
+  free_regions_at(data, k, shift);
+  free_regions_at(coding, m, shift);
+  free(bitmatrix);
+  free(matrix);
+}
+
+/* cauchy_good_general_coding_matrix must not change, so that old data
+   still decodes: for m > 2 it is cauchy_original_coding_matrix, improved.
+   cauchy_best_coding_matrix must have no more ones, and
+   must decode what it encodes. */
+
+static int matrix_ones(int k, int m, int w, int *matrix)
+{
+  int i, n;
+
+  for (n = 0, i = 0; i < k*m; i++) n += cauchy_n_ones(matrix[i], w);
+  return n;
+}
+
+static void test_cauchy_best(int k, int m, int w, int size)
+{
+  int *good, *orig, *best, erasures[3];
+  char **data, **coding, **ref;
+  int i;
+
+  good = cauchy_good_general_coding_matrix(k, m, w);
+  orig = cauchy_original_coding_matrix(k, m, w);
+  best = cauchy_best_coding_matrix(k, m, w);
+  assert(good != NULL && orig != NULL && best != NULL);
+  cauchy_improve_coding_matrix(k, m, w, orig);
+  if (m > 2) assert(memcmp(good, orig, sizeof(int)*k*m) == 0);
+  assert(matrix_ones(k, m, w, best) <= matrix_ones(k, m, w, good));
+
+  data = alloc_regions(k, size);
+  coding = alloc_regions(m, size);
+  ref = alloc_regions(k, size);
+  for (i = 0; i < k; i++) memcpy(ref[i], data[i], size);
+  jerasure_matrix_encode(k, m, w, best, data, coding, size);
+  erasures[0] = 0;
+  erasures[1] = k-1;
+  erasures[2] = -1;
+  memset(data[0], 0, size);
+  memset(data[k-1], 0, size);
+  assert(jerasure_matrix_decode(k, m, w, best, 1, erasures, data, coding, size) == 0);
+  for (i = 0; i < k; i++) assert(memcmp(data[i], ref[i], size) == 0);
+
+  free_regions(data, k);
+  free_regions(coding, m);
+  free_regions(ref, k);
+  free(good);
+  free(orig);
+  free(best);
+}
+
+/* For w = 4 and w = 2 every byte packs 8/w elements from the low bits up.
+   Encoding must match a product done element by element, and decoding
+   must recover every single lost device and, for m >= 2, every pair. */
+
+static void test_packed(int k, int m, int w, int size)
+{
+  int *matrix, erasures[3], e0, e1, i, j, b, s, x, mask;
+  char **data, **coding, **ref, *dev;
+
+  matrix = reed_sol_vandermonde_coding_matrix(k, m, w);
+  assert(matrix != NULL);
+  data = alloc_regions(k, size);
+  coding = alloc_regions(m, size);
+  ref = alloc_regions(k+m, size);
+  jerasure_matrix_encode(k, m, w, matrix, data, coding, size);
+
+  mask = (1 << w) - 1;
+  for (i = 0; i < m; i++) {
+    for (b = 0; b < size; b++) {
+      x = 0;
+      for (s = 0; s < 8; s += w) {
+        for (j = 0; j < k; j++) {
+          x ^= galois_single_multiply(matrix[i*k+j], ((unsigned char) data[j][b] >> s) & mask, w) << s;
+        }
+      }
+      assert((unsigned char) coding[i][b] == x);
+    }
+  }
+
+  for (i = 0; i < k+m; i++) memcpy(ref[i], (i < k) ? data[i] : coding[i-k], size);
+  for (e0 = 0; e0 < k+m; e0++) {
+    for (e1 = e0; e1 < k+m; e1++) {
+      if (e1 > e0 && m < 2) break;
+      erasures[0] = e0;
+      erasures[1] = (e1 > e0) ? e1 : -1;
+      erasures[2] = -1;
+      memset((e0 < k) ? data[e0] : coding[e0-k], 0, size);
+      memset((e1 < k) ? data[e1] : coding[e1-k], 0, size);
+      assert(jerasure_matrix_decode(k, m, w, matrix, 0, erasures, data, coding, size) == 0);
+      for (i = 0; i < k+m; i++) {
+        dev = (i < k) ? data[i] : coding[i-k];
+        assert(memcmp(dev, ref[i], size) == 0);
+      }
+    }
+  }
+
+  free_regions(data, k);
+  free_regions(coding, m);
+  free_regions(ref, k+m);
+  free(matrix);
+}
+
+int main(int argc, char **argv)
+{
+  MOA_Seed(29);
+
+  test_nontemporal(6, 3, 8, 8*(65536+24), 0);
+  test_nontemporal(6, 3, 8, 8*24, 0);
+  test_nontemporal(5, 2, 16, 16*4104, 0);
+  test_nontemporal(4, 2, 8, 8*(65536+24), 8);
+  test_nontemporal(5, 2, 32, 32*4104, 4);
+
+  test_zero_detection(6, 3, 8, 1000000);
+  test_zero_detection(5, 4, 16, 300000);
+
+  test_verify(6, 3, 8, 8*64*100, 64, 0);
+  test_verify(5, 4, 16, 16*64*7, 64, 0);
+  test_verify(6, 3, 8, 8*64*100, 64, 8);
+  test_verify(4, 3, 32, 32*64*3, 64, 4);
+
+  test_cauchy_best(10, 4, 8, 4096);
+  test_cauchy_best(6, 3, 16, 4096);
+  test_cauchy_best(7, 2, 8, 4096);
+
+  test_packed(2, 2, 2, 1000);
+  test_packed(3, 1, 2, 4099);
+  test_packed(8, 3, 4, 5000);
+
+  return 0;
+}
@@ -0,0 +1,131 @@
+#include <assert.h>
+#include <stdlib.h>
+#include <string.h>
+extern "C" {
+#include <gf_rand.h>
+}
+#include "jerasure.h"
+#include "reed_sol.h"
+#include "cauchy.h"
+#include "jerasure_fixed.hpp"
+#include "test_regions.h"
+
+/* Encodes with codec, directly and through jerasure_matrix_encode once it
+   is registered, and compares both with jerasure_matrix_encode. */
+
+template <int K, int M, int W>
+static void check_codec(const jerasure::fixed_codec<K, M, W> &codec, int size)
+{
+  char **data, **coding, **ref;
+  int i;
+
+  data = alloc_regions(K, size);
+  coding = alloc_regions(M, size);
+  ref = alloc_regions(M, size);
+  jerasure_matrix_encode(K, M, W, (int *) codec.matrix(), data, ref, size);
+
+  codec.encode(data, coding, size);
+  for (i = 0; i < M; i++) assert(memcmp(coding[i], ref[i], size) == 0);
+
+  for (i = 0; i < M; i++) memset(coding[i], 0, size);
+  {
+    auto reg = codec.register_encoder();
+    assert(reg->registered());
+    jerasure_matrix_encode(K, M, W, (int *) codec.matrix(), data, coding, size);
+  }
+  for (i = 0; i < M; i++) assert(memcmp(coding[i], ref[i], size) == 0);
+
+  free_regions(data, K);
+  free_regions(coding, M);
+  free_regions(ref, M);
+}
+
+/* A registered encoder must be used whatever the store and zero-detection
+   modes: mode 1 turns on non-temporal stores and mode 2 zero detection.
+   The codec is registered through the C interface here, so that the
+   calls can be counted. */
+
+template <int K, int M, int W>
+struct counted {
+  jerasure::fixed_codec<K, M, W> codec;
+  int calls;
+
+  static int encode(void *arg, char **data_ptrs, char **coding_ptrs, int size)
+  {
+    counted *c = static_cast<counted *>(arg);
+    c->codec.encode(data_ptrs, coding_ptrs, size);
+    c->calls++;
+    return 0;
+  }
+};
+
+template <int K, int M, int W>
+static void test_modes(int size)
+{
+  typedef jerasure::fixed_codec<K, M, W> codec_t;
+  counted<K, M, W> c = { codec_t::reed_sol_van(), 0 };
+  char **data, **coding, **ref;
+  int *matrix, i, id, mode;
+
+  matrix = (int *) c.codec.matrix();
+  data = alloc_regions(K, size);
+  coding = alloc_regions(M, size);
+  ref = alloc_regions(M, size);
+  memset(data[0], 0, size);
+  jerasure_matrix_encode(K, M, W, matrix, data, ref, size);
+
+  id = jerasure_register_matrix_encoder(K, M, W, matrix, &counted<K, M, W>::encode, &c);
+  assert(id >= 0);
+  for (mode = 0; mode < 3; mode++) {
+    jerasure_set_nontemporal_threshold(mode == 1 ? 1 : 0);
+    jerasure_set_zero_detection(mode == 2);
+    for (i = 0; i < M; i++) memset(coding[i], 0, size);
+    jerasure_matrix_encode(K, M, W, matrix, data, coding, size);
+    assert(c.calls == mode+1);
+    for (i = 0; i < M; i++) assert(memcmp(coding[i], ref[i], size) == 0);
+  }
+  jerasure_set_nontemporal_threshold(0);
+  jerasure_set_zero_detection(0);
+  jerasure_unregister_matrix_encoder(id);
+
+  free_regions(data, K);
+  free_regions(coding, M);
+  free_regions(ref, M);
+}
+
+/* reed_sol_van_matrix() must be reed_sol_vandermonde_coding_matrix(), and
+   encoding must match jerasure_matrix_encode, for sizes that are and are
+   not a multiple of the block size. */
+
+template <int K, int M, int W>
+static void test_fixed()
+{
+  typedef jerasure::fixed_codec<K, M, W> codec_t;
+  constexpr std::array<int, K*M> vdm = codec_t::reed_sol_van_matrix();
+  int *matrix, i;
+
+  matrix = reed_sol_vandermonde_coding_matrix(K, M, W);
+  assert(matrix != NULL);
+  for (i = 0; i < K*M; i++) assert(vdm[i] == matrix[i]);
+  free(matrix);
+
+  check_codec(codec_t::reed_sol_van(), 3*4096);
+  check_codec(codec_t::reed_sol_van(), 5*4096 + 13*(W/8));
+  check_codec(codec_t::cauchy_good(), 2*4096 + 7*(W/8));
+}
+
+int main(int argc, char **argv)
+{
+  MOA_Seed(48);
+
+  test_fixed<6, 3, 8>();
+  test_fixed<10, 4, 8>();
+  test_fixed<8, 3, 16>();
+  test_fixed<12, 4, 16>();
+  test_fixed<4, 2, 32>();
+
+  test_modes<6, 3, 8>(5*4096);
+  test_modes<8, 3, 16>(5*4096 + 6);
+
+  return 0;
+}
@@ -0,0 +1,122 @@
+#include <assert.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/uio.h>
+#include <gf_rand.h>
+#include "jerasure.h"
+#include "jerasure_iov.h"
+#include "reed_sol.h"
+
+#define talloc(type, num) (type *) malloc(sizeof(type)*(num))
+
+#define MAX_SEGS 64
+
+/* Splits a device of size bytes into segments of odd lengths, each at an
+   odd offset of its own buffer, so that no two devices are aligned alike. */
+
+static int make_segments(struct iovec *iov, int size, int dev)
+{
+  int n, len, off;
+
+  n = 0;
+  while (size > 0) {
+    len = 1 + 2*(MOA_Random_32() % 600);
+    if (n == MAX_SEGS-1 || len > size) len = size;
+    off = 1 + 2*((dev + n) % 7);
+    iov[n].iov_base = talloc(char, off + len) + off;
+    iov[n].iov_len = len;
+    size -= len;
+    n++;
+  }
+  return n;
+}
+
+static void free_segments(struct iovec *iov, int n, int dev)
+{
+  int i;
+
+  for (i = 0; i < n; i++) free((char *) iov[i].iov_base - (1 + 2*((dev + i) % 7)));
+  free(iov);
+}
+
+static void copy_device(struct iovec *iov, int n, char *buf, int to_iov)
+{
+  int i;
+
+  for (i = 0; i < n; i++) {
+    if (to_iov) {
+      memcpy(iov[i].iov_base, buf, iov[i].iov_len);
+    } else {
+      memcpy(buf, iov[i].iov_base, iov[i].iov_len);
+    }
+    buf += iov[i].iov_len;
+  }
+}
+
+static void test_iov(int k, int m, int w, int size)
+{
+  int *matrix, *iovcnt, erasures[3];
+  struct iovec **iov;
+  char **data, **coding, *buf;
+  int i;
+
+  matrix = reed_sol_vandermonde_coding_matrix(k, m, w);
+  assert(matrix != NULL);
+  data = talloc(char *, k);
+  coding = talloc(char *, m);
+  iov = talloc(struct iovec *, k+m);
+  iovcnt = talloc(int, k+m);
+  buf = talloc(char, size);
+
+  for (i = 0; i < k+m; i++) {
+    iov[i] = talloc(struct iovec, MAX_SEGS);
+    iovcnt[i] = make_segments(iov[i], size, i);
+  }
+  for (i = 0; i < k; i++) {
+    data[i] = talloc(char, size);
+    MOA_Fill_Random_Region(data[i], size);
+    copy_device(iov[i], iovcnt[i], data[i], 1);
+  }
+  for (i = 0; i < m; i++) coding[i] = talloc(char, size);
+  jerasure_matrix_encode(k, m, w, matrix, data, coding, size);
+
+  jerasure_matrix_encode_iov(k, m, w, matrix, iov, iovcnt, iov+k, iovcnt+k, size);
+  for (i = 0; i < m; i++) {
+    copy_device(iov[k+i], iovcnt[k+i], buf, 0);
+    assert(memcmp(buf, coding[i], size) == 0);
+  }
+
+  erasures[0] = 1;
+  erasures[1] = k;
+  erasures[2] = -1;
+  memset(buf, 0, size);
+  copy_device(iov[1], iovcnt[1], buf, 1);
+  copy_device(iov[k], iovcnt[k], buf, 1);
+  assert(jerasure_matrix_decode_iov(k, m, w, matrix, erasures, iov, iovcnt,
+                                    iov+k, iovcnt+k, size) == 0);
+  copy_device(iov[1], iovcnt[1], buf, 0);
+  assert(memcmp(buf, data[1], size) == 0);
+  copy_device(iov[k], iovcnt[k], buf, 0);
+  assert(memcmp(buf, coding[0], size) == 0);
+
+  for (i = 0; i < k+m; i++) free_segments(iov[i], iovcnt[i], i);
+  for (i = 0; i < k; i++) free(data[i]);
+  for (i = 0; i < m; i++) free(coding[i]);
+  free(iov);
+  free(iovcnt);
+  free(data);
+  free(coding);
+  free(buf);
+  free(matrix);
+}
+
+int main(int argc, char **argv)
+{
+  MOA_Seed(32);
+
+  test_iov(5, 3, 8, 20001);
+  test_iov(4, 2, 16, 15002);
+  test_iov(6, 3, 32, 12004);
+
+  return 0;
+}
@@ -0,0 +1,174 @@
+#include <assert.h>
+#include <stdlib.h>
+#include <string.h>
+#include <gf_rand.h>
+#include "jerasure.h"
+#include "jerasure_mt.h"
+#include "reed_sol.h"
+#include "cauchy.h"
+
+#define talloc(type, num) (type *) malloc(sizeof(type)*(num))
+
+static int erasure_sets[][4] = {
+  { 0, -1 },
+  { 1, 4, -1 },
+  { 0, 6, -1 },
+  { 2, 3, 5, -1 },
+  { 6, 7, 8, -1 },
+  { 5, 7, -1 },
+};
+
+static void test_decode(jerasure_mt_pool_t *pool, int k, int m, int w, int size)
+{
+  int *matrix;
+  char **data, **coding, **orig;
+  int i, e;
+
+  matrix = reed_sol_vandermonde_coding_matrix(k, m, w);
+  assert(matrix != NULL);
+
+  data = talloc(char *, k);
+  coding = talloc(char *, m);
+  orig = talloc(char *, k+m);
+  for (i = 0; i < k; i++) {
+    data[i] = talloc(char, size);
+    MOA_Fill_Random_Region(data[i], size);
+  }
+  for (i = 0; i < m; i++) coding[i] = talloc(char, size);
+  jerasure_matrix_encode(k, m, w, matrix, data, coding, size);
+
+  for (i = 0; i < k+m; i++) {
+    orig[i] = talloc(char, size);
+    memcpy(orig[i], (i < k) ? data[i] : coding[i-k], size);
+  }
+
+  for (i = 0; i < m; i++) memset(coding[i], 0, size);
+  jerasure_matrix_encode_mt(pool, k, m, w, matrix, data, coding, size);
+  for (i = 0; i < m; i++) assert(memcmp(coding[i], orig[k+i], size) == 0);
+
+  for (e = 0; e < sizeof(erasure_sets)/sizeof(erasure_sets[0]); e++) {
+    for (i = 0; erasure_sets[e][i] != -1; i++) {
+      memset((erasure_sets[e][i] < k) ? data[erasure_sets[e][i]] : coding[erasure_sets[e][i]-k], 0, size);
+    }
+    assert(jerasure_matrix_decode_mt(pool, k, m, w, matrix, 1, erasure_sets[e], data, coding, size) == 0);
+    for (i = 0; i < k; i++) assert(memcmp(data[i], orig[i], size) == 0);
+    for (i = 0; i < m; i++) assert(memcmp(coding[i], orig[k+i], size) == 0);
+
+    for (i = 0; erasure_sets[e][i] != -1; i++) {
+      memset((erasure_sets[e][i] < k) ? data[erasure_sets[e][i]] : coding[erasure_sets[e][i]-k], 0, size);
+    }
+    assert(jerasure_matrix_decode_fused(k, m, w, matrix, erasure_sets[e], data, coding, size) == 0);
+    for (i = 0; i < k; i++) assert(memcmp(data[i], orig[i], size) == 0);
+    for (i = 0; i < m; i++) assert(memcmp(coding[i], orig[k+i], size) == 0);
+  }
+
+  for (i = 0; i < k+m; i++) free(orig[i]);
+  for (i = 0; i < k; i++) free(data[i]);
+  for (i = 0; i < m; i++) free(coding[i]);
+  free(orig);
+  free(data);
+  free(coding);
+  free(matrix);
+}
+
+static int r6_erasure_sets[][3] = {
+  { 0, -1 },
+  { 3, -1 },
+  { 1, 4, -1 },
+  { 0, 6, -1 },
+  { 5, 7, -1 },
+  { 6, 7, -1 },
+};
+
+static void test_schedule(jerasure_mt_pool_t *pool, int k, int w, int packetsize, int nslices)
+{
+  int m = 2;
+  int *matrix, *bitmatrix;
+  int **schedule, ***cache;
+  char **data, **coding, **orig;
+  int i, e, c, size;
+
+  size = w*packetsize*nslices;
+  matrix = cauchy_good_general_coding_matrix(k, m, w);
+  assert(matrix != NULL);
+  bitmatrix = jerasure_matrix_to_bitmatrix(k, m, w, matrix);
+  schedule = jerasure_smart_bitmatrix_to_schedule(k, m, w, bitmatrix);
+  cache = jerasure_generate_schedule_cache(k, m, w, bitmatrix, 1);
+
+  data = talloc(char *, k);
+  coding = talloc(char *, m);
+  orig = talloc(char *, k+m);
+  for (i = 0; i < k; i++) {
+    data[i] = talloc(char, size);
+    MOA_Fill_Random_Region(data[i], size);
+  }
+  for (i = 0; i < m; i++) coding[i] = talloc(char, size);
+  jerasure_schedule_encode(k, m, w, schedule, data, coding, size, packetsize);
+
+  for (i = 0; i < k+m; i++) {
+    orig[i] = talloc(char, size);
+    memcpy(orig[i], (i < k) ? data[i] : coding[i-k], size);
+  }
+
+  for (i = 0; i < m; i++) memset(coding[i], 0, size);
+  jerasure_schedule_encode_mt(pool, k, m, w, schedule, data, coding, size, packetsize);
+  for (i = 0; i < m; i++) assert(memcmp(coding[i], orig[k+i], size) == 0);
+
+  for (e = 0; e < sizeof(r6_erasure_sets)/sizeof(r6_erasure_sets[0]); e++) {
+    for (c = 0; c < 2; c++) {
+      for (i = 0; r6_erasure_sets[e][i] != -1; i++) {
+        memset((r6_erasure_sets[e][i] < k) ? data[r6_erasure_sets[e][i]] : coding[r6_erasure_sets[e][i]-k], 0, size);
+      }
+      if (c == 0) {
+        assert(jerasure_schedule_decode_lazy_mt(pool, k, m, w, bitmatrix, r6_erasure_sets[e],
+                                                data, coding, size, packetsize, 1) == 0);
+      } else {
+        assert(jerasure_schedule_decode_cache_mt(pool, k, m, w, cache, r6_erasure_sets[e],
+                                                 data, coding, size, packetsize) == 0);
+      }
+      for (i = 0; i < k; i++) assert(memcmp(data[i], orig[i], size) == 0);
+      for (i = 0; i < m; i++) assert(memcmp(coding[i], orig[k+i], size) == 0);
+    }
+  }
+
+  for (i = 0; i < k+m; i++) free(orig[i]);
+  for (i = 0; i < k; i++) free(data[i]);
+  for (i = 0; i < m; i++) free(coding[i]);
+  free(orig);
+  free(data);
+  free(coding);
+  jerasure_free_schedule(schedule);
+  jerasure_free_schedule_cache(k, m, cache);
+  free(bitmatrix);
+  free(matrix);
+}
+
+int main(int argc, char **argv)
+{
+  jerasure_mt_pool_t *pool;
+
+  MOA_Seed(17);
+
+  pool = jerasure_mt_pool_create(4);
+  assert(pool != NULL);
+  assert(jerasure_mt_pool_size(pool) == 4);
+
+  test_decode(pool, 6, 3, 8, 1000000);
+  test_decode(pool, 6, 3, 16, 65536+64);
+  test_decode(pool, 6, 3, 32, 4096);
+  test_decode(NULL, 6, 3, 8, 100000);
+
+  test_schedule(pool, 6, 8, 64, 301);
+  test_schedule(pool, 6, 5, 1024, 7);
+  test_schedule(NULL, 6, 8, 64, 10);
+
+  jerasure_mt_pool_destroy(pool);
+
+  pool = jerasure_mt_pool_create_affinity(3, JERASURE_MT_AFFINITY_SCATTER);
+  assert(pool != NULL);
+  test_decode(pool, 6, 3, 8, 200000);
+  test_schedule(pool, 6, 8, 64, 101);
+  jerasure_mt_pool_destroy(pool);
+
+  return 0;
+}
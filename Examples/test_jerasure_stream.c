@@ -0,0 +1,99 @@
+#include <assert.h>
+#include <stdlib.h>
+#include <string.h>
+#include <gf_rand.h>
+#include "jerasure.h"
+#include "jerasure_stream.h"
+#include "reed_sol.h"
+
+#define talloc(type, num) (type *) malloc(sizeof(type)*(num))
+
+/* Everything a stream hands to its callback, one stripe after another. */
+
+typedef struct {
+  int k, m;
+  char *bytes;
+  long len;
+} stream_log;
+
+static int log_stripe(void *arg, long stripe, char **data_ptrs, char **coding_ptrs,
+                      int blocksize, int nbytes)
+{
+  stream_log *l;
+  int i;
+
+  l = (stream_log *) arg;
+  l->bytes = realloc(l->bytes, l->len + 2*sizeof(int) + (long) (l->k+l->m)*blocksize);
+  assert(l->bytes != NULL);
+  memcpy(l->bytes + l->len, &blocksize, sizeof(int));
+  memcpy(l->bytes + l->len + sizeof(int), &nbytes, sizeof(int));
+  l->len += 2*sizeof(int);
+  for (i = 0; i < l->k + l->m; i++) {
+    memcpy(l->bytes + l->len, (i < l->k) ? data_ptrs[i] : coding_ptrs[i-l->k], blocksize);
+    l->len += blocksize;
+  }
+  return 0;
+}
+
+/* Appending in odd pieces, so that whole stripes start at odd addresses,
+   must give the same stripes as appending everything at once from an
+   aligned buffer. */
+
+static void test_stream(int k, int m, int w, int blocksize, int total)
+{
+  static int pieces[] = { 1, 7, 13, 0 };
+  jerasure_stream_t *s;
+  stream_log one, many;
+  int *matrix;
+  char *input;
+  void *p;
+  int done, n, i;
+
+  matrix = reed_sol_vandermonde_coding_matrix(k, m, w);
+  assert(matrix != NULL);
+  assert(posix_memalign(&p, 64, total) == 0);
+  input = p;
+  MOA_Fill_Random_Region(input, total);
+  pieces[3] = 3*k*blocksize + 5;
+
+  memset(&one, 0, sizeof(one));
+  one.k = k;
+  one.m = m;
+  s = jerasure_stream_create_matrix(k, m, w, matrix, blocksize, log_stripe, &one);
+  assert(s != NULL);
+  assert(jerasure_stream_append(s, input, total) == 0);
+  assert(jerasure_stream_finalize(s) == 0);
+  jerasure_stream_destroy(s);
+
+  memset(&many, 0, sizeof(many));
+  many.k = k;
+  many.m = m;
+  s = jerasure_stream_create_matrix(k, m, w, matrix, blocksize, log_stripe, &many);
+  assert(s != NULL);
+  for (done = 0, i = 0; done < total; done += n, i++) {
+    n = pieces[i % 4];
+    if (n > total - done) n = total - done;
+    assert(jerasure_stream_append(s, input + done, n) == 0);
+  }
+  assert(jerasure_stream_finalize(s) == 0);
+  jerasure_stream_destroy(s);
+
+  assert(one.len == many.len);
+  assert(memcmp(one.bytes, many.bytes, one.len) == 0);
+
+  free(one.bytes);
+  free(many.bytes);
+  free(input);
+  free(matrix);
+}
+
+int main(int argc, char **argv)
+{
+  MOA_Seed(33);
+
+  test_stream(4, 2, 8, 1024, 100000);
+  test_stream(5, 3, 16, 1000, 77777);
+  test_stream(3, 2, 32, 4096, 200003);
+
+  return 0;
+}
@@ -0,0 +1,118 @@
+#include <assert.h>
+#include <stdlib.h>
+#include <string.h>
+#include <gf_rand.h>
+#include "jerasure.h"
+#include "reed_sol.h"
+#include "reed_sol_fft.h"
+#include "test_regions.h"
+
+#define talloc(type, num) (type *) malloc(sizeof(type)*(num))
+
+static char *device(int k, char **data, char **coding, int id)
+{
+  return (id < k) ? data[id] : coding[id-k];
+}
+
+/* Corrupts one device and then two, and checks that
+   reed_sol_vandermonde_correct finds them, counts the words it fixed and
+   puts the stripe back as it was.  Every region is shift bytes past a
+   malloc'd address. */
+
+static void test_correct(int k, int m, int w, int size, int shift)
+{
+  int *matrix, *corrected;
+  char **data, **coding, **orig;
+  int i;
+
+  assert(m >= 4);
+  matrix = reed_sol_vandermonde_coding_matrix(k, m, w);
+  assert(matrix != NULL);
+  data = alloc_regions_at(k, size, shift);
+  coding = alloc_regions_at(m, size, shift);
+  orig = alloc_regions(k+m, size);
+  corrected = talloc(int, k+m);
+  jerasure_matrix_encode(k, m, w, matrix, data, coding, size);
+  for (i = 0; i < k+m; i++) memcpy(orig[i], device(k, data, coding, i), size);
+
+  assert(reed_sol_vandermonde_correct(k, m, w, matrix, data, coding, size, corrected) == 0);
+  for (i = 0; i < k+m; i++) assert(corrected[i] == 0);
+
+  /* One device, two words */
+
+  data[3][8] ^= 0x5a;
+  data[3][size-1] ^= 0x01;
+  assert(reed_sol_vandermonde_correct(k, m, w, matrix, data, coding, size, corrected) == 2);
+  for (i = 0; i < k+m; i++) {
+    assert(corrected[i] == (i == 3));
+    assert(memcmp(orig[i], device(k, data, coding, i), size) == 0);
+  }
+
+  /* Two devices, one in the same word as the other */
+
+  data[1][16] ^= 0xff;
+  coding[2][16] ^= 0x33;
+  coding[2][size/2] ^= 0x80;
+  assert(reed_sol_vandermonde_correct(k, m, w, matrix, data, coding, size, corrected) == 2);
+  for (i = 0; i < k+m; i++) {
+    assert(corrected[i] == (i == 1 || i == k+2));
+    assert(memcmp(orig[i], device(k, data, coding, i), size) == 0);
+  }
+
+  free_regions_at(data, k, shift);
+  free_regions_at(coding, m, shift);
+  free_regions(orig, k+m);
+  free(corrected);
+  free(matrix);
+}
+
+/* Encodes with the additive FFT and decodes with m devices lost, for
+   sizes below and above one pass of the coder.  Every region is shift
+   bytes past a malloc'd address. */
+
+static void test_fft(int k, int m, int size, int shift)
+{
+  int *erasures;
+  char **data, **coding, **orig;
+  int i;
+
+  data = alloc_regions_at(k, size, shift);
+  coding = alloc_regions_at(m, size, shift);
+  orig = alloc_regions(k+m, size);
+  erasures = talloc(int, m+1);
+  assert(reed_sol_fft_encode(k, m, data, coding, size) == 0);
+  for (i = 0; i < k+m; i++) memcpy(orig[i], device(k, data, coding, i), size);
+
+  for (i = 0; i < m; i++) {
+    erasures[i] = (i % 2 == 0) ? i : k+i;
+    memset(device(k, data, coding, erasures[i]), 0, size);
+  }
+  erasures[m] = -1;
+  assert(reed_sol_fft_decode(k, m, erasures, data, coding, size) == 0);
+  for (i = 0; i < k+m; i++) assert(memcmp(orig[i], device(k, data, coding, i), size) == 0);
+
+  free_regions_at(data, k, shift);
+  free_regions_at(coding, m, shift);
+  free_regions(orig, k+m);
+  free(erasures);
+}
+
+int main(int argc, char **argv)
+{
+  MOA_Seed(36);
+
+  test_correct(8, 4, 8, 100000, 0);
+  test_correct(10, 5, 16, 65536+8, 0);
+  test_correct(6, 4, 32, 20000, 0);
+  test_correct(8, 4, 8, 100000, 8);
+  test_correct(10, 5, 16, 65536+8, 8);
+  test_correct(6, 4, 32, 20000, 4);
+
+  test_fft(5, 3, 24, 0);
+  test_fft(20, 6, 8, 0);
+  test_fft(10, 4, 100000, 0);
+  test_fft(10, 4, 100000, 8);
+  test_fft(5, 3, 24, 8);
+
+  return 0;
+}
@@ -0,0 +1,36 @@
+#include <stdlib.h>
+#include <gf_rand.h>
+#include "test_regions.h"
+
+#define talloc(type, num) (type *) malloc(sizeof(type)*(num))
+
+char **alloc_regions_at(int n, int size, int off)
+{
+  char **r;
+  int i;
+
+  r = talloc(char *, n);
+  for (i = 0; i < n; i++) {
+    r[i] = talloc(char, size+off) + off;
+    MOA_Fill_Random_Region(r[i], size);
+  }
+  return r;
+}
+
+void free_regions_at(char **r, int n, int off)
+{
+  int i;
+
+  for (i = 0; i < n; i++) free(r[i] - off);
+  free(r);
+}
+
+char **alloc_regions(int n, int size)
+{
+  return alloc_regions_at(n, size, 0);
+}
+
+void free_regions(char **r, int n)
+{
+  free_regions_at(r, n, 0);
+}
@@ -0,0 +1,19 @@
+#pragma once
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Regions for the check programs: n regions of size random bytes, each
+   off bytes past a malloc'd address, so that tests can hand the library
+   stripes that are not 16-byte aligned.  free_regions_at takes the same
+   off.  alloc_regions and free_regions are the off = 0 case. */
+
+extern char **alloc_regions_at(int n, int size, int off);
+extern void free_regions_at(char **r, int n, int off);
+extern char **alloc_regions(int n, int size);
+extern void free_regions(char **r, int n);
+
+#ifdef __cplusplus
+}
+#endif
@@ -49,6 +49,28 @@ extern void cauchy_improve_coding_matrix(int k, int m, int w, int *matrix);
 extern int *cauchy_good_general_coding_matrix(int k, int m, int w);
 extern int cauchy_n_ones(int n, int w);
 
+/* cauchy_best_coding_matrix is cauchy_good_general_coding_matrix() with
+   searched X and Y sets for m = 3 and 4, w = 4..16 and k = 1..20.  Those
+   matrices have about 21% fewer ones in their bitmatrices, but they are
+   not the ones cauchy_good_general_coding_matrix() returns, so data coded
+   with one must be decoded with the same one.  For other parameters the
+   two return the same matrix. */
+
+extern int *cauchy_best_coding_matrix(int k, int m, int w);
+
+/* cauchy_search_xy looks for sets X (m elements) and Y (k elements) whose
+   Cauchy matrix, after cauchy_improve_coding_matrix(), has as few ones as
+   possible in its bitmatrix.  It tries iterations candidates in total,
+   split over threads threads, and is deterministic for a given seed and
+   thread count.  It returns the number of ones, or -1 on bad parameters.
+   Build the matrix with cauchy_xy_coding_matrix() followed by
+   cauchy_improve_coding_matrix().  The tables that
+   cauchy_best_coding_matrix() uses were made with it
+   (Examples/cauchy_search). */
+
+extern int cauchy_search_xy(int k, int m, int w, int iterations, int threads, unsigned int seed,
+                            int *X, int *Y);
+
 #ifdef __cplusplus
 }
 #endif
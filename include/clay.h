@@ -0,0 +1,125 @@
+/* *
+ * Copyright (c) 2014, James S. Plank and Kevin Greenan
+ * All rights reserved.
+ *
+ * Jerasure - A C/C++ Library for a Variety of Reed-Solomon and RAID-6 Erasure
+ * Coding Techniques
+ *
+ * Revision 2.0: Galois Field backend now links to GF-Complete
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *  - Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ *  - Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ *
+ *  - Neither the name of the University of Tennessee nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY
+ * WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#pragma once
+
+#ifndef _CLAY_H
+#define _CLAY_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* ------------------------------------------------------------ */
+/* Clay codes. ------------------------------------------------ */
+/*
+   A Clay code is a minimum-storage regenerating (MSR) code.  It stores
+   exactly as much as a k+m Reed-Solomon code and tolerates any m
+   erasures, but a single lost device is rebuilt from all k+m-1 others
+   while reading only 1/m of each of them.  That is (k+m-1)/m chunks of
+   repair traffic instead of k.
+
+   Each chunk is split into alpha = m^t sub-chunks, where
+   t = (k+m+nu)/m and nu >= 0 is the smallest number of virtual all-zero
+   data devices that makes m divide k+m+nu.  Sub-chunk j of a device
+   starts at byte j*(size/alpha).  The sub-chunks with the same index
+   across all devices form a layer.  Layers are coupled pairwise, and
+   once they are uncoupled, each layer is a codeword of the
+   reed_sol_vandermonde_coding_matrix(k+nu, m, w) code.  size must be a
+   multiple of alpha*16, so that every sub-chunk is a multiple of 16
+   bytes, and the chunks (and for clay_repair, the helpers and dest) must
+   be aligned alike mod 16, as for jerasure_matrix_encode.  They need not
+   be 16-byte aligned themselves.
+
+   Device ids are 0 .. k-1 for data and k .. k+m-1 for coding, as in the
+   rest of jerasure.  m must be at least 2, w must be 8, 16 or 32, and
+   k+nu+m must be <= 2^w.
+
+ - clay_create returns a code for k, m and w, or NULL if the parameters
+   are bad.  clay_free frees it.
+
+ - clay_sub_chunks returns alpha.
+
+ - clay_encode computes the m coding chunks from the k data chunks.
+   Returns 0 or -1.
+
+ - clay_decode rebuilds any m or fewer erased devices (erasures is
+   terminated by -1) by reading all of the survivors.  Returns 0 or -1.
+
+ - clay_repair_sub_chunks lists in ascending order, in sub_chunks
+   (alpha/m ints), the sub-chunk indices that every helper must send to
+   repair device lost.  Returns alpha/m.
+
+ - clay_repair_pack copies those sub-chunks of a helper's chunk, in that
+   order, into out, which must hold size/m bytes.  It is what a helper
+   runs to answer a repair request.
+
+ - clay_repair rebuilds the whole chunk of device lost into dest.
+   helpers[i] is the packed answer (size/m bytes) of device i for every
+   i != lost; helpers[lost] is ignored.  Returns 0 or -1.
+ */
+
+typedef struct {
+  int k;
+  int m;
+  int w;
+  int nu;          /* Virtual zero data devices */
+  int q;           /* Equals m */
+  int t;           /* (k+nu+m)/q */
+  int alpha;       /* q^t sub-chunks per chunk */
+  int gamma;       /* Coupling coefficient */
+  int *matrix;     /* The uncoupled code: m x (k+nu) */
+} clay_code_t;
+
+extern clay_code_t *clay_create(int k, int m, int w);
+extern void clay_free(clay_code_t *c);
+extern int clay_sub_chunks(clay_code_t *c);
+
+extern int clay_encode(clay_code_t *c, char **data_ptrs, char **coding_ptrs, int size);
+extern int clay_decode(clay_code_t *c, int *erasures, char **data_ptrs, char **coding_ptrs, int size);
+
+extern int clay_repair_sub_chunks(clay_code_t *c, int lost, int *sub_chunks);
+extern void clay_repair_pack(clay_code_t *c, int lost, char *chunk, char *out, int size);
+extern int clay_repair(clay_code_t *c, int lost, char **helpers, char *dest, int size);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -50,6 +50,14 @@ extern int galois_init_default_field(int w);
 extern int galois_uninit_field(int w);
 extern void galois_change_technique(gf_t *gf, int w);
 
+/* Fields are created on first use, and that first use is thread-safe.
+   galois_warmup(w) creates the default field for w up front so that the
+   setup cost is not paid inside a timed or latency-sensitive loop.
+   Returns 0 on success and -1 on failure.  galois_uninit_field() and
+   galois_change_technique() must not race with other users of field w. */
+
+extern int galois_warmup(int w);
+
 extern int galois_single_multiply(int a, int b, int w);
 extern int galois_single_divide(int a, int b, int w);
 extern int galois_inverse(int x, int w);
@@ -82,6 +90,55 @@ void galois_w32_region_multiply(char *region,       /* Region to multiply */
                                                        Otherwise region is overwritten */
                                   int add);         /* If (r2 != NULL && add) the produce is XOR'd with r2 */
 
+/* These multiply regions in w=4 and w=2.  Each byte holds 8/w elements,
+   packed from the low bits up, so two w=4 elements share a byte, low
+   nibble first.  With SSSE3, a multiply is two pshufbs per 16 bytes. */
+
+void galois_w04_region_multiply(char *region,       /* Region to multiply */
+                                  int multby,       /* Number to multiply by */
+                                  int nbytes,       /* Number of bytes in region */
+                                  char *r2,         /* If r2 != NULL, products go here.  
+                                                       Otherwise region is overwritten */
+                                  int add);         /* If (r2 != NULL && add) the produce is XOR'd with r2 */
+
+void galois_w02_region_multiply(char *region,       /* Region to multiply */
+                                  int multby,       /* Number to multiply by */
+                                  int nbytes,       /* Number of bytes in region */
+                                  char *r2,         /* If r2 != NULL, products go here.  
+                                                       Otherwise region is overwritten */
+                                  int add);         /* If (r2 != NULL && add) the produce is XOR'd with r2 */
+
+/* Prepared multiplication.  galois_prepare_multiply fills in the lookup
+   tables for multiplying by multby in GF(2^w), w = 2, 4, 8, 16 or 32, using the
+   field that is current for w.  galois_region_multiply_prepared then
+   multiplies a region by it, with the same arguments as the functions
+   above, without setting anything up per call.  This helps when the same
+   constants are applied to many small regions, as with the elements of a
+   coding matrix.  With SSSE3, each table is a set of 16-byte pshufb tables,
+   one for every (input nibble, output byte) pair.  Without it, the
+   GF-Complete region multiply is called.  nbytes must be a multiple of
+   w/8.  For w = 2 and 4, the regions are packed as above, and the tables
+   are laid out as for w = 8, each nibble being multiplied as a unit.
+
+   The tables assume the standard layout of words in a region.  If
+   galois_change_technique installs a field whose regions use another
+   layout (GF-Complete's ALTMAP), galois_region_multiply_prepared calls
+   that field's region multiply instead.  galois_standard_region_layout(w)
+   tells which case applies to w. */
+
+typedef struct {
+  int w;
+  int multby;
+  unsigned char tables[32][16];
+} galois_prepared_t;
+
+void galois_prepare_multiply(int multby, int w, galois_prepared_t *p);
+
+int galois_standard_region_layout(int w);
+
+void galois_region_multiply_prepared(char *region, galois_prepared_t *p, int nbytes,
+                                     char *r2, int add);
+
 gf_t* galois_init_field(int w,
                              int mult_type,
                              int region_type,
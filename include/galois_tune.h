@@ -0,0 +1,106 @@
+/* *
+ * Copyright (c) 2014, James S. Plank and Kevin Greenan
+ * All rights reserved.
+ *
+ * Jerasure - A C/C++ Library for a Variety of Reed-Solomon and RAID-6 Erasure
+ * Coding Techniques
+ *
+ * Revision 2.0: Galois Field backend now links to GF-Complete
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *  - Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ *  - Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ *
+ *  - Neither the name of the University of Tennessee nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY
+ * WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#pragma once
+
+#ifndef _GALOIS_TUNE_H
+#define _GALOIS_TUNE_H
+
+#include "galois.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* ------------------------------------------------------------ */
+/* Region-multiply autotuning. -------------------------------- */
+/*
+   GF-Complete offers several multiplication techniques for each w, and
+   which one is fastest for region multiplies depends on the processor and
+   the region size.  The autotuner times a fixed list of candidates for w
+   on this host, checks that each agrees with the default field, and
+   installs the fastest with galois_change_technique().  Only techniques
+   that keep the standard word layout are tried, so ALTMAP regions, and
+   with them COMPOSITE fields, are never chosen: their output could not be
+   read by code using a different technique.
+
+   Results can be kept in a cache file of lines like
+
+     <hostname> <w> <blocksize> <technique> <MB/s>
+
+   so that a later run on the same host installs the winner without timing.
+   Lines with another host name, w or blocksize are left untouched.
+
+ - galois_autotune times the candidates for w (8, 16 or 32) on regions of
+   blocksize bytes, installs the winner and describes it in *result if
+   result is not NULL.  Returns 0, or -1 if w or blocksize is bad.
+
+ - galois_autotune_cached does the same, but first looks for an entry for
+   this host, w and blocksize in cache_path.  If there is one, its
+   technique is installed without timing and result->from_cache is set.
+   Otherwise it tunes and writes the winner back to the file, replacing it
+   atomically.  If cache_path is NULL, this is galois_autotune.  Returns 0,
+   or -1 on bad arguments.  A cache file that cannot be written is not an
+   error.
+
+ - galois_tune_install installs the technique named name (as stored in
+   result->technique) for w.  Returns 0, or -1 if the name is unknown or
+   GF-Complete cannot build it on this host.
+ */
+
+#define GALOIS_TUNE_NAME_LEN 32
+
+typedef struct {
+  int w;
+  int blocksize;
+  char technique[GALOIS_TUNE_NAME_LEN];
+  double mb_per_sec;
+  int from_cache;
+} galois_tune_result_t;
+
+int galois_autotune(int w, int blocksize, galois_tune_result_t *result);
+int galois_autotune_cached(int w, int blocksize, const char *cache_path,
+                           galois_tune_result_t *result);
+int galois_tune_install(int w, const char *name);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
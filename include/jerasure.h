@@ -95,6 +95,27 @@ extern "C" {
           4 = destination packet (0 - w-1)
  */
 
+/* Number of bytes of cache that jerasure_matrix_multi_dotprod tries to
+   keep its working set in. */
+
+#ifndef JERASURE_FUSED_CACHE
+#define JERASURE_FUSED_CACHE (256*1024)
+#endif
+
+/* Helpers for routines that work a tile at a time.
+
+ - jerasure_tile_size returns the tile size with which n regions' tiles
+                      fit in JERASURE_FUSED_CACHE.  It is a multiple of
+                      64 bytes, and at least 1024.
+
+ - jerasure_region_is_zero returns whether the nbytes at p are all zero.
+                      It stops at the first 64 bytes that are not, so on
+                      ordinary data it costs next to nothing.
+ */
+
+int jerasure_tile_size(int n);
+int jerasure_region_is_zero(char *p, int nbytes);
+
 /* ---------------------------------------------------------------  */
 /* Bitmatrices / schedules ---------------------------------------- */
 /*
@@ -115,6 +136,14 @@ extern "C" {
 
  - jerasure_generate_schedule_cache precalcalculate all the schedule for the
                               given distribution bitmatrix.  M must equal 2.
+
+ - jerasure_generate_decoding_schedule makes the schedule that
+                              jerasure_schedule_decode_lazy uses to decode
+                              the given erasures.
+
+ - jerasure_set_up_ptrs_for_scheduled_decoding makes the array of k+m
+                              pointers that a decoding schedule runs on.
+                              Free it with free().
  
  - jerasure_free_schedule frees a schedule that was allocated with 
                               jerasure_XXX_bitmatrix_to_schedule.
@@ -127,6 +156,9 @@ int *jerasure_matrix_to_bitmatrix(int k, int m, int w, int *matrix);
 int **jerasure_dumb_bitmatrix_to_schedule(int k, int m, int w, int *bitmatrix);
 int **jerasure_smart_bitmatrix_to_schedule(int k, int m, int w, int *bitmatrix);
 int ***jerasure_generate_schedule_cache(int k, int m, int w, int *bitmatrix, int smart);
+int **jerasure_generate_decoding_schedule(int k, int m, int w, int *bitmatrix, int *erasures, int smart);
+char **jerasure_set_up_ptrs_for_scheduled_decoding(int k, int m, int *erasures,
+                                                   char **data_ptrs, char **coding_ptrs);
 
 void jerasure_free_schedule(int **schedule);
 void jerasure_free_schedule_cache(int k, int m, int ***cache);
@@ -134,10 +166,52 @@ void jerasure_free_schedule_cache(int k, int m, int ***cache);
 
 /* ------------------------------------------------------------ */
 /* Encoding - these are all straightforward.  jerasure_matrix_encode only 
-   works with w = 8|16|32.  */
+   works with w = 2|4|8|16|32.  With w = 2 and 4, every byte of a region
+   holds 8/w packed elements (see galois_w04_region_multiply), and k+m
+   must be at most 2^w.
+
+   jerasure_set_nontemporal_threshold makes jerasure_matrix_encode and
+   jerasure_schedule_encode write coding regions of at least nbytes with
+   non-temporal (streaming) stores, so that the coding data, which is
+   usually written out and not read again, does not evict the data from
+   the cache.  The coding is computed in a small scratch buffer and then
+   streamed to the coding devices.  Zero turns this off, which is the
+   default.  Without SSE2, the stores are regular ones.
+
+   jerasure_set_zero_detection turns on (1) or off (0, the default) the
+   skipping of all-zero data.  When it is on, jerasure_matrix_multi_dotprod,
+   and so jerasure_matrix_encode and the fused and multi-threaded routines
+   built on it, test each cache-sized tile of a source for zeros and skip
+   its multiplies and XORs.  A coding tile whose sources are all zero is
+   simply zeroed.  This pays off on sparse data such as preallocated disk
+   images, and costs little otherwise, since the test stops at the first
+   non-zero bytes.
+
+   jerasure_register_matrix_encoder installs encode as the kernel that
+   jerasure_matrix_encode uses for this k, m, w and matrix (compared by
+   value).  It is meant for encoders specialized for one configuration,
+   such as jerasure::fixed_codec in jerasure_fixed.hpp.  encode is called
+   with arg and returns 0 once it has encoded, or -1 to let
+   jerasure_matrix_encode do the work itself.  A matching registered
+   encoder is tried before non-temporal stores or zero detection, which it
+   need not honor, and its work is not counted by jerasure_get_stats.  Up to 16 encoders can be
+   registered.  The return value is an id for
+   jerasure_unregister_matrix_encoder, or -1.  Neither call may race with
+   jerasure_matrix_encode.  */
+
+typedef int (*jerasure_encoder_fn)(void *arg, char **data_ptrs, char **coding_ptrs, int size);
+
+int jerasure_register_matrix_encoder(int k, int m, int w, int *matrix,
+                                     jerasure_encoder_fn encode, void *arg);
+
+void jerasure_unregister_matrix_encoder(int id);
 
 void jerasure_do_parity(int k, char **data_ptrs, char *parity_ptr, int size);
 
+void jerasure_set_nontemporal_threshold(int nbytes);
+
+void jerasure_set_zero_detection(int on);
+
 void jerasure_matrix_encode(int k, int m, int w, int *matrix,
                           char **data_ptrs, char **coding_ptrs, int size);
 
@@ -147,6 +221,31 @@ void jerasure_bitmatrix_encode(int k, int m, int w, int *bitmatrix,
 void jerasure_schedule_encode(int k, int m, int w, int **schedule,
                                   char **data_ptrs, char **coding_ptrs, int size, int packetsize);
 
+/* ------------------------------------------------------------ */
+/* Verifying. ------------------------------------------------- */
+/*
+   These check that the coding devices are consistent with the data
+   devices, without writing the coding anywhere.  The coding is computed
+   a cache-sized tile at a time (a w*packetsize slice for schedules) into
+   scratch, and compared with the stored coding before the next tile is
+   computed.  They stop at the first tile with a mismatch.
+
+   They return 0 if every coding device matches.  Otherwise they return -1,
+   and if bad_device and bad_offset are not NULL, they set them to the
+   device (k .. k+m-1) and byte offset of the first mismatch.  When several
+   devices are wrong in the same tile, the earliest offset is reported,
+   and on a tie, the lowest device.
+
+   jerasure_matrix_verify only works with w = 2|4|8|16|32.  */
+
+int jerasure_matrix_verify(int k, int m, int w, int *matrix,
+                          char **data_ptrs, char **coding_ptrs, int size,
+                          int *bad_device, int *bad_offset);
+
+int jerasure_schedule_verify(int k, int m, int w, int **schedule,
+                             char **data_ptrs, char **coding_ptrs, int size, int packetsize,
+                             int *bad_device, int *bad_offset);
+
 /* ------------------------------------------------------------ */
 /* Decoding. -------------------------------------------------- */
 
@@ -162,7 +261,7 @@ void jerasure_schedule_encode(int k, int m, int w, int **schedule,
 
    jerasure_schedule_decode_lazy generates the schedule on the fly.
 
-   jerasure_matrix_decode only works when w = 8|16|32.
+   jerasure_matrix_decode only works when w = 2|4|8|16|32.
 
    jerasure_make_decoding_matrix/bitmatrix make the k*k decoding matrix
          (or wk*wk bitmatrix) by taking the rows corresponding to k
@@ -180,6 +279,20 @@ void jerasure_schedule_encode(int k, int m, int w, int **schedule,
          each device's id, according to whether the device is erased.
  
    jerasure_erasures_to_erased allocates and returns erased from erasures.
+
+   jerasure_make_recovery_matrix makes an e*k recovery matrix, where e is
+         the number of erased devices, data and coding alike.  Row i
+         times dm_ids equals device dest_ids[i], where dest_ids lists the
+         erased devices in increasing order.  recovery_matrix must hold
+         (k+m)*k integers, dest_ids k+m and dm_ids k.  It returns e,
+         or -1 if the decoding matrix is not invertible.
+
+   jerasure_matrix_decode_fused decodes like jerasure_matrix_decode, but
+         rebuilds every erased device (data and coding) in one pass over
+         the survivors, using the recovery matrix and
+         jerasure_matrix_multi_dotprod.  When several devices are erased,
+         this reads the survivors once instead of once per erased device.
+         It only works when w = 2|4|8|16|32.
     
  */
 
@@ -201,6 +314,12 @@ int jerasure_schedule_decode_cache(int k, int m, int w, int ***scache, int *eras
 int jerasure_make_decoding_matrix(int k, int m, int w, int *matrix, int *erased, 
                                   int *decoding_matrix, int *dm_ids);
 
+int jerasure_make_recovery_matrix(int k, int m, int w, int *matrix, int *erased,
+                                  int *recovery_matrix, int *dest_ids, int *dm_ids);
+
+int jerasure_matrix_decode_fused(int k, int m, int w, int *matrix, int *erasures,
+                          char **data_ptrs, char **coding_ptrs, int size);
+
 int jerasure_make_decoding_bitmatrix(int k, int m, int w, int *matrix, int *erased, 
                                   int *decoding_matrix, int *dm_ids);
 
@@ -213,7 +332,23 @@ int *jerasure_erasures_to_erased(int k, int m, int *erasures);
    for coding devices) that identify the source devices.  Dest_id is
    the id of the destination device.
 
-   jerasure_matrix_dotprod only works when w = 8|16|32.
+   jerasure_matrix_dotprod only works when w = 2|4|8|16|32.
+
+   jerasure_matrix_multi_dotprod performs rows dot products at once.  Matrix
+   is rows*k, and row r is stored in device dest_ids[r].  It works on tiles
+   of the regions that fit in JERASURE_FUSED_CACHE bytes, so that each source
+   is read from memory once.  It only works when w = 2|4|8|16|32.
+
+   jerasure_matrix_prepare makes the galois_prepared_t multiplication tables
+   for every element of a rows*cols matrix, in the same order as the matrix.
+   Make them once per coding matrix, and free them with free().  Returns
+   NULL if w is not 2|4|8|16|32 or memory runs out.
+
+   jerasure_matrix_multi_dotprod_prepared is jerasure_matrix_multi_dotprod,
+   but multiplies with the prepared tables of matrix instead of setting up
+   GF-Complete for each element on each call.  jerasure_matrix_encode_prepared
+   encodes with it.  These are worth it for small regions, where setting up
+   each multiply takes a good part of the time.
 
    jerasure_do_scheduled_operations executes the schedule on w*packetsize worth of
    bytes from each device.  ptrs is an array of pointers which should have as many
@@ -225,6 +360,19 @@ void jerasure_matrix_dotprod(int k, int w, int *matrix_row,
                           int *src_ids, int dest_id,
                           char **data_ptrs, char **coding_ptrs, int size);
 
+void jerasure_matrix_multi_dotprod(int k, int w, int rows, int *matrix,
+                          int *src_ids, int *dest_ids,
+                          char **data_ptrs, char **coding_ptrs, int size);
+
+galois_prepared_t *jerasure_matrix_prepare(int rows, int cols, int w, int *matrix);
+
+void jerasure_matrix_multi_dotprod_prepared(int k, int w, int rows, int *matrix,
+                          galois_prepared_t *tables, int *src_ids, int *dest_ids,
+                          char **data_ptrs, char **coding_ptrs, int size);
+
+void jerasure_matrix_encode_prepared(int k, int m, int w, int *matrix, galois_prepared_t *tables,
+                          char **data_ptrs, char **coding_ptrs, int size);
+
 void jerasure_bitmatrix_dotprod(int k, int w, int *bitmatrix_row,
                              int *src_ids, int dest_id,
                              char **data_ptrs, char **coding_ptrs, int size, int packetsize);
@@ -0,0 +1,129 @@
+/* *
+ * Copyright (c) 2014, James S. Plank and Kevin Greenan
+ * All rights reserved.
+ *
+ * Jerasure - A C/C++ Library for a Variety of Reed-Solomon and RAID-6 Erasure
+ * Coding Techniques
+ *
+ * Revision 2.0: Galois Field backend now links to GF-Complete
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *  - Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ *  - Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ *
+ *  - Neither the name of the University of Tennessee nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY
+ * WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#pragma once
+
+#ifndef _JERASURE_CHUNK_H
+#define _JERASURE_CHUNK_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* ------------------------------------------------------------ */
+/* Chunk files. ----------------------------------------------- */
+/*
+   A chunk file holds one device of an encoded file.  It starts with a
+   JERASURE_CHUNK_HEADER_SIZE byte header, followed by one segment per
+   stripe.  A segment is blocksize bytes of the device, followed by the
+   JERASURE_CHUNK_CRC_SIZE byte CRC32C of those bytes.  All integers are
+   little-endian.  The header is:
+
+     Offset  Size  Field
+       0      8    "JERCHUNK"
+       8      4    Format version (JERASURE_CHUNK_VERSION)
+      12      4    Header size
+      16      4    k
+      20      4    m
+      24      4    w
+      28      4    packetsize
+      32      4    Coding technique (as numbered by the encoder)
+      36      4    Device index, 0 .. k+m-1
+      40      4    blocksize
+      44      4    Number of stripes
+      48      8    Size of the original file
+      56      4    Reserved, zero
+      60      4    CRC32C of bytes 0-59
+
+   Since every segment has its own CRC, a reader can check one stripe of a
+   device without reading the rest, and treat a bad segment as an erasure.
+
+ - jerasure_crc32c continues the CRC32C (Castagnoli) of a byte stream.
+                              Start with crc = 0.  It uses the SSE4.2 crc32
+                              instruction when the library is built with
+                              it, and a table otherwise.
+
+ - jerasure_chunk_pack_header writes h into the JERASURE_CHUNK_HEADER_SIZE
+                              bytes at buf.
+
+ - jerasure_chunk_unpack_header reads a header from buf into h.  Returns -1
+                              if buf does not hold a header of a version
+                              that this library reads, or its CRC is bad.
+
+ - jerasure_chunk_segment_offset returns where the segment of the given
+                              stripe starts in the chunk file.
+
+ - jerasure_chunk_segment_trailer computes the CRC of a segment's blocksize
+                              bytes of data and writes it to trailer.
+
+ - jerasure_chunk_check_segment returns 0 if the data matches the CRC in
+                              trailer, and -1 otherwise.
+ */
+
+#define JERASURE_CHUNK_MAGIC       "JERCHUNK"
+#define JERASURE_CHUNK_VERSION     1
+#define JERASURE_CHUNK_HEADER_SIZE 64
+#define JERASURE_CHUNK_CRC_SIZE    4
+
+typedef struct {
+  int version;
+  int k, m, w;
+  int packetsize;
+  int technique;
+  int index;
+  int blocksize;
+  int nstripes;
+  uint64_t size;
+} jerasure_chunk_header_t;
+
+uint32_t jerasure_crc32c(uint32_t crc, const void *buf, size_t len);
+
+void jerasure_chunk_pack_header(jerasure_chunk_header_t *h, unsigned char *buf);
+int jerasure_chunk_unpack_header(unsigned char *buf, jerasure_chunk_header_t *h);
+long long jerasure_chunk_segment_offset(jerasure_chunk_header_t *h, int stripe);
+void jerasure_chunk_segment_trailer(char *data, int blocksize, unsigned char *trailer);
+int jerasure_chunk_check_segment(char *data, int blocksize, unsigned char *trailer);
+
+#ifdef __cplusplus
+}
+#endif
+#endif
@@ -0,0 +1,470 @@
+/* *
+ * Copyright (c) 2014, James S. Plank and Kevin Greenan
+ * All rights reserved.
+ *
+ * Jerasure - A C/C++ Library for a Variety of Reed-Solomon and RAID-6 Erasure
+ * Coding Techniques
+ *
+ * Revision 2.0: Galois Field backend now links to GF-Complete
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *  - Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ *  - Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ *
+ *  - Neither the name of the University of Tennessee nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY
+ * WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#pragma once
+
+/* ------------------------------------------------------------ */
+/* Encoders specialized at compile time for one k, m and w. ---- */
+/*
+   jerasure::fixed_codec<K, M, W> encodes K data regions into M coding
+   regions in GF(2^W), W = 8, 16 or 32, with a coding matrix that is fixed
+   when the codec is made.  K, M and W are template parameters, so the
+   loops over data and coding devices are fully unrolled.  There are no
+   branches on the coefficients, either: every coefficient, 0 and 1
+   included, goes through the same pshufb tables.  With SSSE3 the kernel
+   reads each data block once and builds all M coding blocks from it in
+   registers.  Otherwise, or when the field for W does not keep regions
+   in the standard layout, it calls galois_region_multiply_prepared on
+   cache-sized blocks.  Every instantiation adds code, so only
+   instantiate the configurations that are actually used.
+
+   This header needs C++14.  The library itself stays C.
+
+ - fixed_codec<K, M, W>::reed_sol_van_matrix() is a constexpr std::array
+   that equals reed_sol_vandermonde_coding_matrix(K, M, W) in the default
+   field for W.
+
+ - fixed_codec(matrix) copies a K*M coding matrix.  The named
+   constructors reed_sol_van(), cauchy_good() and cauchy_best() use the
+   matrices of reed_sol_vandermonde_coding_matrix(),
+   cauchy_good_general_coding_matrix() and cauchy_best_coding_matrix().
+   Multiplication uses the field that is current for W when the codec is
+   made.  If that field is not the default one, reed_sol_van() computes
+   the matrix at run time.
+
+ - encode(data_ptrs, coding_ptrs, size) does what
+   jerasure_matrix_encode(K, M, W, matrix(), ...) does.  size must be a
+   multiple of W/8.
+
+ - register_encoder() makes jerasure_matrix_encode use a copy of this
+   codec whenever it is called with K, M, W and this matrix (see
+   jerasure_register_matrix_encoder), also when non-temporal stores or
+   zero detection are on; the codec uses regular stores and does not
+   skip zeros.  The encoder stays registered for
+   the lifetime of the returned object.  registered() on it is false if
+   the registry was full.
+ */
+
+#if __cplusplus < 201402L
+#error "jerasure_fixed.hpp needs C++14"
+#endif
+
+#include <stdint.h>
+#include <array>
+#include <memory>
+#include <new>
+#include <utility>
+#include <cstdlib>
+
+#ifdef __SSSE3__
+#include <tmmintrin.h>
+#endif
+
+#include "galois.h"
+#include "jerasure.h"
+#include "reed_sol.h"
+#include "cauchy.h"
+
+namespace jerasure {
+
+namespace detail {
+
+/* The default primitive polynomials, with their high bits */
+
+constexpr uint64_t default_poly(int w)
+{
+  return (w == 8) ? 0x11dULL : (w == 16) ? 0x1100bULL : 0x100400007ULL;
+}
+
+template <int W>
+constexpr uint32_t gf_mult(uint32_t a, uint32_t b)
+{
+  uint64_t x = a, p = 0;
+
+  for (int i = 0; i < W; i++) {
+    if (b & 1) p ^= x;
+    b >>= 1;
+    x <<= 1;
+    if (x >> W) x ^= default_poly(W);
+  }
+  return (uint32_t) p;
+}
+
+template <int W>
+constexpr uint32_t gf_inverse(uint32_t a)
+{
+  uint32_t r = 1;
+
+  /* a^(2^W - 2) */
+  for (int i = 1; i < W; i++) {
+    a = gf_mult<W>(a, a);
+    r = gf_mult<W>(r, a);
+  }
+  return r;
+}
+
+template <int N>
+struct int_array {
+  int v[N];
+};
+
+/* reed_sol_big_vandermonde_distribution_matrix, step for step, but
+   keeping only the coding rows at the end. */
+
+template <int K, int M, int W>
+constexpr int_array<K*M> reed_sol_van()
+{
+  int_array<(K+M)*K> d = {};
+  int_array<K*M> out = {};
+  const int rows = K+M, cols = K;
+  int i = 0, j = 0, r = 0;
+  uint32_t e = 0, tmp = 0;
+
+  d.v[0] = 1;
+  for (j = 0; j < cols; j++) d.v[(rows-1)*cols+j] = (j == cols-1);
+  for (i = 1; i < rows-1; i++) {
+    e = 1;
+    for (j = 0; j < cols; j++) {
+      d.v[i*cols+j] = (int) e;
+      e = gf_mult<W>(e, (uint32_t) i);
+    }
+  }
+
+  for (i = 1; i < cols; i++) {
+    for (j = i; j < rows && d.v[j*cols+i] == 0; j++) ;
+    if (j != i) {
+      for (r = 0; r < cols; r++) {
+        tmp = (uint32_t) d.v[j*cols+r];
+        d.v[j*cols+r] = d.v[i*cols+r];
+        d.v[i*cols+r] = (int) tmp;
+      }
+    }
+    if (d.v[i*cols+i] != 1) {
+      tmp = gf_inverse<W>((uint32_t) d.v[i*cols+i]);
+      for (r = 0; r < rows; r++) d.v[r*cols+i] = (int) gf_mult<W>(tmp, (uint32_t) d.v[r*cols+i]);
+    }
+    for (j = 0; j < cols; j++) {
+      tmp = (uint32_t) d.v[i*cols+j];
+      if (j != i && tmp != 0) {
+        for (r = 0; r < rows; r++) {
+          d.v[r*cols+j] ^= (int) gf_mult<W>(tmp, (uint32_t) d.v[r*cols+i]);
+        }
+      }
+    }
+  }
+
+  for (j = 0; j < cols; j++) {
+    tmp = (uint32_t) d.v[cols*cols+j];
+    if (tmp != 1) {
+      tmp = gf_inverse<W>(tmp);
+      for (r = cols; r < rows; r++) d.v[r*cols+j] = (int) gf_mult<W>(tmp, (uint32_t) d.v[r*cols+j]);
+    }
+  }
+  for (i = cols+1; i < rows; i++) {
+    tmp = (uint32_t) d.v[i*cols];
+    if (tmp != 1) {
+      tmp = gf_inverse<W>(tmp);
+      for (j = 0; j < cols; j++) d.v[i*cols+j] = (int) gf_mult<W>((uint32_t) d.v[i*cols+j], tmp);
+    }
+  }
+
+  for (i = 0; i < K*M; i++) out.v[i] = d.v[K*K+i];
+  return out;
+}
+
+template <int N, size_t... I>
+constexpr std::array<int, N> to_std_array(const int_array<N> &a, std::index_sequence<I...>)
+{
+  return {{ a.v[I]... }};
+}
+
+/* unroll<N>::run(f) calls f(0) ... f(N-1), inlined */
+
+template <int N>
+struct unroll {
+  template <typename F>
+  static inline void run(const F &f) { unroll<N-1>::run(f); f(N-1); }
+};
+
+template <>
+struct unroll<0> {
+  template <typename F>
+  static inline void run(const F &) { }
+};
+
+#ifdef __SSSE3__
+
+/* 16 words of NB bytes to and from NB byte planes, as in galois.c */
+
+template <int NB>
+struct planes;
+
+template <>
+struct planes<1> {
+  static inline void split(const char *src, __m128i *v)
+  {
+    v[0] = _mm_loadu_si128((const __m128i *) src);
+  }
+  static inline void join(const __m128i *o, char *dest)
+  {
+    _mm_storeu_si128((__m128i *) dest, o[0]);
+  }
+};
+
+template <>
+struct planes<2> {
+  static inline void split(const char *src, __m128i *v)
+  {
+    __m128i a, b, lo;
+
+    a = _mm_loadu_si128((const __m128i *) src);
+    b = _mm_loadu_si128((const __m128i *) (src+16));
+    lo = _mm_set1_epi16(0x00ff);
+    v[0] = _mm_packus_epi16(_mm_and_si128(a, lo), _mm_and_si128(b, lo));
+    v[1] = _mm_packus_epi16(_mm_srli_epi16(a, 8), _mm_srli_epi16(b, 8));
+  }
+  static inline void join(const __m128i *o, char *dest)
+  {
+    _mm_storeu_si128((__m128i *) dest, _mm_unpacklo_epi8(o[0], o[1]));
+    _mm_storeu_si128((__m128i *) (dest+16), _mm_unpackhi_epi8(o[0], o[1]));
+  }
+};
+
+template <>
+struct planes<4> {
+  static inline __m128i tr()
+  {
+    return _mm_setr_epi8(0, 4, 8, 12, 1, 5, 9, 13, 2, 6, 10, 14, 3, 7, 11, 15);
+  }
+  static inline void split(const char *src, __m128i *v)
+  {
+    __m128i t[4];
+    int i;
+
+    for (i = 0; i < 4; i++) v[i] = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i *) (src+16*i)), tr());
+    t[0] = _mm_unpacklo_epi32(v[0], v[1]);
+    t[1] = _mm_unpacklo_epi32(v[2], v[3]);
+    t[2] = _mm_unpackhi_epi32(v[0], v[1]);
+    t[3] = _mm_unpackhi_epi32(v[2], v[3]);
+    v[0] = _mm_unpacklo_epi64(t[0], t[1]);
+    v[1] = _mm_unpackhi_epi64(t[0], t[1]);
+    v[2] = _mm_unpacklo_epi64(t[2], t[3]);
+    v[3] = _mm_unpackhi_epi64(t[2], t[3]);
+  }
+  static inline void join(const __m128i *o, char *dest)
+  {
+    __m128i t[4];
+
+    t[0] = _mm_unpacklo_epi32(o[0], o[1]);
+    t[1] = _mm_unpacklo_epi32(o[2], o[3]);
+    t[2] = _mm_unpackhi_epi32(o[0], o[1]);
+    t[3] = _mm_unpackhi_epi32(o[2], o[3]);
+    _mm_storeu_si128((__m128i *) dest, _mm_shuffle_epi8(_mm_unpacklo_epi64(t[0], t[1]), tr()));
+    _mm_storeu_si128((__m128i *) (dest+16), _mm_shuffle_epi8(_mm_unpackhi_epi64(t[0], t[1]), tr()));
+    _mm_storeu_si128((__m128i *) (dest+32), _mm_shuffle_epi8(_mm_unpacklo_epi64(t[2], t[3]), tr()));
+    _mm_storeu_si128((__m128i *) (dest+48), _mm_shuffle_epi8(_mm_unpackhi_epi64(t[2], t[3]), tr()));
+  }
+};
+
+#endif
+
+}  /* namespace detail */
+
+template <int K, int M, int W>
+class fixed_codec {
+  static_assert(W == 8 || W == 16 || W == 32, "W must be 8, 16 or 32");
+  static_assert(K > 0 && M > 0, "K and M must be positive");
+  static_assert(W == 32 || K+M <= (1 << W), "K+M must be at most 2^W");
+
+ public:
+  static constexpr std::array<int, K*M> reed_sol_van_matrix()
+  {
+    return detail::to_std_array<K*M>(detail::reed_sol_van<K, M, W>(),
+                                     std::make_index_sequence<K*M>());
+  }
+
+  explicit fixed_codec(const int *matrix)
+  {
+    int i;
+
+    for (i = 0; i < K*M; i++) {
+      matrix_[i] = matrix[i];
+      galois_prepare_multiply(matrix[i], W, &tables_[i]);
+    }
+  }
+
+  static fixed_codec reed_sol_van()
+  {
+    static constexpr std::array<int, K*M> vdm = reed_sol_van_matrix();
+    int *runtime;
+
+    if ((uint32_t) galois_single_multiply((int) (1U << (W-1)), 2, W) ==
+        (uint32_t) (detail::default_poly(W) & ((1ULL << W) - 1))) {
+      return fixed_codec(vdm.data());
+    }
+    runtime = reed_sol_vandermonde_coding_matrix(K, M, W);
+    return from_malloced(runtime);
+  }
+
+  static fixed_codec cauchy_good()
+  {
+    return from_malloced(cauchy_good_general_coding_matrix(K, M, W));
+  }
+
+  static fixed_codec cauchy_best()
+  {
+    return from_malloced(cauchy_best_coding_matrix(K, M, W));
+  }
+
+  const int *matrix() const { return matrix_.data(); }
+
+  void encode(char **data_ptrs, char **coding_ptrs, int size) const
+  {
+    int x, i;
+
+    x = 0;
+#ifdef __SSSE3__
+    if (galois_standard_region_layout(W)) x = encode_ssse3(data_ptrs, coding_ptrs, size);
+#endif
+    for (; x < size; x += BLOCK) {
+      i = (size - x < BLOCK) ? size - x : BLOCK;
+      encode_block(data_ptrs, coding_ptrs, x, i);
+    }
+  }
+
+  class registration {
+   public:
+    explicit registration(const fixed_codec &codec) : codec_(codec)
+    {
+      id_ = jerasure_register_matrix_encoder(K, M, W, codec_.matrix_.data(), &registration::call, this);
+    }
+    ~registration() { if (id_ >= 0) jerasure_unregister_matrix_encoder(id_); }
+    registration(const registration &) = delete;
+    registration &operator=(const registration &) = delete;
+    bool registered() const { return id_ >= 0; }
+
+   private:
+    static int call(void *arg, char **data_ptrs, char **coding_ptrs, int size)
+    {
+      if (size % (W/8) != 0) return -1;
+      static_cast<registration *>(arg)->codec_.encode(data_ptrs, coding_ptrs, size);
+      return 0;
+    }
+    fixed_codec codec_;
+    int id_;
+  };
+
+  std::unique_ptr<registration> register_encoder() const
+  {
+    return std::unique_ptr<registration>(new registration(*this));
+  }
+
+ private:
+  enum { BLOCK = 4096 };
+
+  static fixed_codec from_malloced(int *matrix)
+  {
+    if (matrix == NULL) throw std::bad_alloc();
+    fixed_codec c(matrix);
+    free(matrix);
+    return c;
+  }
+
+  /* Every coding region of [off, off+len) from galois_region_multiply_prepared */
+
+  void encode_block(char **data_ptrs, char **coding_ptrs, int off, int len) const
+  {
+    detail::unroll<M>::run([&](int i) {
+      detail::unroll<K>::run([&](int j) {
+        galois_region_multiply_prepared(data_ptrs[j]+off, const_cast<galois_prepared_t *>(&tables_[i*K+j]),
+                                        len, coding_ptrs[i]+off, j != 0);
+      });
+    });
+  }
+
+#ifdef __SSSE3__
+  /* Each block of 16 words of every data region is split into byte planes
+     and nibbles once, and all M coding blocks are summed in registers
+     before they are joined into words and stored.  Returns the number of
+     bytes done. */
+
+  int encode_ssse3(char **data_ptrs, char **coding_ptrs, int size) const
+  {
+    const int NB = W/8;
+    const __m128i mask = _mm_set1_epi8(0x0f);
+    int x;
+
+    for (x = 0; x + 16*NB <= size; x += 16*NB) {
+      __m128i acc[M][NB];
+
+      detail::unroll<K>::run([&](int j) {
+        __m128i v[NB], n[2*NB];
+        int b;
+
+        detail::planes<NB>::split(data_ptrs[j]+x, v);
+        for (b = 0; b < NB; b++) {
+          n[2*b] = _mm_and_si128(v[b], mask);
+          n[2*b+1] = _mm_and_si128(_mm_srli_epi64(v[b], 4), mask);
+        }
+        detail::unroll<M>::run([&](int i) {
+          const galois_prepared_t *p = &tables_[i*K+j];
+          __m128i s;
+          int o, t;
+
+          for (o = 0; o < NB; o++) {
+            s = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i *) p->tables[o]), n[0]);
+            for (t = 1; t < 2*NB; t++) {
+              s = _mm_xor_si128(s, _mm_shuffle_epi8(_mm_loadu_si128((const __m128i *) p->tables[t*NB+o]),
+                                                    n[t]));
+            }
+            acc[i][o] = (j == 0) ? s : _mm_xor_si128(acc[i][o], s);
+          }
+        });
+      });
+      detail::unroll<M>::run([&](int i) { detail::planes<NB>::join(acc[i], coding_ptrs[i]+x); });
+    }
+    return x;
+  }
+#endif
+
+  std::array<int, K*M> matrix_;
+  std::array<galois_prepared_t, K*M> tables_;
+};
+
+}  /* namespace jerasure */
@@ -0,0 +1,93 @@
+/* *
+ * Copyright (c) 2014, James S. Plank and Kevin Greenan
+ * All rights reserved.
+ *
+ * Jerasure - A C/C++ Library for a Variety of Reed-Solomon and RAID-6 Erasure
+ * Coding Techniques
+ *
+ * Revision 2.0: Galois Field backend now links to GF-Complete
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *  - Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ *  - Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ *
+ *  - Neither the name of the University of Tennessee nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY
+ * WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#pragma once
+
+#ifndef _JERASURE_IOV_H
+#define _JERASURE_IOV_H
+
+#include <sys/uio.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* ------------------------------------------------------------ */
+/* Scatter-gather coding. ------------------------------------- */
+/*
+   In these routines, a device does not have to be one contiguous region.
+   Device i is instead the data_iovcnt[i] segments of data_iov[i] (or
+   coding_iovcnt[i-k] segments of coding_iov[i-k] for a coding device),
+   taken in order.  Segments may be of any length, including zero, and
+   only the first size bytes of each device are used.  The routines work
+   on runs of bytes where no device crosses a segment boundary, so the
+   segments are coded in place, without first being copied into one
+   buffer.  Where the devices are not at the same address mod 16, as
+   GF-Complete requires, or a word straddles a boundary, a few KB of
+   every device are gathered into an aligned buffer and coded there.
+
+   Only w = 8, 16 and 32 are supported, and size must be a multiple of
+   w/8.
+
+ - jerasure_matrix_encode_iov is jerasure_matrix_encode on segmented
+                              devices.  It reads each data device once for
+                              all m coding devices.  It is an error for
+                              a device to be shorter than size bytes.
+
+ - jerasure_matrix_decode_iov is jerasure_matrix_decode on segmented
+                              devices.  Erased devices, data and coding
+                              alike, are rebuilt in one pass over the
+                              survivors, like jerasure_matrix_decode_fused.
+                              Returns 0 on success, and -1 if the erasures
+                              cannot be decoded or a device is shorter
+                              than size bytes.
+ */
+
+void jerasure_matrix_encode_iov(int k, int m, int w, int *matrix,
+                                struct iovec **data_iov, int *data_iovcnt,
+                                struct iovec **coding_iov, int *coding_iovcnt, int size);
+
+int jerasure_matrix_decode_iov(int k, int m, int w, int *matrix, int *erasures,
+                               struct iovec **data_iov, int *data_iovcnt,
+                               struct iovec **coding_iov, int *coding_iovcnt, int size);
+
+#ifdef __cplusplus
+}
+#endif
+#endif
@@ -0,0 +1,185 @@
+/* *
+ * Copyright (c) 2013, James S. Plank and Kevin Greenan
+ * All rights reserved.
+ *
+ * Jerasure - A C/C++ Library for a Variety of Reed-Solomon and RAID-6 Erasure
+ * Coding Techniques
+ *
+ * Revision 2.0: Galois Field backend now links to GF-Complete
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *  - Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ *  - Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ *
+ *  - Neither the name of the University of Tennessee nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY
+ * WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#pragma once
+
+#ifndef _JERASURE_MT_H
+#define _JERASURE_MT_H
+
+#include "jerasure.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* ------------------------------------------------------------ */
+/* Multi-threaded coding. ------------------------------------- */
+/*
+   These routines split each device into byte-range tiles and hand the
+   tiles to a pool of POSIX threads.  Every tile is coded completely by
+   one thread, so the tiles are independent and no locking is needed on
+   the regions.
+
+ - jerasure_mt_pool_create starts a pool of nthreads threads.  The
+                              calling thread counts as one of them, so
+                              nthreads-1 workers are created.  nthreads <= 0
+                              means one thread per online processor.
+                              Returns NULL on failure.
+
+ - jerasure_mt_pool_create_affinity is jerasure_mt_pool_create, but pins the
+                              threads to CPUs according to policy:
+
+      JERASURE_MT_AFFINITY_NONE:    Threads are not pinned.  Tasks are
+                                    handed to whichever thread is free.
+      JERASURE_MT_AFFINITY_COMPACT: Thread i is pinned to the i-th CPU
+                                    that the process may run on.
+      JERASURE_MT_AFFINITY_SCATTER: Threads are spread round-robin over
+                                    the NUMA nodes.
+
+                              In pinned pools, the calling thread does not
+                              code, and every thread gets the same block of
+                              tasks on every call.  So, the thread that
+                              codes a given tile of the devices always runs
+                              on the same CPU.  Pinning is only done on
+                              Linux.  The NUMA topology comes from libnuma
+                              if it is installed, and from sysfs otherwise.
+
+ - jerasure_mt_pool_destroy stops the workers and frees the pool.
+
+ - jerasure_mt_pool_size returns the number of threads in the pool.
+
+ - jerasure_mt_parallel_for calls fn(arg, task, thread) for every task in
+                              0 .. ntasks-1, spreading the tasks over the
+                              pool, and returns when all of them are done.
+                              thread is between 0 and jerasure_mt_pool_size()-1
+                              and may be used to index per-thread scratch.
+                              Calls on the same pool are serialized.
+
+ - jerasure_mt_thread_cpu and jerasure_mt_thread_node return the CPU and NUMA
+                              node that a thread is pinned to, or -1.
+
+ - jerasure_mt_alloc allocates n regions of size bytes, one after the other,
+                              and has the pool's threads touch them first,
+                              in the same tiles that the coding routines use.
+                              With a pinned pool, each tile of memory is then
+                              on the NUMA node of the thread that codes it.
+                              Use it for the data and coding devices, and
+                              free it with jerasure_mt_free.  Returns NULL on
+                              failure.
+
+ - jerasure_mt_tile_size picks the tile size used to split size bytes among
+                              the threads of a pool.  It is always a multiple
+                              of JERASURE_MT_ALIGN.
+
+ - jerasure_matrix_encode_mt is jerasure_matrix_encode, run on the pool.
+                              Each tile is encoded with
+                              jerasure_matrix_multi_dotprod, so the data is
+                              read once for all m coding devices.
+
+ - jerasure_matrix_decode_mt is jerasure_matrix_decode, run on the pool.  It
+                              takes the same arguments and returns the same
+                              values.  Each tile is decoded like
+                              jerasure_matrix_decode_fused, so the erased
+                              coding devices are rebuilt in the same pass
+                              as the erased data devices, and row_k_ones is
+                              ignored.  A NULL pool decodes on the calling
+                              thread.
+
+ - jerasure_schedule_encode_mt, jerasure_schedule_decode_lazy_mt and
+   jerasure_schedule_decode_cache_mt are the schedule routines, run on the
+                              pool.  The schedule is applied to each
+                              w*packetsize slice independently, so the
+                              threads get runs of consecutive slices, each
+                              with its own copy of the pointer array.
+                              size must be a multiple of w*packetsize.
+
+   jerasure_get_stats() is not accurate while these routines run, since the
+   statistics counters are not updated atomically.
+ */
+
+#define JERASURE_MT_ALIGN    64
+#define JERASURE_MT_MIN_TILE (16*1024)
+
+#define JERASURE_MT_AFFINITY_NONE    0
+#define JERASURE_MT_AFFINITY_COMPACT 1
+#define JERASURE_MT_AFFINITY_SCATTER 2
+
+typedef struct jerasure_mt_pool jerasure_mt_pool_t;
+
+jerasure_mt_pool_t *jerasure_mt_pool_create(int nthreads);
+jerasure_mt_pool_t *jerasure_mt_pool_create_affinity(int nthreads, int policy);
+void jerasure_mt_pool_destroy(jerasure_mt_pool_t *pool);
+int jerasure_mt_pool_size(jerasure_mt_pool_t *pool);
+int jerasure_mt_thread_cpu(jerasure_mt_pool_t *pool, int thread);
+int jerasure_mt_thread_node(jerasure_mt_pool_t *pool, int thread);
+
+char *jerasure_mt_alloc(jerasure_mt_pool_t *pool, int n, int size);
+void jerasure_mt_free(char *buf, int n, int size);
+
+void jerasure_mt_parallel_for(jerasure_mt_pool_t *pool, int ntasks,
+                              void (*fn)(void *arg, int task, int thread), void *arg);
+
+int jerasure_mt_tile_size(jerasure_mt_pool_t *pool, int size);
+
+void jerasure_matrix_encode_mt(jerasure_mt_pool_t *pool,
+                               int k, int m, int w, int *matrix,
+                               char **data_ptrs, char **coding_ptrs, int size);
+
+int jerasure_matrix_decode_mt(jerasure_mt_pool_t *pool,
+                              int k, int m, int w,
+                              int *matrix, int row_k_ones, int *erasures,
+                              char **data_ptrs, char **coding_ptrs, int size);
+
+void jerasure_schedule_encode_mt(jerasure_mt_pool_t *pool,
+                                 int k, int m, int w, int **schedule,
+                                 char **data_ptrs, char **coding_ptrs, int size, int packetsize);
+
+int jerasure_schedule_decode_lazy_mt(jerasure_mt_pool_t *pool,
+                                     int k, int m, int w, int *bitmatrix, int *erasures,
+                                     char **data_ptrs, char **coding_ptrs, int size, int packetsize,
+                                     int smart);
+
+int jerasure_schedule_decode_cache_mt(jerasure_mt_pool_t *pool,
+                                      int k, int m, int w, int ***scache, int *erasures,
+                                      char **data_ptrs, char **coding_ptrs, int size, int packetsize);
+
+#ifdef __cplusplus
+}
+#endif
+#endif
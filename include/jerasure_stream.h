@@ -0,0 +1,115 @@
+/* *
+ * Copyright (c) 2014, James S. Plank and Kevin Greenan
+ * All rights reserved.
+ *
+ * Jerasure - A C/C++ Library for a Variety of Reed-Solomon and RAID-6 Erasure
+ * Coding Techniques
+ *
+ * Revision 2.0: Galois Field backend now links to GF-Complete
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *  - Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ *  - Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ *
+ *  - Neither the name of the University of Tennessee nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY
+ * WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#pragma once
+
+#ifndef _JERASURE_STREAM_H
+#define _JERASURE_STREAM_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* ------------------------------------------------------------ */
+/* Streaming encoder. ----------------------------------------- */
+/*
+   A stream encoder takes its input in appends of any length, cuts it into
+   stripes of k*blocksize bytes and encodes each stripe as soon as it is
+   complete.  For every stripe it calls
+
+      callback(arg, stripe, data_ptrs, coding_ptrs, blocksize, nbytes)
+
+   where stripe counts from zero, and nbytes is the number of input bytes in
+   the stripe.  The k+m devices are only valid during the call.  If the
+   callback returns non-zero, the append or finalize that triggered it
+   returns -1.
+
+ - jerasure_stream_create_matrix makes a stream that encodes with
+                              jerasure_matrix_encode.  blocksize must be a
+                              multiple of sizeof(long).  The matrix is not
+                              copied.  Returns NULL on failure.
+
+ - jerasure_stream_create_schedule makes a stream that encodes with
+                              jerasure_schedule_encode.  blocksize must be
+                              a multiple of w*packetsize, and packetsize a
+                              multiple of sizeof(long).  The schedule is not
+                              copied.
+
+ - jerasure_stream_append adds len bytes.  Input is only copied when it
+                              does not start a whole stripe: full stripes
+                              at the start of an append are encoded where
+                              they are, as long as buf and blocksize are
+                              multiples of 16.  Returns 0, or -1 if a callback
+                              failed.
+
+ - jerasure_stream_finalize encodes the partial stripe that is left, if
+                              any.  Its blocksize is cut down to the
+                              smallest legal size that holds the bytes left,
+                              so the padding, which is zeros, is less than
+                              k*sizeof(long) bytes for matrix streams, and
+                              less than k*w*packetsize bytes for schedule
+                              streams.  The stream may then be appended to
+                              again, starting a new stripe.  Returns 0, or
+                              -1 if the callback failed.
+
+ - jerasure_stream_destroy frees the stream.  A partial stripe that has
+                              not been finalized is dropped.
+ */
+
+typedef int (*jerasure_stream_callback)(void *arg, long stripe,
+                                        char **data_ptrs, char **coding_ptrs,
+                                        int blocksize, int nbytes);
+
+typedef struct jerasure_stream jerasure_stream_t;
+
+jerasure_stream_t *jerasure_stream_create_matrix(int k, int m, int w, int *matrix, int blocksize,
+                                                 jerasure_stream_callback callback, void *arg);
+
+jerasure_stream_t *jerasure_stream_create_schedule(int k, int m, int w, int **schedule,
+                                                   int blocksize, int packetsize,
+                                                   jerasure_stream_callback callback, void *arg);
+
+int jerasure_stream_append(jerasure_stream_t *s, char *buf, int len);
+int jerasure_stream_finalize(jerasure_stream_t *s);
+void jerasure_stream_destroy(jerasure_stream_t *s);
+
+#ifdef __cplusplus
+}
+#endif
+#endif
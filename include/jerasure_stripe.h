@@ -0,0 +1,114 @@
+/* *
+ * Copyright (c) 2014, James S. Plank and Kevin Greenan
+ * All rights reserved.
+ *
+ * Jerasure - A C/C++ Library for a Variety of Reed-Solomon and RAID-6 Erasure
+ * Coding Techniques
+ *
+ * Revision 2.0: Galois Field backend now links to GF-Complete
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *  - Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ *  - Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ *
+ *  - Neither the name of the University of Tennessee nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY
+ * WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#pragma once
+
+#ifndef _JERASURE_STRIPE_H
+#define _JERASURE_STRIPE_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* ------------------------------------------------------------ */
+/* Stripe buffers. -------------------------------------------- */
+/*
+   A stripe is the k data and m coding devices for one call to the coding
+   routines.  The buffers come from a single aligned allocation, and freed
+   stripes are kept on a free list so that a loop that encodes one stripe
+   after another reuses the same warm, already-faulted memory instead of
+   calling malloc() every time.
+
+ - jerasure_alloc_stripe returns a stripe of k data and m coding devices of
+                              blocksize bytes each.  Every device starts on
+                              an align-byte boundary (align must be a power
+                              of two; 0 means JERASURE_STRIPE_ALIGN), and is
+                              padded to a multiple of align bytes, which is
+                              stripe->stride.  If a stripe with the same k, m,
+                              blocksize and align was freed earlier, it is
+                              handed back instead of allocating a new one.
+                              The contents of the buffers are undefined.
+                              Returns NULL on failure.
+
+ - jerasure_free_stripe puts the stripe back on the free list.  At most
+                              JERASURE_STRIPE_POOL_MAX stripes are kept;
+                              beyond that, the memory is released.
+
+ - jerasure_stripe_pool_drain releases every stripe on the free list.
+
+ - jerasure_stripe_set_hugepages controls whether stripes of at least
+                              JERASURE_STRIPE_HUGE_SIZE bytes are backed by
+                              huge pages.  When on, jerasure_alloc_stripe
+                              first tries mmap() with MAP_HUGETLB, and then
+                              falls back to normal pages with
+                              madvise(MADV_HUGEPAGE).  The default is off.
+                              This only affects stripes allocated afterward.
+
+   These routines are thread-safe.
+ */
+
+#define JERASURE_STRIPE_ALIGN     64
+#define JERASURE_STRIPE_POOL_MAX  16
+#define JERASURE_STRIPE_HUGE_SIZE (2*1024*1024)
+
+typedef struct jerasure_stripe {
+  int k;                           /* Number of data devices */
+  int m;                           /* Number of coding devices */
+  int blocksize;                   /* Bytes of each device */
+  int stride;                      /* Distance between devices, in bytes */
+  char **data;                     /* k pointers to the data devices */
+  char **coding;                   /* m pointers to the coding devices */
+
+  /* The rest is private to the allocator. */
+  int align;
+  int how;
+  char *base;
+  size_t bytes;
+  struct jerasure_stripe *next;
+} jerasure_stripe_t;
+
+jerasure_stripe_t *jerasure_alloc_stripe(int k, int m, int blocksize, int align);
+void jerasure_free_stripe(jerasure_stripe_t *stripe);
+void jerasure_stripe_pool_drain(void);
+void jerasure_stripe_set_hugepages(int on);
+
+#ifdef __cplusplus
+}
+#endif
+#endif
@@ -47,6 +47,43 @@ extern int *liberation_coding_bitmatrix(int k, int w);
 extern int *liber8tion_coding_bitmatrix(int k);
 extern int *blaum_roth_coding_bitmatrix(int k, int w);
 
+/* Decoders for Liberation, Blaum-Roth and Liber8tion codes (m = 2) that
+   do not invert the kw x kw bitmatrix as jerasure_schedule_decode_lazy
+   does.  They solve only for the erased cells and follow the code's
+   chains where that is cheapest.  The schedule for each code, k, w and
+   set of erased devices is built on first use and kept, so repeated
+   decodes of the same pattern do no planning.  Arguments are as for
+   jerasure_schedule_decode_lazy.  They return 0, or -1 if the arguments
+   are bad or the erasures cannot be recovered. */
+
+extern int liberation_decode(int k, int w, int *erasures, char **data_ptrs, char **coding_ptrs,
+                             int size, int packetsize);
+extern int blaum_roth_decode(int k, int w, int *erasures, char **data_ptrs, char **coding_ptrs,
+                             int size, int packetsize);
+extern int liber8tion_decode(int k, int *erasures, char **data_ptrs, char **coding_ptrs,
+                             int size, int packetsize);
+
+/* RDP and EVENODD are RAID-6 codes with m = 2, where w+1 must be an odd
+   prime.  RDP allows k <= w and EVENODD allows k <= w+1.  The bitmatrices
+   work with the jerasure_schedule and jerasure_bitmatrix routines.  The
+   encode and decode routines instead use the diagonal structure directly:
+   encoding builds P, then Q a diagonal at a time (with RDP's minimal XOR
+   count), and decoding recovers any two erasures by following row and
+   diagonal chains.  size must be a multiple of w*packetsize.  erasures is
+   terminated by -1, as in jerasure_matrix_decode.  The decoders return 0,
+   or -1 if the erasures cannot be recovered. */
+
+extern int *rdp_coding_bitmatrix(int k, int w);
+extern int *evenodd_coding_bitmatrix(int k, int w);
+
+extern void rdp_encode(int k, int w, char **data_ptrs, char **coding_ptrs, int size, int packetsize);
+extern int rdp_decode(int k, int w, int *erasures, char **data_ptrs, char **coding_ptrs,
+                      int size, int packetsize);
+
+extern void evenodd_encode(int k, int w, char **data_ptrs, char **coding_ptrs, int size, int packetsize);
+extern int evenodd_decode(int k, int w, int *erasures, char **data_ptrs, char **coding_ptrs,
+                          int size, int packetsize);
+
 #ifdef __cplusplus
 }
 #endif
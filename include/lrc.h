@@ -0,0 +1,79 @@
+/* *
+ * Copyright (c) 2013, James S. Plank and Kevin Greenan
+ * All rights reserved.
+ *
+ * Jerasure - A C/C++ Library for a Variety of Reed-Solomon and RAID-6 Erasure
+ * Coding Techniques
+ *
+ * Revision 2.0: Galois Field backend now links to GF-Complete
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *  - Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ *  - Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ *
+ *  - Neither the name of the University of Tennessee nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY
+ * WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#pragma once
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Locally repairable codes, in the style of Azure's LRC.  The k data
+   devices are split into l local groups of consecutive devices, as evenly
+   as possible.  Each group gets a local parity, the XOR of its data, and r
+   global parities cover all the data.  Global parity j (1 <= j <= r) has
+   coefficient (i+1)^j for data device i, so any r erasures can be decoded
+   from the global parities alone, and a single erasure in a group is
+   repaired from that group alone, reading about k/l devices instead of k.
+
+   Device ids are 0 .. k-1 for data, k .. k+l-1 for the local parities and
+   k+l .. k+l+r-1 for the global parities.
+
+   lrc_coding_matrix returns the (l+r) x k coding matrix: l local rows, then
+   r global rows.  Encode with jerasure_matrix_encode(k, l+r, w, ...).
+   w must be 8, 16 or 32, and 1 <= l <= k.
+
+   lrc_repair_plan lists in reads (which must hold k+l+r+1 ints) the
+   devices that lrc_decode will read to rebuild the erased ones, ending the
+   list with -1.  Each group with a single erasure is repaired locally.  The
+   remaining data are decoded from the fewest surviving parities that
+   suffice, local ones first.  Returns the number of devices to read, or -1
+   if the erasures cannot be decoded.
+
+   lrc_decode rebuilds every erased device in place.  It only touches the
+   devices listed by lrc_repair_plan, so the others may be NULL.  Returns 0,
+   or -1 if the erasures cannot be decoded. */
+
+extern int *lrc_coding_matrix(int k, int l, int r, int w);
+extern int lrc_repair_plan(int k, int l, int r, int w, int *matrix, int *erasures, int *reads);
+extern int lrc_decode(int k, int l, int r, int w, int *matrix, int *erasures,
+                      char **data_ptrs, char **coding_ptrs, int size);
+
+#ifdef __cplusplus
+}
+#endif
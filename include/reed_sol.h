@@ -47,7 +47,30 @@ extern int *reed_sol_vandermonde_coding_matrix(int k, int m, int w);
 extern int *reed_sol_extended_vandermonde_matrix(int rows, int cols, int w);
 extern int *reed_sol_big_vandermonde_distribution_matrix(int rows, int cols, int w);
 
+/* reed_sol_vandermonde_correct finds and fixes errors at unknown positions.
+   For every word of the stripe, it computes the syndrome from the coding
+   matrix, and if it is not zero, finds the at most m/2 devices whose words
+   are wrong and corrects them in place.  w must be 8, 16 or 32.  It works
+   with any MDS coding matrix, not just the Vandermonde one.  If corrected
+   is not NULL, entry i of it (0 <= i < k+m) is set to 1 when device i had
+   an error.  Returns the number of words that were corrected, or -1 if
+   some word had more than m/2 errors, in which case the stripe may have
+   only been partly corrected. */
+
+extern int reed_sol_vandermonde_correct(int k, int m, int w, int *matrix,
+                                        char **data_ptrs, char **coding_ptrs, int size,
+                                        int *corrected);
+
 extern int reed_sol_r6_encode(int k, int w, char **data_ptrs, char **coding_ptrs, int size);
+
+/* reed_sol_r6_decode recovers from any one or two erasures of a stripe
+   made by reed_sol_r6_encode, with closed-form coefficients instead of a
+   matrix inversion.  erasures is terminated by -1, with ids as in
+   jerasure_matrix_decode.  Returns 0, or -1 if w is not 8, 16 or 32 or
+   there are more than two erasures. */
+
+extern int reed_sol_r6_decode(int k, int w, int *erasures, char **data_ptrs, char **coding_ptrs,
+                              int size);
 extern int *reed_sol_r6_coding_matrix(int k, int w);
 
 extern void reed_sol_galois_w08_region_multby_2(char *region, int nbytes);
@@ -0,0 +1,82 @@
+/* *
+ * Copyright (c) 2014, James S. Plank and Kevin Greenan
+ * All rights reserved.
+ *
+ * Jerasure - A C/C++ Library for a Variety of Reed-Solomon and RAID-6 Erasure
+ * Coding Techniques
+ *
+ * Revision 2.0: Galois Field backend now links to GF-Complete
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *  - Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ *  - Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ *
+ *  - Neither the name of the University of Tennessee nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY
+ * WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#pragma once
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* ------------------------------------------------------------ */
+/* Reed-Solomon coding with the additive FFT. ----------------- */
+/*
+   These encode and decode a systematic, MDS Reed-Solomon code in
+   GF(2^16) with the additive FFT of Lin, Chung and Han, in which
+   polynomials are kept in their "novel" basis.  The coding matrix
+   methods cost k*m region multiplies per stripe.  Here encoding costs
+   about (k+m) log2(m) and decoding about n log2(n), where n is the
+   smallest power of two >= k + (m rounded up to a power of two).  This
+   pays off for wide stripes, e.g. k = 100 and m = 20 and beyond.
+
+   The code is not the one from reed_sol_vandermonde_coding_matrix(),
+   so stripes from the two are not interchangeable.  Symbols are 16-bit
+   words, as for w = 16 elsewhere.  The field is the one current for
+   w = 16 when these are first called, and 2 must generate it, as it
+   does for the default polynomial.
+
+   Device ids are 0 .. k-1 for data and k .. k+m-1 for coding, as in
+   jerasure_matrix_decode().  k and m must be at least 1, k plus m
+   rounded up to a power of two must be <= 65536, and size must be a
+   multiple of sizeof(long).
+
+ - reed_sol_fft_encode computes the m coding devices.  Returns 0, or
+   -1 if the parameters are bad.
+
+ - reed_sol_fft_decode rebuilds the erased devices (erasures is
+   terminated by -1).  Returns 0, or -1 if the parameters are bad or
+   more than m devices are erased.
+ */
+
+extern int reed_sol_fft_encode(int k, int m, char **data_ptrs, char **coding_ptrs, int size);
+extern int reed_sol_fft_decode(int k, int m, int *erasures, char **data_ptrs, char **coding_ptrs,
+                               int size);
+
+#ifdef __cplusplus
+}
+#endif
@@ -47,6 +47,7 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <pthread.h>
 
 #include "galois.h"
 #include "jerasure.h"
@@ -56,8 +57,25 @@ static int PPs[33] = { -1, -1, -1, -1, -1, -1, -1, -1,
                        -1, -1, -1, -1, -1, -1, -1, -1,
                        -1, -1, -1, -1, -1, -1, -1, -1,
                        -1, -1, -1, -1, -1, -1, -1, -1, -1 };
-static int NOs[33];
-static int ONEs[33][33];
+
+static pthread_mutex_t PPs_lock = PTHREAD_MUTEX_INITIALIZER;
+
+/* For w <= CAUCHY_TABLE_MAX_W, the number of ones of every element is
+   kept in a table, and so are logs and antilogs base 2, when 2 generates
+   the field.  exp has 2(2^w-1) entries so that a difference of logs never
+   needs reducing.  Tables[w] is built under Tables_lock and published
+   with a release store. */
+
+#define CAUCHY_TABLE_MAX_W 16
+
+typedef struct {
+  unsigned short *ones;
+  unsigned short *log;
+  unsigned short *exp;
+} cauchy_tables;
+
+static cauchy_tables *Tables[CAUCHY_TABLE_MAX_W+1];
+static pthread_mutex_t Tables_lock = PTHREAD_MUTEX_INITIALIZER;
 
 static int *cbest_0;
 static int *cbest_1;
@@ -79,54 +97,118 @@ static int cbest_max_k[33] = { -1, -1, 3, 7, 15, 31, 63, 127, 255, 511, 1023, 10
      -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
      -1, -1, -1, -1 };
 
-static int cbest_init = 0;
+static pthread_once_t cbest_once = PTHREAD_ONCE_INIT;
+
+/* X and Y for m = 3 and m = 4, found with cauchy_search_xy() (see
+   Examples/cauchy_search).  cbest_xy_m[w-CBEST_XY_MIN_W][k-1] holds X and
+   then Y, or starts with -1 when k+m > 2^w. */
+
+#define CBEST_XY_MIN_W 4
+#define CBEST_XY_MAX_W 16
+#define CBEST_XY_MAX_K 20
+
+static int cbest_xy_3[CBEST_XY_MAX_W-CBEST_XY_MIN_W+1][CBEST_XY_MAX_K][3+CBEST_XY_MAX_K];
+static int cbest_xy_4[CBEST_XY_MAX_W-CBEST_XY_MIN_W+1][CBEST_XY_MAX_K][4+CBEST_XY_MAX_K];
 
 static int *cbest_all[33];
 
 
 #define talloc(type, num) (type *) malloc(sizeof(type)*(num))
 
-int cauchy_n_ones(int n, int w)
+/* The primitive polynomial of the current field for w, without its high bit */
+
+static int prim_poly(int w)
 {
-  int no;
-  int cno;
-  int nones;
-  int i, j;
-  int highbit;
-
-  highbit = (1 << (w-1));
-
-  if (PPs[w] == -1) {
-    nones = 0;
-    PPs[w] = galois_single_multiply(highbit, 2, w);
-    for (i = 0; i < w; i++) {
-      if (PPs[w] & (1 << i)) {
-        ONEs[w][nones] = (1 << i);
-        nones++;
-      }
+  int pp;
+
+  pp = __atomic_load_n(&PPs[w], __ATOMIC_ACQUIRE);
+  if (pp == -1) {
+    pthread_mutex_lock(&PPs_lock);
+    if (PPs[w] == -1) {
+      __atomic_store_n(&PPs[w], galois_single_multiply(1 << (w-1), 2, w), __ATOMIC_RELEASE);
     }
-    NOs[w] = nones;
+    pp = PPs[w];
+    pthread_mutex_unlock(&PPs_lock);
   }
+  return pp;
+}
+
+/* Column i of the bitmatrix of n holds the bits of n * 2^i */
+
+static int count_ones(unsigned int n, int w, unsigned int pp)
+{
+  unsigned int highbit;
+  int i, no;
 
+  highbit = 1U << (w-1);
   no = 0;
-  for (i = 0; i < w; i++) if (n & (1 << i)) no++;
-  cno = no;
-  for (i = 1; i < w; i++) {
-    if (n & highbit) {
-      n ^= highbit;
-      n <<= 1;
-      n ^= PPs[w];
-      cno--;
-      for (j = 0; j < NOs[w]; j++) {
-        cno += (n & ONEs[w][j]) ? 1 : -1;
-      }
-    } else {
-      n <<= 1;
-    } 
-    no += cno;
+  for (i = 0; i < w; i++) {
+    no += __builtin_popcount(n);
+    n = (n & highbit) ? ((n ^ highbit) << 1) ^ pp : n << 1;
   }
   return no;
 }
+
+static cauchy_tables *make_tables(int w)
+{
+  cauchy_tables *t;
+  unsigned int pp, highbit, e;
+  int i, n;
+
+  n = (1 << w) - 1;
+  pp = prim_poly(w);
+  highbit = 1U << (w-1);
+  t = talloc(cauchy_tables, 1);
+  if (t == NULL) return NULL;
+  t->ones = talloc(unsigned short, n+1);
+  t->log = talloc(unsigned short, n+1);
+  t->exp = talloc(unsigned short, 2*n);
+  if (t->ones == NULL || t->log == NULL || t->exp == NULL) {
+    free(t->ones); free(t->log); free(t->exp); free(t);
+    return NULL;
+  }
+  for (i = 0; i <= n; i++) t->ones[i] = count_ones(i, w, pp);
+
+  for (i = 0; i <= n; i++) t->log[i] = 0xffff;
+  e = 1;
+  for (i = 0; i < n && t->log[e] == 0xffff; i++) {
+    t->log[e] = i;
+    t->exp[i] = e;
+    t->exp[i+n] = e;
+    e = (e & highbit) ? ((e ^ highbit) << 1) ^ pp : e << 1;
+  }
+  if (i < n || e != 1) {
+    free(t->log);
+    free(t->exp);
+    t->log = NULL;
+    t->exp = NULL;
+  }
+  return t;
+}
+
+static cauchy_tables *get_tables(int w)
+{
+  cauchy_tables *t;
+
+  if (w < 2 || w > CAUCHY_TABLE_MAX_W) return NULL;
+  t = __atomic_load_n(&Tables[w], __ATOMIC_ACQUIRE);
+  if (t == NULL) {
+    pthread_mutex_lock(&Tables_lock);
+    if (Tables[w] == NULL) __atomic_store_n(&Tables[w], make_tables(w), __ATOMIC_RELEASE);
+    t = Tables[w];
+    pthread_mutex_unlock(&Tables_lock);
+  }
+  return t;
+}
+
+int cauchy_n_ones(int n, int w)
+{
+  cauchy_tables *t;
+
+  t = get_tables(w);
+  if (t != NULL && n >= 0 && n < (1 << w)) return t->ones[n];
+  return count_ones(n, w, prim_poly(w));
+}
   
 int *cauchy_original_coding_matrix(int k, int m, int w)
 {
@@ -163,11 +245,62 @@ int *cauchy_xy_coding_matrix(int k, int m, int w, int *X, int *Y)
   return matrix;
 }
 
+/* cauchy_improve_coding_matrix in the log domain.  Dividing a row by one
+   of its elements subtracts that element's log from every log in the
+   row, so each candidate costs k table lookups and no multiplications.
+   A candidate is dropped as soon as it is no better than the best so far.
+   Returns -1, without touching the matrix, if it holds a zero. */
+
+static int improve_with_logs(int k, int m, int w, int *matrix, cauchy_tables *t)
+{
+  int i, j, x, n, l, bno, tno, bno_index;
+  int *lg, *row;
+
+  n = (1 << w) - 1;
+  for (i = 0; i < k*m; i++) if (matrix[i] <= 0 || matrix[i] > n) return -1;
+  lg = talloc(int, k*m);
+  if (lg == NULL) return -1;
+  for (i = 0; i < k*m; i++) lg[i] = t->log[matrix[i]];
+
+  for (j = 0; j < k; j++) {
+    l = n - lg[j];
+    for (i = 0; i < m; i++) lg[i*k+j] = (lg[i*k+j] + l) % n;
+  }
+  for (i = 1; i < m; i++) {
+    row = lg + i*k;
+    bno = 0;
+    for (j = 0; j < k; j++) bno += t->ones[t->exp[row[j]]];
+    bno_index = -1;
+    for (j = 0; j < k; j++) {
+      if (row[j] != 0) {
+        l = n - row[j];
+        tno = 0;
+        for (x = 0; x < k && tno < bno; x++) tno += t->ones[t->exp[row[x]+l]];
+        if (tno < bno) {
+          bno = tno;
+          bno_index = j;
+        }
+      }
+    }
+    if (bno_index != -1) {
+      l = n - row[bno_index];
+      for (j = 0; j < k; j++) row[j] = (row[j] + l) % n;
+    }
+  }
+  for (i = 0; i < k*m; i++) matrix[i] = t->exp[lg[i]];
+  free(lg);
+  return 0;
+}
+
 void cauchy_improve_coding_matrix(int k, int m, int w, int *matrix)
 {
   int index, i, j, x;
   int tmp;
   int bno, tno, bno_index;
+  cauchy_tables *t;
+
+  t = get_tables(w);
+  if (t != NULL && t->log != NULL && improve_with_logs(k, m, w, matrix, t) == 0) return;
 
   for (j = 0; j < k; j++) {
     if (matrix[j] != 1) {
@@ -206,6 +339,185 @@ void cauchy_improve_coding_matrix(int k, int m, int w, int *matrix)
   }
 }
 
+/* Searching for X and Y.  Every thread hill-climbs from its own starting
+   sets.  Each step replaces one element of X or Y with an unused value,
+   or swaps an element of X with one of Y when every value is in use.  A
+   step is kept when the improved matrix has no more ones than before.
+   After a long run of steps without improvement, the thread restarts from
+   random sets.  Thread 0 starts from the sets of
+   cauchy_original_coding_matrix, so the result is never worse than that
+   matrix after cauchy_improve_coding_matrix. */
+
+typedef struct {
+  int k, m, w;
+  int iterations;
+  unsigned long long seed;
+  int original;        /* Start from the sets of cauchy_original_coding_matrix */
+  int *XY;             /* The best X, then Y */
+  int ones;
+} cauchy_search_job;
+
+static unsigned int search_rand(unsigned long long *s)
+{
+  *s = *s * 6364136223846793005ULL + 1442695040888963407ULL;
+  return (unsigned int) (*s >> 32);
+}
+
+static int search_value(unsigned long long *s, int w)
+{
+  return (w == 32) ? (int) search_rand(s) : (int) (search_rand(s) % (1U << w));
+}
+
+static int search_in_use(int *XY, int n, int v)
+{
+  int i;
+
+  for (i = 0; i < n; i++) if (XY[i] == v) return 1;
+  return 0;
+}
+
+static int search_ones(int k, int m, int w, int *XY, int *matrix)
+{
+  int i, j, no;
+
+  for (i = 0; i < m; i++) {
+    for (j = 0; j < k; j++) matrix[i*k+j] = galois_single_divide(1, XY[i] ^ XY[m+j], w);
+  }
+  cauchy_improve_coding_matrix(k, m, w, matrix);
+  no = 0;
+  for (i = 0; i < k*m; i++) no += cauchy_n_ones(matrix[i], w);
+  return no;
+}
+
+static void *search_thread(void *arg)
+{
+  cauchy_search_job *job;
+  int *XY, *matrix, n, full, i, j, v, nv, no, cur, stall, it;
+  unsigned long long s;
+
+  job = (cauchy_search_job *) arg;
+  n = job->m + job->k;
+  full = (job->w < 31 && n == (1 << job->w));
+  s = job->seed;
+  XY = talloc(int, n);
+  matrix = talloc(int, job->k*job->m);
+  if (XY == NULL || matrix == NULL) {
+    free(XY);
+    free(matrix);
+    return NULL;
+  }
+
+  cur = -1;
+  stall = 0;
+  for (it = 0; it < job->iterations; it++) {
+    if (cur == -1) {
+      for (i = 0; i < n; i++) {
+        if (it == 0 && job->original) {
+          XY[i] = i;
+        } else {
+          do v = search_value(&s, job->w); while (search_in_use(XY, i, v));
+          XY[i] = v;
+        }
+      }
+      cur = search_ones(job->k, job->m, job->w, XY, matrix);
+      stall = 0;
+    } else {
+      i = search_rand(&s) % n;
+      v = XY[i];
+      if (full) {
+        j = (i < job->m) ? job->m + search_rand(&s) % job->k : search_rand(&s) % job->m;
+        XY[i] = XY[j];
+        XY[j] = v;
+      } else {
+        j = -1;
+        do nv = search_value(&s, job->w); while (search_in_use(XY, n, nv));
+        XY[i] = nv;
+      }
+      no = search_ones(job->k, job->m, job->w, XY, matrix);
+      if (no <= cur) {
+        stall = (no < cur) ? 0 : stall+1;
+        cur = no;
+      } else {
+        if (j != -1) XY[j] = XY[i];
+        XY[i] = v;
+        stall++;
+      }
+    }
+    if (job->ones == -1 || cur < job->ones) {
+      job->ones = cur;
+      memcpy(job->XY, XY, sizeof(int)*n);
+    }
+    if (stall > 20*n) cur = -1;
+  }
+  free(XY);
+  free(matrix);
+  return NULL;
+}
+
+int cauchy_search_xy(int k, int m, int w, int iterations, int threads, unsigned int seed,
+                     int *X, int *Y)
+{
+  cauchy_search_job *jobs;
+  pthread_t *tids;
+  int i, best, created, rv;
+
+  if (k <= 0 || m <= 0 || w <= 0 || w > 32 || iterations <= 0 || threads <= 0) return -1;
+  if (w < 31 && (k+m) > (1 << w)) return -1;
+
+  jobs = talloc(cauchy_search_job, threads);
+  tids = talloc(pthread_t, threads);
+  if (jobs == NULL || tids == NULL) {
+    free(jobs);
+    free(tids);
+    return -1;
+  }
+  for (i = 0; i < threads; i++) {
+    jobs[i].k = k;
+    jobs[i].m = m;
+    jobs[i].w = w;
+    jobs[i].iterations = iterations / threads + (i < iterations % threads);
+    jobs[i].seed = (unsigned long long) seed * threads + i;
+    jobs[i].original = (i == 0);
+    jobs[i].XY = talloc(int, k+m);
+    jobs[i].ones = -1;
+  }
+
+  created = 0;
+  for (i = 1; i < threads; i++) {
+    if (jobs[i].XY == NULL || pthread_create(tids+i, NULL, search_thread, jobs+i) != 0) break;
+    created = i;
+  }
+  if (jobs[0].XY != NULL) search_thread(jobs);
+  for (i = 1; i <= created; i++) pthread_join(tids[i], NULL);
+
+  best = -1;
+  for (i = 0; i < threads; i++) {
+    if (jobs[i].ones != -1 && (best == -1 || jobs[i].ones < jobs[best].ones)) best = i;
+  }
+  rv = -1;
+  if (best != -1) {
+    memcpy(X, jobs[best].XY, sizeof(int)*m);
+    memcpy(Y, jobs[best].XY+m, sizeof(int)*k);
+    rv = jobs[best].ones;
+  }
+  for (i = 0; i < threads; i++) free(jobs[i].XY);
+  free(jobs);
+  free(tids);
+  return rv;
+}
+
+static void cbest_fill_all(void)
+{
+  cbest_all[0] = cbest_0; cbest_all[1] = cbest_1; cbest_all[2] = cbest_2; cbest_all[3] = cbest_3; cbest_all[4] =
+  cbest_4; cbest_all[5] = cbest_5; cbest_all[6] = cbest_6; cbest_all[7] = cbest_7; cbest_all[8] = cbest_8;
+  cbest_all[9] = cbest_9; cbest_all[10] = cbest_10; cbest_all[11] = cbest_11; cbest_all[12] = cbest_12;
+  cbest_all[13] = cbest_13; cbest_all[14] = cbest_14; cbest_all[15] = cbest_15; cbest_all[16] = cbest_16;
+  cbest_all[17] = cbest_17; cbest_all[18] = cbest_18; cbest_all[19] = cbest_19; cbest_all[20] = cbest_20;
+  cbest_all[21] = cbest_21; cbest_all[22] = cbest_22; cbest_all[23] = cbest_23; cbest_all[24] = cbest_24;
+  cbest_all[25] = cbest_25; cbest_all[26] = cbest_26; cbest_all[27] = cbest_27; cbest_all[28] = cbest_28;
+  cbest_all[29] = cbest_29; cbest_all[30] = cbest_30; cbest_all[31] = cbest_31; cbest_all[32] = (int *) cbest_32;
+}
+
 int *cauchy_good_general_coding_matrix(int k, int m, int w)
 {
   int *matrix, i;
@@ -213,17 +525,7 @@ int *cauchy_good_general_coding_matrix(int k, int m, int w)
   if (m == 2 && k <= cbest_max_k[w]) {
     matrix = talloc(int, k*m);
     if (matrix == NULL) return NULL;
-    if (!cbest_init) {
-      cbest_init = 1;
-      cbest_all[0] = cbest_0; cbest_all[1] = cbest_1; cbest_all[2] = cbest_2; cbest_all[3] = cbest_3; cbest_all[4] =
-      cbest_4; cbest_all[5] = cbest_5; cbest_all[6] = cbest_6; cbest_all[7] = cbest_7; cbest_all[8] = cbest_8;
-      cbest_all[9] = cbest_9; cbest_all[10] = cbest_10; cbest_all[11] = cbest_11; cbest_all[12] = cbest_12;
-      cbest_all[13] = cbest_13; cbest_all[14] = cbest_14; cbest_all[15] = cbest_15; cbest_all[16] = cbest_16;
-      cbest_all[17] = cbest_17; cbest_all[18] = cbest_18; cbest_all[19] = cbest_19; cbest_all[20] = cbest_20;
-      cbest_all[21] = cbest_21; cbest_all[22] = cbest_22; cbest_all[23] = cbest_23; cbest_all[24] = cbest_24;
-      cbest_all[25] = cbest_25; cbest_all[26] = cbest_26; cbest_all[27] = cbest_27; cbest_all[28] = cbest_28;
-      cbest_all[29] = cbest_29; cbest_all[30] = cbest_30; cbest_all[31] = cbest_31; cbest_all[32] = (int *) cbest_32;
-    }
+    pthread_once(&cbest_once, cbest_fill_all);
     for (i = 0; i < k; i++) {
       matrix[i] = 1;
       matrix[i+k] = cbest_all[w][i];
@@ -237,6 +539,22 @@ int *cauchy_good_general_coding_matrix(int k, int m, int w)
   }
 }
 
+int *cauchy_best_coding_matrix(int k, int m, int w)
+{
+  int *matrix, *xy;
+
+  xy = NULL;
+  if ((m == 3 || m == 4) && k > 0 && k <= CBEST_XY_MAX_K && w >= CBEST_XY_MIN_W && w <= CBEST_XY_MAX_W) {
+    xy = (m == 3) ? cbest_xy_3[w-CBEST_XY_MIN_W][k-1] : cbest_xy_4[w-CBEST_XY_MIN_W][k-1];
+    if (xy[0] == -1) xy = NULL;
+  }
+  if (xy == NULL) return cauchy_good_general_coding_matrix(k, m, w);
+  matrix = cauchy_xy_coding_matrix(k, m, w, xy, xy+m);
+  if (matrix == NULL) return NULL;
+  cauchy_improve_coding_matrix(k, m, w, matrix);
+  return matrix;
+}
+
 static int cbest_2[3] = { 1, 2, 3 };
 static int cbest_3[7] = { 1, 2, 5, 4, 7, 3, 6 };
 
@@ -403,3 +721,581 @@ static int cbest_11[1023] = { 1,
     805, 843, 873, 903, 930, 964, 1008, 1055, 1115, 1128, 1142, 1200, 1226, 1258, 1293, 1308, 1375, 1476, 1520, 1562,
     1574, 1680, 1824 };
 
+
+static int cbest_xy_3[CBEST_XY_MAX_W-CBEST_XY_MIN_W+1][CBEST_XY_MAX_K][3+CBEST_XY_MAX_K] = {
+  { /* w = 4 */
+    { 0, 1, 2, 3, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 }, /* k = 1: 12 ones, was 12 */
+    { 2, 0, 13, 5, 4, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 }, /* k = 2: 26 ones, was 35 */
+    { 9, 1, 2, 3, 4, 5, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 }, /* k = 3: 43 ones, was 50 */
+    { 0, 1, 2, 5, 4, 13, 12, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 }, /* k = 4: 61 ones, was 73 */
+    { 0, 10, 15, 14, 8, 9, 5, 7, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 }, /* k = 5: 80 ones, was 90 */
+    { 12, 1, 15, 3, 8, 5, 11, 6, 10, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 }, /* k = 6: 98 ones, was 109 */
+    { 0, 1, 15, 12, 4, 5, 8, 7, 13, 9, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 }, /* k = 7: 118 ones, was 130 */
+    { 6, 15, 2, 3, 9, 0, 5, 1, 7, 11, 4, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 }, /* k = 8: 138 ones, was 147 */
+    { 0, 1, 15, 4, 3, 9, 12, 7, 8, 14, 13, 5, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 }, /* k = 9: 161 ones, was 172 */
+    { 6, 13, 5, 8, 11, 14, 1, 7, 2, 10, 12, 0, 9, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 }, /* k = 10: 184 ones, was 193 */
+    { 0, 1, 15, 3, 4, 5, 6, 7, 8, 9, 10, 14, 12, 13, 0, 0, 0, 0, 0, 0, 0, 0, 0 }, /* k = 11: 209 ones, was 213 */
+    { 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 0, 0, 0, 0, 0, 0, 0, 0 }, /* k = 12: 234 ones, was 234 */
+    { 1, 4, 2, 3, 0, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 0, 0, 0, 0, 0, 0, 0 }, /* k = 13: 260 ones, was 263 */
+    { -1 }, /* k = 14 */
+    { -1 }, /* k = 15 */
+    { -1 }, /* k = 16 */
+    { -1 }, /* k = 17 */
+    { -1 }, /* k = 18 */
+    { -1 }, /* k = 19 */
+    { -1 } /* k = 20 */
+  },
+  { /* w = 5 */
+    { 0, 1, 2, 3, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 }, /* k = 1: 15 ones, was 15 */
+    { 6, 17, 3, 12, 22, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 }, /* k = 2: 32 ones, was 45 */
+    { 3, 6, 16, 26, 21, 10, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 }, /* k = 3: 52 ones, was 72 */
+    { 21, 29, 31, 13, 4, 5, 10, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 }, /* k = 4: 73 ones, was 96 */
+    { 20, 13, 2, 3, 26, 22, 25, 10, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 }, /* k = 5: 95 ones, was 133 */
+    { 0, 19, 2, 3, 26, 10, 6, 13, 15, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 }, /* k = 6: 118 ones, was 161 */
+    { 0, 8, 5, 13, 12, 18, 24, 31, 17, 7, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 }, /* k = 7: 141 ones, was 198 */
+    { 0, 11, 2, 28, 27, 26, 6, 22, 23, 4, 3, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 }, /* k = 8: 166 ones, was 222 */
+    { 15, 26, 27, 29, 6, 19, 5, 0, 4, 21, 14, 2, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 }, /* k = 9: 192 ones, was 251 */
+    { 22, 7, 2, 21, 19, 0, 12, 17, 13, 18, 30, 4, 3, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 }, /* k = 10: 220 ones, was 282 */
+    { 0, 8, 20, 1, 22, 23, 15, 18, 26, 13, 19, 11, 28, 10, 0, 0, 0, 0, 0, 0, 0, 0, 0 }, /* k = 11: 248 ones, was 313 */
+    { 25, 1, 17, 3, 4, 31, 20, 24, 15, 5, 8, 18, 19, 12, 23, 0, 0, 0, 0, 0, 0, 0, 0 }, /* k = 12: 276 ones, was 338 */
+    { 19, 31, 1, 28, 18, 27, 23, 6, 2, 13, 21, 12, 3, 16, 26, 9, 0, 0, 0, 0, 0, 0, 0 }, /* k = 13: 305 ones, was 372 */
+    { 28, 13, 19, 20, 17, 10, 27, 11, 14, 30, 15, 7, 6, 16, 18, 24, 21, 0, 0, 0, 0, 0, 0 }, /* k = 14: 337 ones, was 397 */
+    { 25, 6, 29, 24, 7, 0, 20, 17, 9, 31, 26, 12, 27, 14, 3, 23, 21, 1, 0, 0, 0, 0, 0 }, /* k = 15: 369 ones, was 431 */
+    { 29, 8, 30, 0, 18, 26, 20, 1, 21, 19, 9, 2, 3, 5, 12, 15, 14, 11, 31, 0, 0, 0, 0 }, /* k = 16: 402 ones, was 461 */
+    { 24, 2, 8, 10, 6, 15, 14, 16, 20, 30, 22, 0, 19, 9, 25, 29, 27, 3, 31, 11, 0, 0, 0 }, /* k = 17: 434 ones, was 487 */
+    { 0, 1, 24, 3, 4, 5, 11, 31, 12, 9, 21, 16, 17, 13, 14, 2, 25, 22, 18, 19, 20, 0, 0 }, /* k = 18: 467 ones, was 513 */
+    { 1, 19, 27, 28, 6, 16, 29, 22, 11, 10, 9, 4, 17, 18, 21, 7, 8, 26, 25, 31, 0, 12, 0 }, /* k = 19: 502 ones, was 540 */
+    { 2, 31, 0, 17, 11, 18, 10, 24, 19, 20, 5, 21, 15, 12, 1, 25, 30, 8, 27, 13, 4, 7, 9 } /* k = 20: 536 ones, was 579 */
+  },
+  { /* w = 6 */
+    { 0, 1, 2, 3, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 }, /* k = 1: 18 ones, was 18 */
+    { 42, 60, 2, 51, 4, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 }, /* k = 2: 38 ones, was 57 */
+    { 47, 38, 48, 36, 49, 45, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 }, /* k = 3: 65 ones, was 93 */
+    { 9, 14, 39, 16, 56, 2, 61, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 }, /* k = 4: 90 ones, was 134 */
+    { 16, 7, 60, 36, 21, 38, 0, 47, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 }, /* k = 5: 118 ones, was 179 */
+    { 18, 6, 12, 36, 53, 14, 0, 17, 9, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 }, /* k = 6: 148 ones, was 220 */
+    { 54, 44, 49, 14, 0, 31, 1, 20, 24, 59, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 }, /* k = 7: 180 ones, was 256 */
+    { 11, 53, 44, 12, 1, 24, 7, 28, 38, 37, 3, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 }, /* k = 8: 212 ones, was 300 */
+    { 5, 36, 23, 50, 48, 39, 58, 38, 47, 2, 22, 20, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 }, /* k = 9: 244 ones, was 337 */
+    { 4, 29, 47, 52, 56, 58, 5, 44, 51, 27, 49, 33, 14, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 }, /* k = 10: 276 ones, was 364 */
+    { 25, 48, 50, 31, 57, 12, 30, 37, 2, 32, 15, 52, 54, 63, 0, 0, 0, 0, 0, 0, 0, 0, 0 }, /* k = 11: 309 ones, was 414 */
+    { 0, 1, 43, 20, 30, 9, 54, 57, 21, 24, 25, 14, 31, 52, 53, 0, 0, 0, 0, 0, 0, 0, 0 }, /* k = 12: 343 ones, was 458 */
+    { 62, 61, 51, 38, 33, 31, 21, 46, 30, 53, 28, 22, 58, 39, 54, 2, 0, 0, 0, 0, 0, 0, 0 }, /* k = 13: 377 ones, was 502 */
+    { 36, 52, 8, 58, 54, 35, 51, 18, 11, 22, 0, 53, 33, 39, 13, 46, 31, 0, 0, 0, 0, 0, 0 }, /* k = 14: 411 ones, was 541 */
+    { 11, 33, 39, 41, 2, 45, 15, 35, 40, 46, 29, 1, 16, 18, 61, 10, 0, 14, 0, 0, 0, 0, 0 }, /* k = 15: 445 ones, was 571 */
+    { 58, 45, 13, 51, 31, 37, 8, 1, 21, 63, 5, 47, 3, 24, 11, 52, 62, 38, 34, 0, 0, 0, 0 }, /* k = 16: 480 ones, was 606 */
+    { 10, 56, 30, 36, 13, 28, 44, 60, 9, 38, 33, 11, 23, 53, 58, 17, 21, 27, 42, 4, 0, 0, 0 }, /* k = 17: 513 ones, was 651 */
+    { 36, 41, 7, 4, 57, 53, 12, 5, 25, 3, 37, 42, 52, 45, 48, 17, 59, 34, 2, 15, 47, 0, 0 }, /* k = 18: 550 ones, was 690 */
+    { 47, 19, 28, 50, 29, 51, 23, 11, 22, 12, 16, 63, 5, 14, 10, 39, 0, 34, 3, 41, 2, 1, 0 }, /* k = 19: 585 ones, was 742 */
+    { 40, 34, 22, 21, 1, 43, 51, 31, 9, 8, 38, 4, 20, 63, 50, 26, 56, 41, 37, 14, 30, 35, 19 } /* k = 20: 623 ones, was 783 */
+  },
+  { /* w = 7 */
+    { 0, 1, 2, 3, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 }, /* k = 1: 21 ones, was 21 */
+    { 79, 96, 60, 105, 26, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 }, /* k = 2: 44 ones, was 70 */
+    { 18, 44, 37, 26, 11, 93, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 }, /* k = 3: 76 ones, was 116 */
+    { 118, 25, 127, 67, 15, 21, 64, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 }, /* k = 4: 107 ones, was 153 */
+    { 75, 115, 37, 39, 108, 81, 1, 82, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 }, /* k = 5: 138 ones, was 213 */
+    { 85, 98, 116, 94, 125, 4, 79, 93, 26, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 }, /* k = 6: 169 ones, was 267 */
+    { 15, 19, 36, 58, 2, 125, 57, 123, 72, 1, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 }, /* k = 7: 205 ones, was 330 */
+    { 9, 120, 119, 65, 124, 22, 27, 26, 101, 118, 42, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 }, /* k = 8: 242 ones, was 382 */
+    { 113, 98, 92, 54, 114, 101, 57, 16, 127, 47, 17, 74, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 }, /* k = 9: 281 ones, was 443 */
+    { 42, 43, 4, 92, 59, 104, 34, 106, 103, 67, 37, 126, 62, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 }, /* k = 10: 315 ones, was 468 */
+    { 91, 81, 57, 108, 116, 40, 61, 121, 46, 117, 125, 52, 86, 28, 0, 0, 0, 0, 0, 0, 0, 0, 0 }, /* k = 11: 359 ones, was 520 */
+    { 35, 57, 49, 44, 79, 106, 124, 14, 47, 113, 18, 73, 64, 104, 61, 0, 0, 0, 0, 0, 0, 0, 0 }, /* k = 12: 406 ones, was 577 */
+    { 106, 69, 100, 36, 27, 22, 21, 111, 88, 87, 34, 119, 54, 58, 121, 127, 0, 0, 0, 0, 0, 0, 0 }, /* k = 13: 440 ones, was 619 */
+    { 13, 38, 3, 14, 37, 98, 54, 25, 30, 88, 39, 67, 28, 109, 107, 111, 53, 0, 0, 0, 0, 0, 0 }, /* k = 14: 481 ones, was 676 */
+    { 119, 71, 63, 3, 21, 70, 93, 46, 113, 126, 117, 31, 74, 85, 120, 89, 17, 0, 0, 0, 0, 0, 0 }, /* k = 15: 524 ones, was 733 */
+    { 52, 7, 105, 92, 23, 60, 85, 0, 5, 14, 75, 54, 25, 47, 88, 2, 32, 35, 96, 0, 0, 0, 0 }, /* k = 16: 572 ones, was 786 */
+    { 0, 20, 19, 108, 60, 21, 57, 116, 34, 51, 65, 84, 121, 93, 52, 87, 99, 107, 26, 25, 0, 0, 0 }, /* k = 17: 608 ones, was 825 */
+    { 4, 88, 33, 13, 65, 69, 124, 27, 109, 77, 39, 18, 62, 127, 54, 79, 46, 45, 85, 63, 5, 0, 0 }, /* k = 18: 657 ones, was 889 */
+    { 11, 82, 107, 116, 122, 53, 52, 29, 12, 16, 24, 113, 74, 35, 0, 89, 23, 79, 50, 106, 93, 25, 0 }, /* k = 19: 695 ones, was 952 */
+    { 102, 10, 59, 117, 41, 99, 124, 58, 3, 54, 52, 11, 116, 80, 94, 21, 18, 34, 108, 5, 72, 127, 76 } /* k = 20: 742 ones, was 1003 */
+  },
+  { /* w = 8 */
+    { 0, 1, 2, 3, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 }, /* k = 1: 24 ones, was 24 */
+    { 37, 58, 113, 125, 224, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 }, /* k = 2: 54 ones, was 83 */
+    { 148, 100, 180, 221, 223, 211, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 }, /* k = 3: 98 ones, was 149 */
+    { 46, 31, 51, 154, 168, 73, 59, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 }, /* k = 4: 137 ones, was 197 */
+    { 189, 62, 195, 167, 188, 6, 43, 235, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 }, /* k = 5: 192 ones, was 283 */
+    { 16, 38, 246, 179, 82, 143, 55, 204, 122, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 }, /* k = 6: 240 ones, was 362 */
+    { 56, 74, 157, 99, 93, 95, 72, 97, 102, 46, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 }, /* k = 7: 285 ones, was 422 */
+    { 211, 75, 122, 206, 10, 39, 83, 3, 169, 64, 239, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 }, /* k = 8: 330 ones, was 487 */
+    { 48, 150, 63, 17, 156, 215, 101, 25, 145, 75, 73, 127, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 }, /* k = 9: 394 ones, was 564 */
+    { 150, 185, 53, 32, 231, 223, 174, 107, 122, 21, 192, 237, 60, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 }, /* k = 10: 439 ones, was 617 */
+    { 106, 208, 211, 101, 88, 36, 130, 240, 0, 126, 233, 159, 68, 183, 0, 0, 0, 0, 0, 0, 0, 0, 0 }, /* k = 11: 479 ones, was 683 */
+    { 237, 119, 64, 137, 12, 104, 181, 2, 172, 229, 217, 158, 20, 250, 228, 0, 0, 0, 0, 0, 0, 0, 0 }, /* k = 12: 538 ones, was 765 */
+    { 212, 193, 169, 146, 117, 209, 149, 109, 166, 116, 60, 199, 131, 73, 210, 171, 0, 0, 0, 0, 0, 0, 0 }, /* k = 13: 582 ones, was 818 */
+    { 178, 143, 229, 113, 115, 135, 3, 244, 212, 125, 69, 106, 71, 172, 150, 117, 75, 0, 0, 0, 0, 0, 0 }, /* k = 14: 646 ones, was 900 */
+    { 99, 19, 240, 146, 100, 246, 169, 110, 104, 28, 65, 75, 234, 171, 136, 212, 116, 201, 0, 0, 0, 0, 0 }, /* k = 15: 695 ones, was 953 */
+    { 9, 176, 231, 84, 12, 205, 8, 254, 62, 24, 143, 92, 244, 59, 126, 104, 209, 155, 0, 0, 0, 0, 0 }, /* k = 16: 763 ones, was 1017 */
+    { 222, 114, 28, 10, 213, 87, 178, 243, 240, 5, 29, 64, 144, 79, 32, 255, 48, 216, 251, 76, 0, 0, 0 }, /* k = 17: 788 ones, was 1095 */
+    { 113, 207, 176, 25, 93, 210, 41, 204, 145, 129, 23, 243, 151, 154, 86, 70, 245, 16, 223, 143, 201, 0, 0 }, /* k = 18: 898 ones, was 1169 */
+    { 156, 179, 241, 63, 159, 102, 246, 182, 134, 14, 129, 111, 66, 12, 46, 207, 236, 51, 83, 202, 136, 205, 0 }, /* k = 19: 897 ones, was 1247 */
+    { 45, 9, 221, 51, 129, 167, 241, 88, 13, 216, 69, 219, 235, 68, 90, 97, 199, 189, 109, 71, 130, 203, 126 } /* k = 20: 981 ones, was 1315 */
+  },
+  { /* w = 9 */
+    { 0, 1, 2, 3, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 }, /* k = 1: 27 ones, was 27 */
+    { 137, 121, 299, 505, 452, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 }, /* k = 2: 57 ones, was 86 */
+    { 180, 369, 388, 110, 266, 425, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 }, /* k = 3: 97 ones, was 167 */
+    { 63, 393, 56, 98, 390, 11, 291, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 }, /* k = 4: 143 ones, was 234 */
+    { 452, 465, 146, 448, 54, 446, 250, 155, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 }, /* k = 5: 184 ones, was 323 */
+    { 505, 259, 374, 113, 292, 207, 233, 77, 213, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 }, /* k = 6: 251 ones, was 396 */
+    { 488, 506, 258, 331, 468, 196, 359, 387, 190, 43, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 }, /* k = 7: 280 ones, was 469 */
+    { 202, 369, 3, 347, 328, 182, 93, 335, 451, 194, 153, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 }, /* k = 8: 341 ones, was 540 */
+    { 27, 242, 412, 467, 284, 106, 398, 166, 384, 345, 173, 225, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 }, /* k = 9: 407 ones, was 625 */
+    { 199, 480, 321, 63, 233, 146, 106, 478, 336, 416, 389, 441, 172, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 }, /* k = 10: 432 ones, was 726 */
+    { 67, 68, 398, 242, 212, 158, 91, 70, 257, 313, 463, 481, 139, 339, 0, 0, 0, 0, 0, 0, 0, 0, 0 }, /* k = 11: 506 ones, was 817 */
+    { 510, 299, 295, 218, 219, 394, 163, 331, 44, 207, 237, 493, 33, 31, 396, 0, 0, 0, 0, 0, 0, 0, 0 }, /* k = 12: 579 ones, was 895 */
+    { 264, 28, 491, 484, 308, 324, 62, 199, 509, 223, 107, 255, 189, 322, 360, 73, 0, 0, 0, 0, 0, 0, 0 }, /* k = 13: 633 ones, was 961 */
+    { 186, 148, 303, 476, 507, 273, 340, 200, 386, 466, 258, 3, 419, 233, 389, 120, 100, 0, 0, 0, 0, 0, 0 }, /* k = 14: 676 ones, was 1054 */
+    { 140, 121, 225, 281, 467, 214, 35, 379, 454, 255, 64, 47, 236, 282, 168, 51, 494, 464, 0, 0, 0, 0, 0 }, /* k = 15: 741 ones, was 1141 */
+    { 414, 180, 403, 325, 437, 286, 480, 48, 388, 225, 417, 132, 427, 344, 158, 51, 55, 415, 334, 0, 0, 0, 0 }, /* k = 16: 780 ones, was 1225 */
+    { 140, 113, 214, 456, 26, 251, 27, 98, 404, 234, 250, 148, 190, 400, 67, 392, 38, 200, 130, 482, 0, 0, 0 }, /* k = 17: 862 ones, was 1296 */
+    { 49, 475, 243, 67, 168, 51, 456, 312, 73, 36, 507, 286, 398, 203, 142, 477, 200, 199, 230, 359, 503, 0, 0 }, /* k = 18: 910 ones, was 1401 */
+    { 295, 425, 435, 104, 476, 326, 94, 243, 207, 232, 463, 379, 169, 356, 477, 432, 218, 244, 423, 116, 10, 46, 0 }, /* k = 19: 978 ones, was 1522 */
+    { 320, 384, 435, 423, 226, 467, 298, 391, 338, 407, 342, 100, 129, 498, 122, 57, 225, 309, 104, 453, 192, 373, 418 } /* k = 20: 1025 ones, was 1583 */
+  },
+  { /* w = 10 */
+    { 0, 1, 2, 3, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 }, /* k = 1: 30 ones, was 30 */
+    { 714, 592, 571, 289, 39, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 }, /* k = 2: 62 ones, was 102 */
+    { 690, 541, 202, 363, 451, 328, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 }, /* k = 3: 110 ones, was 185 */
+    { 622, 583, 899, 509, 265, 450, 8, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 }, /* k = 4: 174 ones, was 259 */
+    { 190, 801, 777, 528, 757, 827, 234, 858, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 }, /* k = 5: 225 ones, was 364 */
+    { 75, 115, 952, 300, 214, 231, 934, 549, 901, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 }, /* k = 6: 283 ones, was 453 */
+    { 795, 512, 458, 670, 336, 424, 907, 696, 410, 170, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 }, /* k = 7: 364 ones, was 552 */
+    { 543, 411, 139, 187, 855, 944, 878, 136, 877, 661, 218, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 }, /* k = 8: 418 ones, was 635 */
+    { 178, 72, 79, 985, 132, 345, 135, 5, 213, 554, 155, 604, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 }, /* k = 9: 445 ones, was 738 */
+    { 522, 687, 387, 0, 677, 712, 926, 916, 227, 854, 143, 961, 455, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 }, /* k = 10: 561 ones, was 827 */
+    { 67, 488, 553, 784, 218, 145, 8, 812, 88, 994, 333, 814, 107, 369, 0, 0, 0, 0, 0, 0, 0, 0, 0 }, /* k = 11: 614 ones, was 955 */
+    { 656, 403, 107, 137, 75, 661, 232, 306, 445, 953, 400, 571, 364, 547, 955, 0, 0, 0, 0, 0, 0, 0, 0 }, /* k = 12: 612 ones, was 1075 */
+    { 537, 769, 65, 783, 639, 762, 356, 36, 468, 140, 62, 704, 126, 844, 169, 608, 0, 0, 0, 0, 0, 0, 0 }, /* k = 13: 741 ones, was 1195 */
+    { 95, 512, 961, 511, 328, 448, 341, 32, 855, 480, 661, 786, 864, 537, 602, 323, 946, 0, 0, 0, 0, 0, 0 }, /* k = 14: 795 ones, was 1284 */
+    { 385, 828, 517, 816, 63, 687, 24, 987, 504, 133, 589, 999, 692, 244, 130, 153, 801, 618, 0, 0, 0, 0, 0 }, /* k = 15: 852 ones, was 1394 */
+    { 647, 965, 601, 867, 923, 334, 520, 86, 892, 903, 960, 295, 872, 137, 365, 77, 547, 591, 33, 0, 0, 0, 0 }, /* k = 16: 916 ones, was 1492 */
+    { 0, 1, 2, 1016, 428, 461, 268, 686, 613, 21, 128, 736, 716, 258, 1017, 4, 16, 130, 542, 841, 0, 0, 0 }, /* k = 17: 960 ones, was 1583 */
+    { 484, 1, 2, 594, 432, 453, 531, 7, 600, 860, 1009, 11, 93, 996, 153, 111, 353, 377, 913, 867, 905, 0, 0 }, /* k = 18: 1075 ones, was 1689 */
+    { 909, 359, 645, 373, 867, 519, 690, 859, 143, 268, 658, 438, 260, 534, 544, 163, 474, 624, 725, 813, 606, 22, 0 }, /* k = 19: 1139 ones, was 1821 */
+    { 786, 967, 730, 801, 240, 367, 564, 440, 719, 382, 765, 736, 217, 431, 213, 513, 602, 321, 783, 285, 214, 377, 853 } /* k = 20: 1217 ones, was 1901 */
+  },
+  { /* w = 11 */
+    { 0, 1, 2, 3, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 }, /* k = 1: 33 ones, was 33 */
+    { 1671, 956, 1425, 1070, 1574, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 }, /* k = 2: 69 ones, was 105 */
+    { 1986, 667, 1024, 628, 626, 1228, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 }, /* k = 3: 128 ones, was 230 */
+    { 394, 1962, 1978, 561, 2012, 375, 1221, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 }, /* k = 4: 208 ones, was 330 */
+    { 84, 1498, 331, 397, 1985, 158, 19, 1624, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 }, /* k = 5: 260 ones, was 463 */
+    { 1021, 1537, 1610, 1963, 1463, 361, 335, 167, 2034, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 }, /* k = 6: 348 ones, was 491 */
+    { 0, 1, 2, 490, 731, 934, 1157, 810, 8, 683, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 }, /* k = 7: 429 ones, was 597 */
+    { 1263, 1746, 1425, 900, 1785, 1876, 171, 49, 801, 1213, 1950, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 }, /* k = 8: 460 ones, was 697 */
+    { 762, 115, 403, 56, 86, 234, 573, 288, 2028, 1872, 1324, 1442, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 }, /* k = 9: 599 ones, was 859 */
+    { 1092, 1279, 1374, 439, 209, 1359, 299, 252, 975, 908, 1015, 201, 279, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 }, /* k = 10: 685 ones, was 997 */
+    { 1638, 1701, 525, 1165, 188, 175, 670, 922, 1326, 885, 628, 1218, 1332, 745, 0, 0, 0, 0, 0, 0, 0, 0, 0 }, /* k = 11: 725 ones, was 1124 */
+    { 921, 1441, 1152, 1168, 236, 133, 967, 1741, 1030, 806, 1381, 514, 1430, 745, 1063, 0, 0, 0, 0, 0, 0, 0, 0 }, /* k = 12: 846 ones, was 1258 */
+    { 1261, 1675, 274, 1302, 546, 418, 795, 1682, 1563, 902, 434, 921, 1161, 973, 1185, 799, 0, 0, 0, 0, 0, 0, 0 }, /* k = 13: 879 ones, was 1366 */
+    { 0, 1, 2, 2044, 4, 1715, 2045, 1504, 631, 69, 308, 11, 271, 879, 522, 1806, 16, 0, 0, 0, 0, 0, 0 }, /* k = 14: 947 ones, was 1428 */
+    { 2040, 1364, 1665, 1927, 1154, 981, 1020, 692, 2032, 938, 1483, 116, 695, 1775, 530, 444, 1991, 731, 0, 0, 0, 0, 0 }, /* k = 15: 1043 ones, was 1545 */
+    { 402, 1000, 707, 1346, 1004, 1500, 1087, 753, 1592, 223, 892, 1586, 759, 1372, 1558, 365, 1663, 460, 621, 0, 0, 0, 0 }, /* k = 16: 1147 ones, was 1654 */
+    { 854, 175, 1039, 460, 1148, 1361, 1252, 642, 1079, 1568, 1011, 1052, 61, 1907, 975, 449, 1824, 1432, 551, 1391, 0, 0, 0 }, /* k = 17: 1227 ones, was 1788 */
+    { 1032, 1819, 925, 1978, 472, 1085, 1923, 70, 725, 130, 1446, 1624, 1823, 875, 1339, 1487, 1412, 633, 695, 310, 918, 0, 0 }, /* k = 18: 1320 ones, was 1954 */
+    { 691, 899, 518, 229, 795, 457, 1154, 1446, 1966, 1160, 973, 411, 1199, 721, 1432, 462, 489, 1659, 1092, 1290, 1483, 1321, 0 }, /* k = 19: 1335 ones, was 2044 */
+    { 390, 1938, 1726, 229, 1759, 1305, 1595, 1682, 719, 848, 208, 2021, 946, 1910, 1404, 1395, 1015, 1521, 1058, 68, 1566, 649, 1567 } /* k = 20: 1436 ones, was 2215 */
+  },
+  { /* w = 12 */
+    { 0, 1, 2, 3, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 }, /* k = 1: 36 ones, was 36 */
+    { 3137, 284, 2099, 2703, 2938, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 }, /* k = 2: 84 ones, was 128 */
+    { 39, 346, 2750, 3941, 759, 2059, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 }, /* k = 3: 157 ones, was 251 */
+    { 454, 780, 2869, 1873, 3554, 786, 3339, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 }, /* k = 4: 283 ones, was 359 */
+    { 1919, 366, 3125, 1164, 2218, 3556, 2626, 1247, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 }, /* k = 5: 375 ones, was 502 */
+    { 2247, 39, 1175, 506, 129, 41, 4034, 571, 3503, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 }, /* k = 6: 462 ones, was 611 */
+    { 0, 1, 2, 3, 4022, 2091, 6, 1349, 3688, 2534, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 }, /* k = 7: 595 ones, was 757 */
+    { 1151, 2952, 2986, 3244, 453, 288, 2820, 938, 1638, 174, 411, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 }, /* k = 8: 716 ones, was 890 */
+    { 3985, 2246, 2788, 973, 3627, 409, 847, 2201, 2701, 718, 2360, 3762, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 }, /* k = 9: 791 ones, was 1038 */
+    { 1652, 2279, 507, 1052, 2457, 517, 1280, 1115, 2811, 3828, 3038, 3713, 1473, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 }, /* k = 10: 920 ones, was 1212 */
+    { 0, 1, 2, 3, 4, 1735, 1733, 2570, 670, 2164, 1122, 2037, 1876, 3376, 0, 0, 0, 0, 0, 0, 0, 0, 0 }, /* k = 11: 980 ones, was 1365 */
+    { 0, 1, 2, 3, 4, 3213, 2891, 1733, 2269, 3724, 1103, 1912, 1854, 1876, 2089, 0, 0, 0, 0, 0, 0, 0, 0 }, /* k = 12: 1041 ones, was 1502 */
+    { 2722, 1722, 355, 2684, 802, 2318, 1110, 3870, 1255, 3821, 2590, 225, 3916, 3563, 429, 595, 0, 0, 0, 0, 0, 0, 0 }, /* k = 13: 1221 ones, was 1656 */
+    { 1028, 1343, 2366, 142, 2796, 2850, 1673, 248, 1825, 1326, 3334, 3344, 2619, 1151, 31, 40, 1653, 0, 0, 0, 0, 0, 0 }, /* k = 14: 1366 ones, was 1728 */
+    { 4018, 2061, 650, 2475, 3094, 3304, 1759, 3318, 1088, 3884, 4063, 1144, 3050, 3974, 130, 1655, 151, 3573, 0, 0, 0, 0, 0 }, /* k = 15: 1394 ones, was 1879 */
+    { 0, 1, 2, 3067, 4, 1761, 800, 2698, 3468, 1733, 3835, 402, 831, 4047, 3133, 1876, 16, 1409, 2801, 0, 0, 0, 0 }, /* k = 16: 1482 ones, was 2021 */
+    { 0, 1, 2, 3133, 4, 75, 2801, 2570, 1876, 2182, 831, 3067, 1733, 863, 14, 1443, 16, 3720, 3690, 2893, 0, 0, 0 }, /* k = 17: 1613 ones, was 2163 */
+    { 2532, 1, 2, 2296, 2373, 2398, 3669, 3806, 2607, 2733, 1671, 11, 12, 25, 643, 1783, 2724, 3370, 2738, 19, 821, 0, 0 }, /* k = 18: 1741 ones, was 2327 */
+    { 0, 1, 2, 3067, 4, 5, 1824, 697, 1733, 4008, 1876, 3636, 12, 2570, 3601, 3663, 16, 2664, 831, 143, 751, 3133, 0 }, /* k = 19: 1801 ones, was 2489 */
+    { 3778, 3900, 2313, 3680, 1572, 787, 2649, 1556, 1619, 3615, 1737, 2668, 507, 4057, 3185, 3775, 1402, 456, 1175, 593, 1493, 3796, 893 } /* k = 20: 1943 ones, was 2678 */
+  },
+  { /* w = 13 */
+    { 0, 1, 2, 3, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 }, /* k = 1: 39 ones, was 39 */
+    { 4011, 6468, 629, 5618, 1168, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 }, /* k = 2: 99 ones, was 136 */
+    { 4208, 1887, 7335, 7924, 447, 3535, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 }, /* k = 3: 220 ones, was 272 */
+    { 7619, 4363, 4700, 3128, 3564, 5920, 6542, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 }, /* k = 4: 319 ones, was 402 */
+    { 0, 1, 2, 3, 4, 7840, 2733, 2852, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 }, /* k = 5: 468 ones, was 551 */
+    { 0, 3240, 5554, 6316, 2957, 8076, 547, 224, 591, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 }, /* k = 6: 548 ones, was 640 */
+    { 7887, 7294, 1985, 2248, 1457, 7911, 7435, 5589, 4317, 367, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 }, /* k = 7: 669 ones, was 791 */
+    { 0, 1, 2, 2733, 4, 4582, 3863, 26, 8, 5280, 5846, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 }, /* k = 8: 784 ones, was 942 */
+    { 0, 1, 2, 3, 4, 4582, 2733, 3932, 8, 26, 1095, 7573, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 }, /* k = 9: 864 ones, was 1105 */
+    { 7148, 2254, 4427, 5629, 8126, 5290, 5829, 2232, 124, 3803, 4621, 4114, 5213, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 }, /* k = 10: 1024 ones, was 1288 */
+    { 2612, 7066, 7677, 3016, 7906, 6050, 7151, 7756, 1416, 3142, 3414, 7367, 5696, 3692, 0, 0, 0, 0, 0, 0, 0, 0, 0 }, /* k = 11: 1123 ones, was 1421 */
+    { 0, 1, 2, 6818, 4, 3627, 6, 6440, 8, 2733, 880, 4582, 2873, 7115, 14, 0, 0, 0, 0, 0, 0, 0, 0 }, /* k = 12: 1284 ones, was 1612 */
+    { 3711, 7306, 4981, 6656, 4072, 5194, 5543, 2238, 1004, 1413, 7395, 1072, 6543, 3464, 5152, 2056, 0, 0, 0, 0, 0, 0, 0 }, /* k = 13: 1376 ones, was 1792 */
+    { 0, 1, 2, 3, 4, 8182, 3588, 7533, 7472, 1243, 4486, 11, 5922, 5284, 14, 7237, 16, 0, 0, 0, 0, 0, 0 }, /* k = 14: 1428 ones, was 1905 */
+    { 7179, 1, 2, 3, 2734, 5, 3588, 5922, 766, 6781, 4056, 3935, 1092, 4798, 14, 1130, 7612, 3567, 0, 0, 0, 0, 0 }, /* k = 15: 1633 ones, was 2070 */
+    { 6756, 3, 7920, 5522, 320, 2199, 6076, 794, 6818, 1266, 5643, 5213, 2624, 6595, 5098, 1061, 4778, 2589, 35, 0, 0, 0, 0 }, /* k = 16: 1696 ones, was 2216 */
+    { 5019, 1624, 622, 2116, 3633, 2975, 3612, 3716, 6117, 3993, 5401, 4375, 4570, 7004, 6768, 4242, 2592, 6860, 2812, 7636, 0, 0, 0 }, /* k = 17: 1921 ones, was 2410 */
+    { 0, 1, 2, 3, 2783, 5847, 6, 7, 8, 2733, 5920, 7404, 7794, 7472, 14, 15, 6420, 1687, 7376, 2419, 3444, 0, 0 }, /* k = 18: 2024 ones, was 2610 */
+    { 0, 1, 2, 3, 4, 5466, 7719, 8086, 1306, 7967, 69, 11, 3588, 5845, 14, 7252, 16, 5034, 2263, 7572, 6861, 6613, 0 }, /* k = 19: 2019 ones, was 2761 */
+    { 7858, 1969, 201, 85, 5523, 6723, 1537, 4528, 5000, 4032, 2533, 4135, 6728, 4769, 4004, 6618, 1404, 1162, 6314, 7419, 7273, 4695, 4126 } /* k = 20: 2228 ones, was 2952 */
+  },
+  { /* w = 14 */
+    { 0, 1, 2, 3, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 }, /* k = 1: 42 ones, was 42 */
+    { 0, 1, 2, 12097, 4, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 }, /* k = 2: 93 ones, was 150 */
+    { 938, 6094, 7236, 1204, 4496, 12746, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 }, /* k = 3: 241 ones, was 327 */
+    { 0, 4749, 2, 3, 4, 15304, 6, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 }, /* k = 4: 397 ones, was 423 */
+    { 7984, 12561, 3311, 12363, 4375, 3940, 15053, 10779, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 }, /* k = 5: 485 ones, was 643 */
+    { 9541, 16175, 4756, 10137, 10522, 9723, 15369, 6964, 13737, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 }, /* k = 6: 630 ones, was 758 */
+    { 14399, 5964, 7525, 13326, 10803, 6264, 15167, 6618, 8883, 3079, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 }, /* k = 7: 844 ones, was 957 */
+    { 13466, 11756, 7082, 13480, 5185, 13654, 2052, 14967, 14848, 2209, 13344, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 }, /* k = 8: 990 ones, was 1145 */
+    { 7644, 11536, 9905, 7165, 9136, 1548, 2017, 2981, 10872, 135, 8180, 8880, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 }, /* k = 9: 1165 ones, was 1366 */
+    { 3635, 570, 15189, 2530, 14252, 15967, 14643, 11952, 6953, 2868, 11557, 5591, 8223, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 }, /* k = 10: 1184 ones, was 1525 */
+    { 8131, 15138, 6312, 15362, 15212, 13896, 10518, 13808, 11220, 1363, 74, 12506, 1764, 15540, 0, 0, 0, 0, 0, 0, 0, 0, 0 }, /* k = 11: 1414 ones, was 1690 */
+    { 0, 1, 2, 3, 4, 4507, 16349, 7, 8, 5600, 317, 15023, 5933, 12097, 4192, 0, 0, 0, 0, 0, 0, 0, 0 }, /* k = 12: 1509 ones, was 1928 */
+    { 7429, 12627, 440, 2913, 4608, 8333, 7644, 475, 15263, 1798, 13397, 553, 8620, 10722, 5234, 11458, 0, 0, 0, 0, 0, 0, 0 }, /* k = 13: 1671 ones, was 2111 */
+    { 5229, 12004, 14397, 10702, 5356, 4263, 16180, 5521, 288, 314, 14324, 56, 5977, 2626, 11522, 11219, 15981, 0, 0, 0, 0, 0, 0 }, /* k = 14: 1807 ones, was 2201 */
+    { 0, 1, 2, 3, 4, 5, 11882, 12097, 12870, 937, 8743, 11, 9502, 15990, 14, 4211, 16, 4630, 0, 0, 0, 0, 0 }, /* k = 15: 1915 ones, was 2385 */
+    { 14940, 3716, 8416, 12515, 4163, 12496, 4845, 13618, 7713, 3325, 6159, 314, 11364, 9180, 5776, 3253, 9372, 11144, 11261, 0, 0, 0, 0 }, /* k = 16: 2115 ones, was 2551 */
+    { 16088, 15429, 812, 2892, 10786, 4064, 9909, 7233, 1224, 1471, 7959, 7349, 12026, 1177, 9021, 15610, 15155, 12564, 3750, 4426, 0, 0, 0 }, /* k = 17: 2270 ones, was 2692 */
+    { 6689, 2580, 6241, 4414, 10419, 2029, 6829, 7727, 3366, 16300, 15534, 13501, 777, 14485, 9184, 2715, 4882, 3845, 2916, 12264, 5736, 0, 0 }, /* k = 18: 2453 ones, was 2931 */
+    { 0, 1, 2, 13698, 4, 5, 5678, 15068, 38, 5581, 15290, 11, 7529, 4596, 14, 12097, 16, 5471, 12830, 10308, 2751, 14827, 0 }, /* k = 19: 2452 ones, was 3135 */
+    { 0, 1, 2, 9502, 4, 5, 752, 10308, 12097, 8743, 15990, 14827, 8175, 9346, 14, 11612, 16, 8528, 8738, 14933, 14639, 12901, 12650 } /* k = 20: 2632 ones, was 3369 */
+  },
+  { /* w = 15 */
+    { 0, 1, 2, 3, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 }, /* k = 1: 45 ones, was 45 */
+    { 18082, 11015, 29487, 14864, 1973, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 }, /* k = 2: 112 ones, was 148 */
+    { 20111, 17446, 23236, 2620, 22244, 2612, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 }, /* k = 3: 264 ones, was 368 */
+    { 2507, 14374, 26608, 10346, 20881, 8872, 16343, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 }, /* k = 4: 399 ones, was 521 */
+    { 7510, 8202, 26168, 8028, 19737, 10495, 3177, 400, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 }, /* k = 5: 520 ones, was 760 */
+    { 31709, 8329, 2957, 29241, 546, 13005, 15429, 16690, 12316, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 }, /* k = 6: 686 ones, was 749 */
+    { 0, 1, 2, 3, 15008, 8930, 6, 7, 8, 8880, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 }, /* k = 7: 852 ones, was 928 */
+    { 18473, 1438, 16854, 1575, 15649, 21041, 19917, 4242, 2822, 23188, 20880, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 }, /* k = 8: 943 ones, was 1096 */
+    { 24949, 9916, 3732, 26101, 2558, 22125, 14239, 22960, 5260, 10367, 29156, 29831, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 }, /* k = 9: 1132 ones, was 1405 */
+    { 19642, 30864, 12932, 5763, 14501, 25606, 21904, 26343, 4861, 26706, 28119, 26413, 10366, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 }, /* k = 10: 1316 ones, was 1690 */
+    { 18482, 21747, 24778, 5920, 23084, 28468, 5244, 3636, 20971, 29285, 29822, 13025, 29382, 10217, 0, 0, 0, 0, 0, 0, 0, 0, 0 }, /* k = 11: 1431 ones, was 1887 */
+    { 10193, 32635, 17177, 7023, 28445, 19550, 3016, 16766, 2038, 8888, 1302, 11649, 15166, 27635, 15691, 0, 0, 0, 0, 0, 0, 0, 0 }, /* k = 12: 1615 ones, was 2091 */
+    { 11468, 12911, 20761, 13185, 11485, 611, 3357, 13049, 7536, 28870, 30291, 6255, 15457, 18714, 28533, 22853, 0, 0, 0, 0, 0, 0, 0 }, /* k = 13: 1749 ones, was 2271 */
+    { 0, 1, 2, 3, 4, 5, 28614, 22409, 4814, 12165, 6288, 11, 13518, 30842, 14, 16154, 16, 0, 0, 0, 0, 0, 0 }, /* k = 14: 1887 ones, was 2332 */
+    { 31544, 1422, 1591, 30507, 26171, 3745, 2812, 11015, 2199, 28146, 16681, 27752, 21379, 11860, 26487, 15308, 16610, 29170, 0, 0, 0, 0, 0 }, /* k = 15: 1990 ones, was 2549 */
+    { 0, 1, 2, 3, 4, 5, 15690, 27427, 13845, 31515, 13518, 11, 12, 20288, 14, 6361, 16, 22409, 23407, 0, 0, 0, 0 }, /* k = 16: 2096 ones, was 2738 */
+    { 27614, 12157, 15801, 15506, 3206, 25826, 18588, 23141, 31051, 5962, 12875, 29598, 7654, 4253, 27146, 9994, 4564, 7658, 6337, 24263, 0, 0, 0 }, /* k = 17: 2317 ones, was 2921 */
+    { 1087, 7674, 5512, 14251, 20880, 14862, 10082, 2010, 18043, 7696, 24119, 7488, 25595, 32140, 14943, 11816, 31571, 1901, 6848, 10616, 1969, 0, 0 }, /* k = 18: 2432 ones, was 3218 */
+    { 0, 1, 2, 3, 4, 5, 21358, 17840, 31085, 16912, 11719, 11, 23407, 20552, 14, 4120, 16, 25697, 1950, 1057, 15400, 11471, 0 }, /* k = 19: 2594 ones, was 3448 */
+    { 15212, 2133, 1271, 21928, 28657, 3357, 3673, 24907, 2793, 16666, 8358, 21025, 31294, 13694, 15376, 3527, 5522, 31898, 4051, 4687, 20466, 13891, 31550 } /* k = 20: 2757 ones, was 3729 */
+  },
+  { /* w = 16 */
+    { 0, 1, 2, 3, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 }, /* k = 1: 48 ones, was 48 */
+    { 33512, 27778, 58449, 8894, 58035, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 }, /* k = 2: 151 ones, was 166 */
+    { 57256, 61796, 50299, 53529, 56012, 37451, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 }, /* k = 3: 337 ones, was 404 */
+    { 57863, 4798, 45742, 9619, 53637, 21625, 7343, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 }, /* k = 4: 502 ones, was 544 */
+    { 17015, 53092, 48426, 63959, 21234, 32074, 2903, 64528, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 }, /* k = 5: 517 ones, was 798 */
+    { 0, 1, 2, 3, 4, 31688, 6, 7, 8, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 }, /* k = 6: 830 ones, was 865 */
+    { 0, 1, 2, 3, 4, 9792, 6, 7, 8, 9, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 }, /* k = 7: 1058 ones, was 1067 */
+    { 0, 1, 2, 3, 4, 56210, 6, 7, 8, 9, 10, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 }, /* k = 8: 1233 ones, was 1251 */
+    { 0, 1, 2, 3, 4, 42633, 6, 7, 8, 9, 10, 46546, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 }, /* k = 9: 1420 ones, was 1536 */
+    { 0, 1, 2, 3, 37451, 5, 6, 7, 8, 13, 10, 21516, 12, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 }, /* k = 10: 1593 ones, was 1740 */
+    { 0, 1, 2, 3, 60345, 5, 6, 7, 8, 21516, 10, 45945, 12, 13, 0, 0, 0, 0, 0, 0, 0, 0, 0 }, /* k = 11: 1741 ones, was 1909 */
+    { 0, 1, 2, 3, 31849, 5, 6, 7, 8, 9, 10, 45945, 12, 13, 14, 0, 0, 0, 0, 0, 0, 0, 0 }, /* k = 12: 1996 ones, was 2123 */
+    { 0, 1, 2, 3, 6873, 5, 6, 7, 8, 9, 10, 37141, 12, 13, 14, 15, 0, 0, 0, 0, 0, 0, 0 }, /* k = 13: 2223 ones, was 2322 */
+    { 11445, 1, 2, 3, 4, 5, 6, 51651, 8, 60967, 1983, 11, 12, 13, 14, 15, 16, 0, 0, 0, 0, 0, 0 }, /* k = 14: 2310 ones, was 2514 */
+    { 61962, 60897, 38347, 62560, 26919, 44748, 45111, 37255, 55355, 58861, 42386, 61328, 48907, 8905, 9117, 20684, 64510, 27507, 0, 0, 0, 0, 0 }, /* k = 15: 2632 ones, was 2755 */
+    { 0, 1, 2, 3, 21516, 5, 6, 60007, 8, 39100, 10, 60345, 12, 13, 14, 15, 49918, 55604, 18, 0, 0, 0, 0 }, /* k = 16: 2721 ones, was 2936 */
+    { 40131, 12645, 59682, 14880, 7535, 61513, 19099, 45986, 53861, 2271, 43730, 21047, 35863, 8072, 41850, 51520, 39750, 41486, 57030, 50544, 0, 0, 0 }, /* k = 17: 2916 ones, was 3090 */
+    { 0, 1, 2, 3, 60345, 5, 6, 51452, 8, 27501, 10, 34819, 12, 13, 14, 2617, 16, 18725, 18, 19, 18862, 0, 0 }, /* k = 18: 3219 ones, was 3398 */
+    { 46037, 19963, 16703, 51001, 3090, 55658, 15132, 30721, 63811, 63708, 64205, 46624, 24237, 38145, 25968, 16151, 43359, 12645, 39289, 59065, 7071, 39656, 0 }, /* k = 19: 3437 ones, was 3684 */
+    { 11445, 1, 2, 3, 4, 27501, 6, 42772, 8, 15642, 47786, 11, 12, 13, 14, 29801, 16, 9776, 35884, 45794, 36, 14379, 59924 } /* k = 20: 3386 ones, was 3974 */
+  },
+};
+
+static int cbest_xy_4[CBEST_XY_MAX_W-CBEST_XY_MIN_W+1][CBEST_XY_MAX_K][4+CBEST_XY_MAX_K] = {
+  { /* w = 4 */
+    { 0, 1, 2, 3, 4, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 }, /* k = 1: 16 ones, was 16 */
+    { 0, 6, 1, 3, 13, 5, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 }, /* k = 2: 36 ones, was 41 */
+    { 3, 0, 13, 15, 6, 8, 12, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 }, /* k = 3: 60 ones, was 74 */
+    { 12, 14, 0, 4, 15, 8, 3, 9, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 }, /* k = 4: 85 ones, was 98 */
+    { 14, 15, 2, 10, 13, 7, 4, 5, 12, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 }, /* k = 5: 112 ones, was 127 */
+    { 0, 1, 10, 3, 12, 5, 2, 7, 13, 9, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 }, /* k = 6: 141 ones, was 157 */
+    { 6, 1, 3, 4, 10, 8, 15, 14, 2, 13, 12, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 }, /* k = 7: 169 ones, was 187 */
+    { 0, 1, 15, 3, 13, 5, 9, 7, 8, 4, 11, 6, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 }, /* k = 8: 198 ones, was 213 */
+    { 0, 1, 2, 3, 4, 5, 13, 7, 8, 9, 15, 11, 12, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 }, /* k = 9: 230 ones, was 239 */
+    { 11, 13, 14, 1, 5, 15, 0, 12, 6, 3, 9, 4, 7, 8, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 }, /* k = 10: 261 ones, was 268 */
+    { 0, 6, 2, 3, 4, 5, 10, 7, 8, 9, 13, 11, 1, 15, 12, 0, 0, 0, 0, 0, 0, 0, 0, 0 }, /* k = 11: 293 ones, was 303 */
+    { 0, 1, 8, 3, 4, 5, 6, 7, 2, 9, 10, 11, 12, 13, 14, 15, 0, 0, 0, 0, 0, 0, 0, 0 }, /* k = 12: 327 ones, was 334 */
+    { -1 }, /* k = 13 */
+    { -1 }, /* k = 14 */
+    { -1 }, /* k = 15 */
+    { -1 }, /* k = 16 */
+    { -1 }, /* k = 17 */
+    { -1 }, /* k = 18 */
+    { -1 }, /* k = 19 */
+    { -1 } /* k = 20 */
+  },
+  { /* w = 5 */
+    { 0, 1, 2, 3, 4, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 }, /* k = 1: 20 ones, was 20 */
+    { 24, 0, 26, 21, 19, 5, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 }, /* k = 2: 44 ones, was 64 */
+    { 18, 1, 25, 2, 20, 28, 13, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 }, /* k = 3: 72 ones, was 100 */
+    { 15, 21, 11, 4, 8, 0, 31, 14, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 }, /* k = 4: 103 ones, was 151 */
+    { 18, 0, 30, 6, 13, 12, 7, 17, 20, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 }, /* k = 5: 135 ones, was 184 */
+    { 17, 1, 13, 22, 5, 7, 24, 18, 23, 30, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 }, /* k = 6: 169 ones, was 228 */
+    { 0, 1, 24, 21, 25, 5, 6, 17, 8, 2, 27, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 }, /* k = 7: 205 ones, was 265 */
+    { 19, 2, 27, 5, 22, 13, 30, 7, 28, 14, 29, 17, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 }, /* k = 8: 241 ones, was 299 */
+    { 0, 1, 17, 3, 4, 28, 16, 29, 18, 9, 24, 8, 23, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 }, /* k = 9: 278 ones, was 344 */
+    { 28, 15, 2, 26, 24, 13, 27, 31, 16, 25, 11, 17, 30, 23, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 }, /* k = 10: 316 ones, was 388 */
+    { 8, 21, 30, 25, 0, 31, 19, 2, 12, 24, 20, 28, 16, 23, 4, 0, 0, 0, 0, 0, 0, 0, 0, 0 }, /* k = 11: 356 ones, was 434 */
+    { 12, 9, 14, 10, 18, 21, 5, 24, 20, 2, 31, 28, 26, 6, 11, 27, 0, 0, 0, 0, 0, 0, 0, 0 }, /* k = 12: 398 ones, was 474 */
+    { 0, 3, 13, 12, 9, 8, 15, 19, 22, 24, 6, 10, 26, 7, 14, 11, 20, 0, 0, 0, 0, 0, 0, 0 }, /* k = 13: 440 ones, was 517 */
+    { 16, 22, 4, 0, 24, 26, 1, 28, 3, 31, 7, 12, 21, 27, 14, 6, 2, 17, 0, 0, 0, 0, 0, 0 }, /* k = 14: 483 ones, was 564 */
+    { 26, 20, 0, 4, 24, 11, 5, 19, 1, 10, 15, 25, 23, 31, 12, 27, 30, 29, 3, 0, 0, 0, 0, 0 }, /* k = 15: 528 ones, was 607 */
+    { 6, 3, 25, 7, 4, 13, 21, 27, 10, 29, 24, 17, 8, 9, 2, 19, 18, 20, 12, 26, 0, 0, 0, 0 }, /* k = 16: 574 ones, was 656 */
+    { 12, 30, 17, 28, 2, 5, 16, 23, 24, 6, 10, 14, 27, 20, 25, 3, 9, 21, 13, 11, 19, 0, 0, 0 }, /* k = 17: 620 ones, was 690 */
+    { 22, 28, 10, 17, 0, 1, 29, 21, 19, 18, 13, 31, 20, 7, 15, 3, 27, 12, 24, 2, 16, 25, 0, 0 }, /* k = 18: 668 ones, was 731 */
+    { 15, 25, 3, 11, 24, 2, 19, 23, 29, 21, 13, 30, 27, 10, 4, 0, 5, 7, 22, 12, 8, 1, 17, 0 }, /* k = 19: 717 ones, was 777 */
+    { 13, 17, 9, 0, 8, 3, 2, 30, 16, 29, 7, 19, 24, 22, 23, 11, 25, 28, 6, 5, 1, 4, 12, 15 } /* k = 20: 763 ones, was 826 */
+  },
+  { /* w = 6 */
+    { 0, 1, 2, 3, 4, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 }, /* k = 1: 24 ones, was 24 */
+    { 31, 36, 3, 4, 47, 57, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 }, /* k = 2: 52 ones, was 79 */
+    { 5, 6, 14, 53, 36, 44, 13, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 }, /* k = 3: 92 ones, was 133 */
+    { 51, 27, 58, 40, 31, 60, 54, 30, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 }, /* k = 4: 130 ones, was 197 */
+    { 20, 6, 11, 60, 46, 52, 7, 40, 28, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 }, /* k = 5: 173 ones, was 252 */
+    { 39, 56, 31, 32, 34, 13, 16, 61, 33, 60, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 }, /* k = 6: 216 ones, was 310 */
+    { 33, 3, 36, 32, 40, 38, 61, 29, 54, 6, 27, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 }, /* k = 7: 259 ones, was 367 */
+    { 57, 37, 16, 63, 38, 50, 25, 20, 33, 43, 59, 6, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 }, /* k = 8: 302 ones, was 419 */
+    { 14, 41, 25, 7, 47, 10, 40, 31, 49, 38, 23, 45, 39, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 }, /* k = 9: 347 ones, was 468 */
+    { 33, 1, 10, 11, 28, 6, 60, 43, 14, 5, 26, 22, 25, 48, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 }, /* k = 10: 398 ones, was 520 */
+    { 3, 42, 25, 37, 24, 18, 54, 40, 53, 41, 34, 56, 39, 58, 28, 0, 0, 0, 0, 0, 0, 0, 0, 0 }, /* k = 11: 456 ones, was 581 */
+    { 10, 57, 44, 12, 49, 34, 59, 29, 37, 45, 24, 32, 48, 25, 36, 52, 0, 0, 0, 0, 0, 0, 0, 0 }, /* k = 12: 490 ones, was 651 */
+    { 23, 37, 39, 1, 46, 55, 61, 57, 19, 0, 58, 22, 5, 63, 31, 43, 8, 0, 0, 0, 0, 0, 0, 0 }, /* k = 13: 546 ones, was 709 */
+    { 23, 10, 32, 25, 0, 16, 20, 33, 29, 28, 36, 51, 54, 59, 60, 2, 27, 55, 0, 0, 0, 0, 0, 0 }, /* k = 14: 598 ones, was 762 */
+    { 5, 58, 59, 55, 44, 60, 9, 10, 32, 36, 39, 15, 61, 18, 29, 22, 1, 38, 13, 0, 0, 0, 0, 0 }, /* k = 15: 654 ones, was 819 */
+    { 26, 37, 30, 3, 24, 27, 38, 53, 34, 14, 1, 21, 23, 7, 41, 19, 44, 16, 10, 32, 0, 0, 0, 0 }, /* k = 16: 704 ones, was 872 */
+    { 21, 40, 58, 12, 6, 33, 9, 51, 18, 14, 53, 5, 61, 48, 45, 43, 49, 59, 62, 19, 47, 0, 0, 0 }, /* k = 17: 754 ones, was 927 */
+    { 4, 27, 48, 29, 37, 5, 25, 28, 13, 18, 19, 62, 24, 45, 22, 61, 39, 20, 60, 59, 56, 16, 0, 0 }, /* k = 18: 809 ones, was 985 */
+    { 32, 52, 54, 18, 21, 23, 9, 58, 53, 4, 45, 15, 56, 13, 63, 3, 42, 30, 17, 59, 34, 27, 7, 0 }, /* k = 19: 865 ones, was 1054 */
+    { 22, 18, 38, 10, 36, 16, 26, 15, 0, 27, 3, 52, 37, 50, 49, 44, 1, 19, 25, 40, 8, 7, 47, 46 } /* k = 20: 921 ones, was 1096 */
+  },
+  { /* w = 7 */
+    { 0, 1, 2, 3, 4, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 }, /* k = 1: 28 ones, was 28 */
+    { 46, 31, 120, 97, 22, 44, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 }, /* k = 2: 60 ones, was 83 */
+    { 24, 19, 20, 5, 107, 105, 44, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 }, /* k = 3: 103 ones, was 153 */
+    { 123, 30, 37, 67, 110, 13, 81, 114, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 }, /* k = 4: 153 ones, was 229 */
+    { 84, 118, 113, 103, 72, 18, 4, 117, 54, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 }, /* k = 5: 201 ones, was 306 */
+    { 82, 8, 88, 94, 34, 77, 54, 73, 68, 12, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 }, /* k = 6: 259 ones, was 397 */
+    { 121, 18, 115, 8, 99, 82, 6, 55, 5, 70, 83, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 }, /* k = 7: 316 ones, was 482 */
+    { 121, 97, 100, 99, 75, 71, 47, 83, 1, 52, 127, 119, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 }, /* k = 8: 357 ones, was 574 */
+    { 1, 6, 61, 90, 102, 66, 88, 58, 30, 85, 13, 94, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 }, /* k = 9: 438 ones, was 602 */
+    { 47, 85, 71, 52, 84, 2, 42, 23, 67, 0, 105, 96, 14, 94, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 }, /* k = 10: 464 ones, was 670 */
+    { 77, 114, 35, 65, 80, 100, 42, 79, 108, 31, 1, 122, 28, 119, 82, 0, 0, 0, 0, 0, 0, 0, 0, 0 }, /* k = 11: 558 ones, was 754 */
+    { 73, 114, 9, 68, 57, 79, 74, 91, 119, 90, 87, 102, 89, 35, 45, 120, 0, 0, 0, 0, 0, 0, 0, 0 }, /* k = 12: 583 ones, was 826 */
+    { 39, 66, 88, 96, 32, 74, 93, 16, 65, 82, 56, 38, 122, 45, 41, 112, 29, 0, 0, 0, 0, 0, 0, 0 }, /* k = 13: 645 ones, was 904 */
+    { 57, 6, 48, 19, 0, 44, 117, 77, 31, 43, 99, 38, 24, 58, 105, 110, 55, 97, 0, 0, 0, 0, 0, 0 }, /* k = 14: 739 ones, was 979 */
+    { 43, 62, 95, 21, 94, 92, 50, 51, 90, 59, 119, 38, 11, 109, 98, 89, 100, 80, 122, 0, 0, 0, 0, 0 }, /* k = 15: 784 ones, was 1048 */
+    { 40, 2, 64, 20, 8, 112, 108, 85, 89, 124, 102, 76, 42, 83, 9, 0, 60, 24, 87, 118, 0, 0, 0, 0 }, /* k = 16: 853 ones, was 1106 */
+    { 1, 117, 106, 76, 13, 93, 12, 43, 124, 65, 50, 26, 63, 22, 105, 61, 125, 51, 35, 64, 71, 0, 0, 0 }, /* k = 17: 912 ones, was 1206 */
+    { 87, 62, 1, 69, 64, 103, 104, 47, 43, 38, 16, 118, 27, 88, 10, 0, 95, 66, 90, 105, 122, 84, 0, 0 }, /* k = 18: 965 ones, was 1297 */
+    { 0, 1, 2, 42, 28, 5, 58, 88, 102, 32, 118, 14, 117, 115, 7, 15, 31, 17, 18, 112, 36, 116, 63, 0 }, /* k = 19: 1055 ones, was 1371 */
+    { 32, 113, 57, 46, 76, 84, 66, 101, 52, 95, 124, 123, 45, 106, 89, 1, 63, 70, 9, 51, 29, 2, 37, 11 } /* k = 20: 1130 ones, was 1450 */
+  },
+  { /* w = 8 */
+    { 0, 1, 2, 3, 4, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 }, /* k = 1: 32 ones, was 32 */
+    { 73, 81, 116, 4, 80, 187, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 }, /* k = 2: 76 ones, was 117 */
+    { 252, 20, 54, 82, 149, 228, 85, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 }, /* k = 3: 141 ones, was 215 */
+    { 156, 237, 182, 151, 43, 230, 56, 86, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 }, /* k = 4: 208 ones, was 315 */
+    { 139, 169, 42, 140, 69, 215, 197, 153, 92, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 }, /* k = 5: 281 ones, was 404 */
+    { 71, 100, 77, 234, 153, 19, 42, 180, 89, 131, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 }, /* k = 6: 342 ones, was 499 */
+    { 124, 185, 158, 31, 249, 32, 68, 101, 112, 135, 64, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 }, /* k = 7: 420 ones, was 592 */
+    { 202, 245, 221, 138, 86, 188, 24, 62, 85, 154, 14, 66, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 }, /* k = 8: 486 ones, was 691 */
+    { 220, 112, 237, 251, 235, 191, 61, 242, 13, 62, 200, 35, 101, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 }, /* k = 9: 568 ones, was 794 */
+    { 55, 225, 153, 241, 75, 233, 0, 3, 204, 194, 211, 31, 197, 167, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 }, /* k = 10: 650 ones, was 888 */
+    { 2, 17, 151, 98, 198, 24, 227, 37, 219, 74, 164, 139, 18, 34, 63, 0, 0, 0, 0, 0, 0, 0, 0, 0 }, /* k = 11: 729 ones, was 1002 */
+    { 75, 55, 239, 220, 145, 10, 70, 114, 176, 240, 54, 16, 246, 170, 144, 113, 0, 0, 0, 0, 0, 0, 0, 0 }, /* k = 12: 830 ones, was 1087 */
+    { 13, 189, 163, 235, 229, 34, 102, 179, 253, 232, 57, 42, 111, 192, 219, 161, 74, 0, 0, 0, 0, 0, 0, 0 }, /* k = 13: 885 ones, was 1204 */
+    { 167, 82, 115, 124, 52, 57, 196, 147, 102, 235, 148, 187, 156, 67, 214, 0, 134, 192, 0, 0, 0, 0, 0, 0 }, /* k = 14: 969 ones, was 1288 */
+    { 133, 127, 28, 132, 17, 195, 245, 187, 9, 147, 212, 190, 93, 44, 224, 126, 197, 30, 237, 0, 0, 0, 0, 0 }, /* k = 15: 1037 ones, was 1387 */
+    { 206, 57, 216, 167, 139, 35, 236, 229, 184, 2, 32, 237, 31, 164, 137, 130, 162, 28, 241, 136, 0, 0, 0, 0 }, /* k = 16: 1146 ones, was 1497 */
+    { 173, 211, 172, 196, 145, 94, 120, 14, 121, 229, 192, 102, 75, 233, 144, 2, 44, 24, 96, 28, 203, 0, 0, 0 }, /* k = 17: 1183 ones, was 1605 */
+    { 42, 152, 66, 198, 214, 131, 24, 126, 113, 32, 219, 90, 168, 135, 27, 239, 147, 160, 190, 67, 9, 203, 0, 0 }, /* k = 18: 1304 ones, was 1705 */
+    { 62, 120, 160, 235, 151, 135, 49, 210, 144, 146, 56, 129, 196, 157, 185, 241, 18, 172, 238, 147, 34, 217, 41, 0 }, /* k = 19: 1397 ones, was 1804 */
+    { 226, 198, 0, 21, 25, 114, 208, 28, 100, 235, 233, 210, 81, 250, 150, 239, 194, 136, 92, 101, 156, 117, 201, 170 } /* k = 20: 1463 ones, was 1904 */
+  },
+  { /* w = 9 */
+    { 0, 1, 2, 3, 4, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 }, /* k = 1: 36 ones, was 36 */
+    { 461, 423, 0, 54, 350, 468, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 }, /* k = 2: 76 ones, was 116 */
+    { 306, 325, 209, 46, 378, 410, 390, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 }, /* k = 3: 141 ones, was 246 */
+    { 12, 481, 16, 239, 480, 202, 171, 506, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 }, /* k = 4: 223 ones, was 364 */
+    { 269, 478, 211, 174, 356, 433, 272, 99, 141, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 }, /* k = 5: 300 ones, was 476 */
+    { 365, 319, 315, 457, 506, 272, 496, 464, 76, 274, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 }, /* k = 6: 384 ones, was 592 */
+    { 111, 435, 193, 149, 204, 330, 91, 89, 258, 437, 337, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 }, /* k = 7: 472 ones, was 704 */
+    { 436, 293, 189, 173, 367, 378, 327, 324, 46, 315, 124, 429, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 }, /* k = 8: 552 ones, was 810 */
+    { 283, 172, 95, 410, 323, 141, 60, 503, 343, 287, 337, 149, 471, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 }, /* k = 9: 663 ones, was 949 */
+    { 144, 288, 271, 401, 93, 462, 298, 273, 23, 445, 303, 493, 500, 499, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 }, /* k = 10: 741 ones, was 1071 */
+    { 0, 399, 2, 244, 225, 5, 205, 393, 132, 171, 327, 78, 262, 339, 22, 0, 0, 0, 0, 0, 0, 0, 0, 0 }, /* k = 11: 814 ones, was 1196 */
+    { 104, 223, 330, 250, 402, 467, 71, 79, 311, 206, 27, 341, 292, 269, 321, 286, 0, 0, 0, 0, 0, 0, 0, 0 }, /* k = 12: 899 ones, was 1297 */
+    { 144, 204, 385, 76, 333, 43, 481, 197, 504, 297, 101, 7, 347, 506, 161, 20, 173, 0, 0, 0, 0, 0, 0, 0 }, /* k = 13: 947 ones, was 1442 */
+    { 169, 63, 225, 89, 261, 118, 155, 83, 470, 496, 259, 274, 503, 70, 145, 394, 312, 228, 0, 0, 0, 0, 0, 0 }, /* k = 14: 1061 ones, was 1565 */
+    { 32, 41, 214, 142, 495, 453, 29, 86, 409, 374, 199, 102, 88, 483, 432, 333, 28, 233, 208, 0, 0, 0, 0, 0 }, /* k = 15: 1170 ones, was 1694 */
+    { 405, 213, 371, 458, 316, 443, 221, 17, 343, 48, 356, 3, 204, 270, 123, 222, 399, 506, 384, 453, 0, 0, 0, 0 }, /* k = 16: 1266 ones, was 1806 */
+    { 249, 407, 318, 250, 475, 211, 52, 349, 266, 289, 44, 396, 108, 416, 101, 18, 103, 87, 439, 227, 40, 0, 0, 0 }, /* k = 17: 1365 ones, was 1953 */
+    { 370, 478, 112, 394, 298, 138, 297, 206, 411, 259, 211, 275, 240, 139, 412, 165, 79, 100, 92, 30, 75, 184, 0, 0 }, /* k = 18: 1436 ones, was 2105 */
+    { 41, 185, 38, 85, 159, 87, 298, 198, 440, 411, 5, 378, 278, 204, 477, 273, 71, 236, 139, 162, 377, 314, 347, 0 }, /* k = 19: 1530 ones, was 2180 */
+    { 212, 142, 86, 63, 496, 203, 252, 167, 306, 450, 115, 161, 214, 301, 352, 236, 254, 149, 210, 376, 135, 298, 170, 68 } /* k = 20: 1591 ones, was 2316 */
+  },
+  { /* w = 10 */
+    { 0, 1, 2, 3, 4, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 }, /* k = 1: 40 ones, was 40 */
+    { 129, 801, 577, 776, 104, 213, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 }, /* k = 2: 86 ones, was 140 */
+    { 423, 564, 213, 434, 687, 109, 401, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 }, /* k = 3: 165 ones, was 275 */
+    { 867, 409, 110, 148, 897, 312, 297, 1007, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 }, /* k = 4: 264 ones, was 391 */
+    { 454, 812, 820, 825, 44, 166, 329, 247, 131, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 }, /* k = 5: 363 ones, was 526 */
+    { 855, 468, 976, 939, 67, 691, 300, 546, 900, 44, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 }, /* k = 6: 433 ones, was 658 */
+    { 564, 432, 957, 256, 754, 202, 196, 85, 318, 843, 616, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 }, /* k = 7: 570 ones, was 794 */
+    { 234, 952, 824, 578, 141, 381, 946, 910, 102, 236, 415, 538, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 }, /* k = 8: 639 ones, was 935 */
+    { 642, 139, 696, 572, 608, 372, 873, 148, 58, 279, 1004, 943, 806, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 }, /* k = 9: 737 ones, was 1063 */
+    { 131, 685, 558, 645, 299, 636, 163, 427, 444, 586, 183, 891, 122, 407, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 }, /* k = 10: 885 ones, was 1244 */
+    { 359, 169, 284, 414, 56, 779, 933, 633, 645, 704, 421, 465, 457, 702, 622, 0, 0, 0, 0, 0, 0, 0, 0, 0 }, /* k = 11: 1004 ones, was 1419 */
+    { 133, 585, 575, 57, 921, 315, 190, 992, 737, 590, 594, 205, 218, 260, 231, 361, 0, 0, 0, 0, 0, 0, 0, 0 }, /* k = 12: 1091 ones, was 1564 */
+    { 938, 346, 834, 524, 819, 332, 368, 610, 579, 373, 115, 352, 395, 49, 51, 928, 161, 0, 0, 0, 0, 0, 0, 0 }, /* k = 13: 1205 ones, was 1707 */
+    { 947, 48, 903, 231, 485, 920, 661, 839, 536, 664, 662, 250, 685, 710, 632, 94, 762, 300, 0, 0, 0, 0, 0, 0 }, /* k = 14: 1292 ones, was 1869 */
+    { 200, 966, 888, 249, 823, 40, 976, 313, 791, 779, 782, 754, 748, 732, 1000, 816, 497, 1004, 261, 0, 0, 0, 0, 0 }, /* k = 15: 1455 ones, was 2019 */
+    { 854, 392, 777, 562, 363, 117, 661, 613, 304, 564, 98, 1006, 664, 565, 19, 69, 862, 329, 275, 373, 0, 0, 0, 0 }, /* k = 16: 1509 ones, was 2163 */
+    { 600, 753, 733, 140, 338, 677, 999, 424, 816, 803, 626, 180, 978, 393, 296, 76, 603, 28, 796, 783, 315, 0, 0, 0 }, /* k = 17: 1651 ones, was 2323 */
+    { 0, 968, 691, 3, 4, 10, 981, 317, 187, 461, 184, 910, 415, 515, 615, 472, 1022, 17, 18, 518, 100, 209, 0, 0 }, /* k = 18: 1764 ones, was 2529 */
+    { 733, 780, 197, 319, 375, 395, 153, 895, 495, 442, 271, 533, 3, 109, 264, 309, 1003, 269, 323, 38, 522, 795, 513, 0 }, /* k = 19: 1846 ones, was 2657 */
+    { 0, 461, 2, 983, 493, 947, 165, 784, 8, 124, 64, 618, 990, 296, 872, 98, 469, 960, 518, 922, 874, 209, 455, 14 } /* k = 20: 1953 ones, was 2822 */
+  },
+  { /* w = 11 */
+    { 0, 1, 2, 3, 4, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 }, /* k = 1: 44 ones, was 44 */
+    { 1721, 297, 891, 410, 1561, 524, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 }, /* k = 2: 105 ones, was 190 */
+    { 679, 634, 1658, 1547, 810, 428, 1326, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 }, /* k = 3: 196 ones, was 381 */
+    { 613, 1130, 1255, 1639, 363, 318, 212, 1595, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 }, /* k = 4: 309 ones, was 528 */
+    { 606, 1807, 369, 644, 1431, 5, 1092, 1508, 1047, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 }, /* k = 5: 455 ones, was 586 */
+    { 1365, 1712, 1117, 184, 896, 2026, 1426, 473, 1240, 1421, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 }, /* k = 6: 577 ones, was 724 */
+    { 1280, 1006, 280, 1726, 705, 1787, 245, 420, 535, 196, 1936, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 }, /* k = 7: 691 ones, was 899 */
+    { 558, 621, 402, 1381, 997, 17, 1582, 25, 446, 1117, 983, 824, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 }, /* k = 8: 820 ones, was 1106 */
+    { 1415, 658, 279, 1447, 1260, 2040, 1606, 1118, 261, 373, 1827, 1112, 350, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 }, /* k = 9: 908 ones, was 1314 */
+    { 145, 968, 1495, 1467, 28, 1697, 1637, 1968, 762, 1191, 1352, 935, 1578, 1984, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 }, /* k = 10: 974 ones, was 1471 */
+    { 0, 1, 15, 3, 4, 5, 902, 7, 1817, 2044, 588, 1690, 1026, 1869, 1837, 0, 0, 0, 0, 0, 0, 0, 0, 0 }, /* k = 11: 1160 ones, was 1650 */
+    { 369, 1514, 1187, 1839, 410, 936, 1128, 354, 1403, 429, 252, 264, 1609, 364, 412, 983, 0, 0, 0, 0, 0, 0, 0, 0 }, /* k = 12: 1300 ones, was 1792 */
+    { 0, 1, 2, 617, 4, 5, 1504, 777, 1899, 1243, 1248, 11, 271, 879, 14, 1868, 16, 0, 0, 0, 0, 0, 0, 0 }, /* k = 13: 1383 ones, was 1930 */
+    { 787, 1977, 978, 1718, 1829, 365, 1327, 1614, 1125, 1184, 102, 1726, 1006, 1960, 1680, 424, 731, 1476, 0, 0, 0, 0, 0, 0 }, /* k = 14: 1549 ones, was 2086 */
+    { 1691, 410, 615, 286, 1775, 679, 1748, 944, 1578, 325, 1495, 880, 748, 1973, 2026, 661, 970, 1480, 995, 0, 0, 0, 0, 0 }, /* k = 15: 1706 ones, was 2257 */
+    { 1733, 411, 664, 1867, 985, 1134, 1153, 504, 363, 1787, 860, 1989, 1492, 1002, 518, 202, 713, 580, 897, 1581, 0, 0, 0, 0 }, /* k = 16: 1832 ones, was 2445 */
+    { 0, 1, 2, 3, 4, 5, 17, 7, 465, 270, 10, 692, 12, 626, 1837, 902, 1869, 1024, 512, 1573, 1836, 0, 0, 0 }, /* k = 17: 2014 ones, was 2678 */
+    { 1864, 512, 610, 1967, 1432, 1804, 929, 1747, 1989, 1672, 1882, 894, 322, 25, 1832, 633, 1598, 1958, 1430, 390, 1390, 890, 0, 0 }, /* k = 18: 2104 ones, was 2827 */
+    { 1462, 943, 1018, 157, 119, 77, 1234, 1004, 1242, 1796, 1544, 1167, 685, 373, 1995, 217, 32, 167, 518, 674, 721, 1547, 934, 0 }, /* k = 19: 2198 ones, was 3068 */
+    { 897, 1607, 850, 1083, 1637, 1985, 1792, 842, 1593, 1115, 902, 892, 231, 838, 469, 560, 931, 1722, 503, 1871, 1744, 465, 1223, 1349 } /* k = 20: 2418 ones, was 3286 */
+  },
+  { /* w = 12 */
+    { 0, 1, 2, 3, 4, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 }, /* k = 1: 48 ones, was 48 */
+    { 2739, 1212, 2658, 3367, 2049, 3832, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 }, /* k = 2: 111 ones, was 209 */
+    { 1949, 2201, 3971, 3661, 667, 4017, 2447, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 }, /* k = 3: 265 ones, was 394 */
+    { 861, 890, 477, 3842, 1250, 3839, 2430, 744, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 }, /* k = 4: 430 ones, was 569 */
+    { 2835, 3999, 2475, 1213, 3324, 2017, 2702, 3693, 3305, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 }, /* k = 5: 615 ones, was 727 */
+    { 2888, 2032, 705, 1803, 2457, 2041, 3520, 2706, 3921, 288, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 }, /* k = 6: 769 ones, was 911 */
+    { 0, 3464, 2, 444, 4, 1128, 6, 2399, 1733, 3253, 10, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 }, /* k = 7: 939 ones, was 1126 */
+    { 801, 3275, 1886, 1317, 3777, 2385, 1685, 157, 3988, 2332, 3746, 1133, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 }, /* k = 8: 1130 ones, was 1327 */
+    { 2642, 1848, 2165, 2519, 546, 3068, 769, 154, 865, 3133, 3390, 1421, 2822, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 }, /* k = 9: 1286 ones, was 1554 */
+    { 0, 1, 348, 3, 4, 5, 770, 2089, 549, 4047, 1580, 2995, 2699, 13, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 }, /* k = 10: 1322 ones, was 1784 */
+    { 2063, 3409, 366, 3374, 2588, 3832, 877, 592, 3723, 911, 967, 1204, 1278, 1392, 3590, 0, 0, 0, 0, 0, 0, 0, 0, 0 }, /* k = 11: 1588 ones, was 1995 */
+    { 1914, 2659, 2278, 4049, 1864, 1965, 2187, 2704, 312, 3022, 1687, 2678, 3577, 1840, 2579, 2843, 0, 0, 0, 0, 0, 0, 0, 0 }, /* k = 12: 1762 ones, was 2192 */
+    { 0, 1, 2, 3568, 4, 3690, 3559, 782, 2419, 2288, 962, 11, 12, 634, 1842, 3133, 16, 0, 0, 0, 0, 0, 0, 0 }, /* k = 13: 1939 ones, was 2350 */
+    { 1794, 1459, 752, 3605, 1294, 214, 1520, 4027, 3195, 3642, 3228, 1799, 475, 1826, 3332, 3781, 2724, 1195, 0, 0, 0, 0, 0, 0 }, /* k = 14: 2082 ones, was 2566 */
+    { 2105, 766, 1506, 1332, 1741, 855, 2176, 1775, 1083, 3289, 4066, 947, 3955, 3385, 1832, 1126, 611, 2708, 2247, 0, 0, 0, 0, 0 }, /* k = 15: 2273 ones, was 2780 */
+    { 0, 1, 2, 3, 4, 425, 1580, 7, 3752, 2089, 10, 1876, 1733, 13, 1496, 1183, 2645, 815, 3657, 3204, 0, 0, 0, 0 }, /* k = 16: 2361 ones, was 2981 */
+    { 2532, 3905, 331, 3642, 3159, 1880, 2853, 1977, 2312, 9, 2902, 1687, 1939, 1600, 2971, 801, 1546, 1322, 4083, 731, 20, 0, 0, 0 }, /* k = 17: 2515 ones, was 3219 */
+    { 0, 1, 2, 3, 4, 5, 1824, 697, 1733, 2995, 3468, 11, 3948, 668, 2570, 2795, 16, 1761, 831, 3886, 751, 4047, 0, 0 }, /* k = 18: 2702 ones, was 3452 */
+    { 0, 1, 2, 3, 2411, 5, 75, 1673, 3314, 1973, 1063, 1071, 2883, 3067, 3133, 2609, 16, 12, 1733, 3890, 3655, 722, 610, 0 }, /* k = 19: 2996 ones, was 3730 */
+    { 900, 1186, 1766, 1801, 2443, 3185, 2635, 436, 2063, 462, 3501, 1033, 2464, 526, 1188, 3681, 897, 72, 1486, 3673, 726, 817, 1342, 3351 } /* k = 20: 3107 ones, was 3953 */
+  },
+  { /* w = 13 */
+    { 0, 1, 2, 3, 4, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 }, /* k = 1: 52 ones, was 52 */
+    { 4111, 4925, 2563, 4786, 1401, 5636, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 }, /* k = 2: 152 ones, was 220 */
+    { 2957, 6602, 4263, 6622, 907, 4981, 5500, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 }, /* k = 3: 322 ones, was 422 */
+    { 0, 1, 2, 5846, 2513, 5, 6, 2852, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 }, /* k = 4: 483 ones, was 610 */
+    { 4183, 4662, 33, 2550, 2486, 622, 329, 366, 3689, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 }, /* k = 5: 686 ones, was 789 */
+    { 5209, 3088, 6871, 7444, 3173, 6482, 971, 7287, 6401, 2638, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 }, /* k = 6: 849 ones, was 981 */
+    { 3440, 3773, 5545, 1036, 4805, 719, 5329, 5052, 2030, 7526, 3782, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 }, /* k = 7: 1106 ones, was 1223 */
+    { 7239, 7543, 599, 2653, 7075, 3428, 7424, 4302, 4112, 1941, 6290, 6228, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 }, /* k = 8: 1263 ones, was 1425 */
+    { 4068, 1944, 4408, 1392, 4071, 4761, 6573, 5097, 6257, 8137, 934, 4602, 2956, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 }, /* k = 9: 1445 ones, was 1648 */
+    { 0, 1, 2, 3, 4, 5, 4480, 7, 1483, 5846, 10, 75, 7471, 13, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 }, /* k = 10: 1609 ones, was 1880 */
+    { 0, 1, 2, 3, 4, 8182, 6, 5845, 6064, 9, 5132, 2516, 12, 6782, 5349, 0, 0, 0, 0, 0, 0, 0, 0, 0 }, /* k = 11: 1815 ones, was 2165 */
+    { 0, 1, 2, 3, 4, 5, 8181, 7, 8, 8176, 10, 2735, 5853, 1584, 2733, 15, 0, 0, 0, 0, 0, 0, 0, 0 }, /* k = 12: 1959 ones, was 2390 */
+    { 3065, 7910, 3703, 4404, 4513, 2217, 4923, 1671, 7188, 169, 1076, 5877, 1150, 4967, 5207, 6028, 6996, 0, 0, 0, 0, 0, 0, 0 }, /* k = 13: 2231 ones, was 2598 */
+    { 0, 1, 2, 3, 4, 5, 7768, 5132, 6350, 3765, 8181, 8182, 12, 900, 5034, 4007, 16, 5847, 0, 0, 0, 0, 0, 0 }, /* k = 14: 2293 ones, was 2851 */
+    { 7115, 1692, 8012, 6789, 5609, 6185, 6028, 3902, 7992, 4969, 6417, 5691, 4718, 4549, 7263, 4404, 897, 6177, 1538, 0, 0, 0, 0, 0 }, /* k = 15: 2578 ones, was 3083 */
+    { 3499, 6376, 4452, 713, 2539, 2296, 7335, 3867, 4217, 1411, 7817, 5175, 4208, 3688, 751, 2593, 5124, 5776, 7397, 1736, 0, 0, 0, 0 }, /* k = 16: 2773 ones, was 3357 */
+    { 655, 6764, 1495, 750, 7972, 4142, 2489, 3839, 461, 440, 6379, 2139, 3292, 6213, 4343, 5125, 987, 175, 210, 7576, 5167, 0, 0, 0 }, /* k = 17: 3069 ones, was 3637 */
+    { 7470, 7085, 1854, 4812, 6537, 1297, 4195, 7791, 7102, 1446, 1103, 7847, 2555, 4347, 2473, 5099, 4645, 1071, 4430, 1919, 634, 2710, 0, 0 }, /* k = 18: 3248 ones, was 3885 */
+    { 0, 25, 2, 3, 4, 7012, 4558, 7, 8, 2463, 10, 3698, 5922, 7984, 3570, 7478, 4115, 17, 6594, 8181, 3212, 5477, 2474, 0 }, /* k = 19: 3326 ones, was 4153 */
+    { 0, 1, 2, 3, 4, 5, 6, 7, 1483, 3506, 2433, 5847, 8180, 7013, 7012, 5489, 2199, 1868, 7471, 5846, 3965, 25, 8181, 1720 } /* k = 20: 3383 ones, was 4398 */
+  },
+  { /* w = 14 */
+    { 0, 1, 2, 3, 4, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 }, /* k = 1: 56 ones, was 56 */
+    { 1018, 2269, 13689, 3854, 15741, 3803, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 }, /* k = 2: 155 ones, was 245 */
+    { 7308, 11285, 13151, 2380, 10402, 16102, 2849, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 }, /* k = 3: 382 ones, was 491 */
+    { 4963, 9583, 15586, 1665, 2796, 3912, 14556, 14588, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 }, /* k = 4: 606 ones, was 745 */
+    { 13623, 11615, 3428, 8972, 8921, 9835, 12968, 12317, 8027, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 }, /* k = 5: 872 ones, was 946 */
+    { 10912, 355, 11005, 876, 10044, 5370, 2176, 5906, 11115, 9300, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 }, /* k = 6: 1089 ones, was 1189 */
+    { 7862, 9137, 7369, 16259, 4328, 8076, 3404, 12540, 11246, 1351, 6249, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 }, /* k = 7: 1267 ones, was 1465 */
+    { 0, 1, 2, 3, 4, 5, 4749, 7, 9501, 16349, 10, 907, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 }, /* k = 8: 1489 ones, was 1767 */
+    { 6196, 3404, 8831, 8829, 13426, 2991, 9693, 3394, 876, 10942, 1000, 4149, 5805, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 }, /* k = 9: 1749 ones, was 2012 */
+    { 0, 1, 2, 3, 9873, 5, 6, 7, 8, 9, 12650, 4163, 12, 12270, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 }, /* k = 10: 2055 ones, was 2264 */
+    { 0, 1, 2, 3, 4, 14076, 16349, 7, 8, 2556, 2712, 11, 2689, 12097, 283, 0, 0, 0, 0, 0, 0, 0, 0, 0 }, /* k = 11: 2190 ones, was 2614 */
+    { 7286, 8408, 2228, 1069, 5940, 4543, 1537, 1299, 12654, 11234, 13653, 3544, 9582, 638, 11467, 15228, 0, 0, 0, 0, 0, 0, 0, 0 }, /* k = 12: 2523 ones, was 2856 */
+    { 0, 1, 2, 3, 4, 5, 6, 7, 8, 7218, 10, 4749, 12, 15289, 13, 15, 14588, 0, 0, 0, 0, 0, 0, 0 }, /* k = 13: 2764 ones, was 3028 */
+    { 5646, 747, 12064, 3342, 11425, 15060, 16010, 14307, 1343, 13137, 9394, 5442, 1320, 8301, 14856, 6737, 6485, 1378, 0, 0, 0, 0, 0, 0 }, /* k = 14: 2971 ones, was 3272 */
+    { 0, 1, 2, 3, 4, 5, 8738, 5678, 8737, 133, 14827, 11, 12876, 13, 14, 6945, 16, 2058, 2751, 0, 0, 0, 0, 0 }, /* k = 15: 3071 ones, was 3527 */
+    { 4896, 11522, 7113, 15926, 6991, 10081, 6845, 3755, 14514, 3124, 10345, 14034, 3989, 3523, 13694, 3502, 884, 1860, 8177, 8771, 0, 0, 0, 0 }, /* k = 16: 3325 ones, was 3757 */
+    { 0, 1, 2, 3, 4, 5, 8459, 7, 7762, 9855, 9576, 11, 304, 13, 8737, 4749, 16, 13698, 12830, 13226, 6855, 0, 0, 0 }, /* k = 17: 3412 ones, was 4092 */
+    { 0, 1, 2, 3, 4, 5, 1375, 7, 14105, 14076, 10, 11, 10161, 4596, 9501, 8738, 16, 17, 8737, 928, 2751, 3143, 0, 0 }, /* k = 18: 3711 ones, was 4404 */
+    { 2107, 2942, 15331, 296, 5552, 2439, 12555, 1142, 3852, 9043, 2740, 12699, 12381, 863, 435, 7889, 3434, 5600, 7084, 12431, 2849, 6563, 2113, 0 }, /* k = 19: 4164 ones, was 4760 */
+    { 15364, 12691, 9595, 6324, 10616, 13903, 14362, 8464, 10041, 6831, 2927, 2160, 15812, 12597, 7677, 6064, 13882, 4675, 6711, 12377, 8346, 6294, 9410, 15831 } /* k = 20: 4365 ones, was 5067 */
+  },
+  { /* w = 15 */
+    { 0, 1, 2, 3, 4, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 }, /* k = 1: 60 ones, was 60 */
+    { 32369, 12097, 27132, 18232, 18330, 24794, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 }, /* k = 2: 179 ones, was 271 */
+    { 19026, 5910, 12549, 30533, 14795, 22816, 15448, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 }, /* k = 3: 399 ones, was 610 */
+    { 7012, 7939, 22596, 10425, 11839, 19352, 15836, 23095, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 }, /* k = 4: 597 ones, was 877 */
+    { 27163, 31439, 19327, 21749, 23781, 30519, 30125, 4101, 1508, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 }, /* k = 5: 871 ones, was 957 */
+    { 29767, 13440, 10602, 4789, 8212, 4281, 18309, 4790, 4264, 6324, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 }, /* k = 6: 1053 ones, was 1179 */
+    { 17730, 21588, 22748, 3, 27887, 19125, 15536, 7668, 4714, 5671, 3887, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 }, /* k = 7: 1399 ones, was 1487 */
+    { 0, 1, 2, 3, 13250, 24919, 6, 7, 8, 19388, 32159, 32259, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 }, /* k = 8: 1584 ones, was 1855 */
+    { 0, 1, 12961, 3, 4, 5, 14764, 12974, 23407, 24201, 10, 17827, 19691, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 }, /* k = 9: 1798 ones, was 2261 */
+    { 9812, 29773, 14454, 8833, 27950, 13741, 1867, 6110, 8295, 22361, 32333, 5268, 12701, 20670, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 }, /* k = 10: 2041 ones, was 2531 */
+    { 0, 26061, 2, 3, 15291, 32016, 6, 7, 8, 9, 17250, 23407, 28819, 12430, 1983, 0, 0, 0, 0, 0, 0, 0, 0, 0 }, /* k = 11: 2265 ones, was 2882 */
+    { 4480, 25702, 19615, 9856, 14949, 20828, 8440, 23604, 20316, 17800, 11882, 30645, 28610, 14358, 11780, 13989, 0, 0, 0, 0, 0, 0, 0, 0 }, /* k = 12: 2544 ones, was 3117 */
+    { 0, 1, 2, 3, 4, 5, 32766, 7, 30240, 12165, 10, 11, 13518, 13, 27427, 28182, 16, 0, 0, 0, 0, 0, 0, 0 }, /* k = 13: 2658 ones, was 3287 */
+    { 0, 1, 2, 3, 4, 5, 32766, 7, 29385, 20062, 10, 11, 1369, 13, 14, 20288, 16, 8347, 0, 0, 0, 0, 0, 0 }, /* k = 14: 3018 ones, was 3560 */
+    { 0, 1, 2, 3, 4, 5, 6899, 27427, 4814, 3248, 32765, 11, 21402, 19678, 14, 486, 16, 32766, 23407, 0, 0, 0, 0, 0 }, /* k = 15: 3133 ones, was 3856 */
+    { 0, 1, 2, 3, 4, 5, 30240, 7, 19678, 13518, 10, 11, 32766, 13, 14, 32765, 16, 3603, 1369, 16154, 0, 0, 0, 0 }, /* k = 16: 3417 ones, was 4119 */
+    { 0, 1, 2, 3, 4, 5, 5284, 27427, 881, 14635, 10, 11, 23542, 13, 14, 5843, 16, 17621, 32766, 13583, 17183, 0, 0, 0 }, /* k = 17: 3596 ones, was 4521 */
+    { 0, 1, 2, 3, 4, 5, 6361, 32765, 2499, 23204, 10, 11, 23407, 13, 14, 8347, 16, 4373, 32766, 5843, 12165, 11078, 0, 0 }, /* k = 18: 3794 ones, was 4878 */
+    { 0, 1, 2, 3, 4, 15168, 6, 7, 8, 8880, 10, 28911, 28427, 6899, 28390, 32765, 12576, 30096, 16824, 8051, 27837, 486, 22, 0 }, /* k = 19: 4131 ones, was 5283 */
+    { 223, 4774, 11899, 31399, 10824, 24387, 15328, 9926, 31319, 30688, 15770, 7651, 10261, 3993, 16336, 18956, 3819, 6083, 132, 29509, 18072, 8232, 25964, 425 } /* k = 20: 4427 ones, was 5690 */
+  },
+  { /* w = 16 */
+    { 0, 1, 2, 3, 4, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 }, /* k = 1: 64 ones, was 64 */
+    { 6890, 13944, 18731, 35648, 34127, 5000, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 }, /* k = 2: 232 ones, was 277 */
+    { 0, 1, 7369, 3, 27793, 5, 6, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 }, /* k = 3: 499 ones, was 647 */
+    { 9955, 52839, 6034, 10627, 45737, 37855, 12376, 12365, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 }, /* k = 4: 837 ones, was 967 */
+    { 0, 1, 2, 3, 27478, 5, 6, 7, 8, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 }, /* k = 5: 1067 ones, was 1083 */
+    { 0, 1, 34818, 3, 47239, 5, 6, 7, 8, 9, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 }, /* k = 6: 1225 ones, was 1337 */
+    { 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 }, /* k = 7: 1645 ones, was 1645 */
+    { 0, 1, 2, 3, 4, 5, 40536, 7, 23688, 39021, 10, 11, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 }, /* k = 8: 1830 ones, was 2003 */
+    { 0, 1, 2, 3, 15008, 5, 6, 7, 8, 9, 31849, 2309, 12, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 }, /* k = 9: 2177 ones, was 2324 */
+    { 0, 1, 2, 3, 4, 5, 6, 7, 8, 21516, 10, 45945, 12, 13, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 }, /* k = 10: 2509 ones, was 2549 */
+    { 0, 1, 2, 3, 22234, 5, 6, 7, 8, 9, 60345, 45945, 12, 13, 49918, 0, 0, 0, 0, 0, 0, 0, 0, 0 }, /* k = 11: 2793 ones, was 2896 */
+    { 0, 1, 2, 3, 27348, 5, 6, 7, 8, 9, 27793, 11, 12, 40975, 28295, 15, 0, 0, 0, 0, 0, 0, 0, 0 }, /* k = 12: 3095 ones, was 3155 */
+    { 0, 1, 2, 3, 4, 5, 6, 7, 8, 40536, 10, 58795, 12, 13, 45945, 15, 60007, 0, 0, 0, 0, 0, 0, 0 }, /* k = 13: 3329 ones, was 3466 */
+    { 0, 1, 2, 3, 4, 5, 35081, 7, 4041, 27501, 10, 45794, 62706, 13, 14, 61881, 16, 17, 0, 0, 0, 0, 0, 0 }, /* k = 14: 3375 ones, was 3771 */
+    { 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16, 17, 18, 0, 0, 0, 0, 0 }, /* k = 15: 4055 ones, was 4055 */
+    { 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16, 17, 18, 19, 0, 0, 0, 0 }, /* k = 16: 4310 ones, was 4310 */
+    { 0, 1, 2, 3, 4, 5, 6, 7, 8, 27501, 10, 11, 12, 13, 14, 15, 16, 17, 18, 19, 18862, 0, 0, 0 }, /* k = 17: 4512 ones, was 4769 */
+    { 0, 1, 2, 3, 4, 5, 6, 7, 8, 62736, 10, 11, 12, 13, 14, 15, 16, 17, 18, 27501, 33783, 58795, 0, 0 }, /* k = 18: 4909 ones, was 5156 */
+    { 0, 1, 2, 3, 4, 5, 6, 7, 8, 18862, 10, 11, 12, 13, 14, 15, 16, 17, 18, 45794, 51452, 54947, 26779, 0 }, /* k = 19: 5209 ones, was 5600 */
+    { 0, 1, 2, 3, 4, 5, 61891, 7, 29910, 27501, 10, 11, 53521, 13, 14, 42751, 16, 45794, 18, 58303, 34819, 62736, 1614, 7778 } /* k = 20: 5184 ones, was 6046 */
+  },
+};
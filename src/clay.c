@@ -0,0 +1,485 @@
+/* *
+ * Copyright (c) 2014, James S. Plank and Kevin Greenan
+ * All rights reserved.
+ *
+ * Jerasure - A C/C++ Library for a Variety of Reed-Solomon and RAID-6 Erasure
+ * Coding Techniques
+ *
+ * Revision 2.0: Galois Field backend now links to GF-Complete
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *  - Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ *  - Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ *
+ *  - Neither the name of the University of Tennessee nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY
+ * WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+
+#include "galois.h"
+#include "jerasure.h"
+#include "reed_sol.h"
+#include "clay.h"
+
+#define talloc(type, num) (type *) malloc(sizeof(type)*(num))
+
+/* Internally, the virtual devices come right after the data, so node i
+   is data for i < k+nu and coding after that.  Node i sits at x = i%q,
+   y = i/q in a q x t grid.  Layer z is read as t base-q digits z_0 ..
+   z_{t-1}.  In layer z, node (x,y) is coupled with node (z_y,y) in layer
+   z with digit y set to x, unless x == z_y.  With gamma^2 != 1, a coupled
+   pair of uncoupled symbols U, U* and stored symbols C, C* is related by
+
+       C  = U  + gamma U*          U  = (C + gamma C*) / (1 + gamma^2)
+       C* = U* + gamma U
+
+   and C = U for uncoupled symbols. */
+
+static int digit(int z, int y, int q)
+{
+  for (; y > 0; y--) z /= q;
+  return z % q;
+}
+
+static int set_digit(int z, int y, int x, int q)
+{
+  int p;
+
+  for (p = 1; y > 0; y--) p *= q;
+  return z + (x - (z/p) % q) * p;
+}
+
+static int node_of(clay_code_t *c, int dev)
+{
+  return (dev < c->k) ? dev : dev + c->nu;
+}
+
+/* Internal buffers are multiplied to and from the caller's chunks, and
+   GF-Complete needs both ends of a region multiply at the same address
+   mod 16.  This returns nbytes at like's offset mod 16 into a block that
+   is left in *base for free(), or NULL. */
+
+static char *alloc_like(long nbytes, char *like, char **base)
+{
+  *base = talloc(char, nbytes + 16);
+  if (*base == NULL) return NULL;
+  return *base + (((uintptr_t) like - (uintptr_t) *base) & 15);
+}
+
+/* dest = f * src, or dest ^= f * src if add */
+
+static void mult_region(int w, char *src, int f, int size, char *dest, int add)
+{
+  if (f == 1) {
+    if (add) galois_region_xor(src, dest, size);
+    else memcpy(dest, src, size);
+    return;
+  }
+  switch (w) {
+    case 8:  galois_w08_region_multiply(src, f, size, dest, add); break;
+    case 16: galois_w16_region_multiply(src, f, size, dest, add); break;
+    case 32: galois_w32_region_multiply(src, f, size, dest, add); break;
+  }
+}
+
+/* The coefficients used to couple and uncouple */
+
+typedef struct {
+  int a;         /* gamma / (1 + gamma^2) */
+  int b;         /* 1 / (1 + gamma^2) */
+  int ginv;      /* 1 / gamma */
+  int gsum;      /* 1 / gamma + gamma */
+} clay_coefs;
+
+static void get_coefs(clay_code_t *c, clay_coefs *cf)
+{
+  int d;
+
+  d = 1 ^ galois_single_multiply(c->gamma, c->gamma, c->w);
+  cf->b = galois_single_divide(1, d, c->w);
+  cf->a = galois_single_multiply(c->gamma, cf->b, c->w);
+  cf->ginv = galois_single_divide(1, c->gamma, c->w);
+  cf->gsum = cf->ginv ^ c->gamma;
+}
+
+clay_code_t *clay_create(int k, int m, int w)
+{
+  clay_code_t *c;
+  int i, n;
+
+  if (k <= 0 || m < 2) return NULL;
+  if (w != 8 && w != 16 && w != 32) return NULL;
+
+  c = talloc(clay_code_t, 1);
+  if (c == NULL) return NULL;
+  c->k = k;
+  c->m = m;
+  c->w = w;
+  c->q = m;
+  c->nu = (m - (k+m) % m) % m;
+  n = k + c->nu + m;
+  c->t = n / m;
+  c->alpha = 1;
+  for (i = 0; i < c->t; i++) {
+    if (c->alpha > (1 << 24) / m) {
+      free(c);
+      return NULL;
+    }
+    c->alpha *= m;
+  }
+  c->gamma = 2;
+  c->matrix = NULL;
+  if (w <= 16 && n > (1 << w)) {
+    free(c);
+    return NULL;
+  }
+  c->matrix = reed_sol_vandermonde_coding_matrix(k + c->nu, m, w);
+  if (c->matrix == NULL) {
+    free(c);
+    return NULL;
+  }
+  return c;
+}
+
+void clay_free(clay_code_t *c)
+{
+  if (c == NULL) return;
+  free(c->matrix);
+  free(c);
+}
+
+int clay_sub_chunks(clay_code_t *c)
+{
+  return c->alpha;
+}
+
+/* Sub-chunks are multiplied in place by GF-Complete, which needs source
+   and destination at the same offset mod 16.  Keeping every sub-chunk a
+   multiple of 16 bytes keeps them at the offsets of their chunks. */
+
+static int size_ok(clay_code_t *c, int size)
+{
+  return (size > 0 && size % (c->alpha * 16) == 0);
+}
+
+/* Decodes the nodes flagged in erased, with C[i] the chunk of node i.
+   Layers are handled in order of how many erased nodes are uncoupled in
+   them: the uncoupled symbols of a layer only depend on erased symbols of
+   layers with one fewer. */
+
+static int clay_decode_nodes(clay_code_t *c, int *erased, char **C, int size)
+{
+  clay_coefs cf;
+  int n, kk, q, sc, ne, i, j, x, y, z, zp, p, s, maxs, nl;
+  int *score, *order, *rec, *dest_ids, *dm_ids;
+  char *ubuf, *ubase, **U, **ptrs;
+  int rv;
+
+  q = c->q;
+  kk = c->k + c->nu;
+  n = kk + c->m;
+  sc = size / c->alpha;
+  get_coefs(c, &cf);
+
+  score = talloc(int, c->alpha);
+  order = talloc(int, c->alpha);
+  rec = talloc(int, n*kk);
+  dest_ids = talloc(int, n);
+  dm_ids = talloc(int, kk);
+  U = talloc(char *, n);
+  ptrs = talloc(char *, n);
+  ubuf = alloc_like((long) n * size, C[0], &ubase);
+  rv = -1;
+  if (score == NULL || order == NULL || rec == NULL || dest_ids == NULL || dm_ids == NULL ||
+      U == NULL || ptrs == NULL || ubuf == NULL) goto done;
+  for (i = 0; i < n; i++) U[i] = ubuf + (long) i * size;
+
+  ne = jerasure_make_recovery_matrix(kk, c->m, c->w, c->matrix, erased, rec, dest_ids, dm_ids);
+  if (ne < 0) goto done;
+
+  maxs = 0;
+  for (z = 0; z < c->alpha; z++) {
+    score[z] = 0;
+    for (i = 0; i < n; i++) {
+      if (erased[i] && i % q == digit(z, i / q, q)) score[z]++;
+    }
+    if (score[z] > maxs) maxs = score[z];
+  }
+  nl = 0;
+  for (s = 0; s <= maxs; s++) {
+    for (z = 0; z < c->alpha; z++) if (score[z] == s) order[nl++] = z;
+  }
+
+  for (j = 0; j < nl; j++) {
+    z = order[j];
+
+    /* Uncouple the surviving symbols of this layer */
+
+    for (i = 0; i < n; i++) {
+      x = i % q;
+      y = i / q;
+      if (!erased[i] && x == digit(z, y, q)) {
+        ptrs[i] = C[i] + z*sc;
+        continue;
+      }
+      ptrs[i] = U[i] + z*sc;
+      if (erased[i]) continue;
+      p = y*q + digit(z, y, q);
+      zp = set_digit(z, y, x, q);
+      if (!erased[p]) {
+        mult_region(c->w, C[i] + z*sc, cf.b, sc, ptrs[i], 0);
+        mult_region(c->w, C[p] + zp*sc, cf.a, sc, ptrs[i], 1);
+      } else {
+        memcpy(ptrs[i], C[i] + z*sc, sc);
+        mult_region(c->w, U[p] + zp*sc, c->gamma, sc, ptrs[i], 1);
+      }
+    }
+
+    /* Then decode the layer with the uncoupled code */
+
+    for (i = 0; i < ne; i++) {
+      jerasure_matrix_dotprod(kk, c->w, rec + i*kk, dm_ids, dest_ids[i], ptrs, ptrs + kk, sc);
+    }
+  }
+
+  /* Couple the erased nodes again */
+
+  for (i = 0; i < n; i++) {
+    if (!erased[i]) continue;
+    x = i % q;
+    y = i / q;
+    for (z = 0; z < c->alpha; z++) {
+      if (x == digit(z, y, q)) {
+        memcpy(C[i] + z*sc, U[i] + z*sc, sc);
+      } else {
+        p = y*q + digit(z, y, q);
+        zp = set_digit(z, y, x, q);
+        memcpy(C[i] + z*sc, U[i] + z*sc, sc);
+        mult_region(c->w, U[p] + zp*sc, c->gamma, sc, C[i] + z*sc, 1);
+      }
+    }
+  }
+  rv = 0;
+
+done:
+  free(score); free(order); free(rec); free(dest_ids); free(dm_ids);
+  free(U); free(ptrs); free(ubase);
+  return rv;
+}
+
+/* Sets up the node arrays for the k+m devices; virtual nodes get a zero
+   chunk, which is left in *zero for free() */
+
+static int setup_nodes(clay_code_t *c, char **data_ptrs, char **coding_ptrs, int size,
+                       char ***C, int **erased, char **zero)
+{
+  int n, i;
+  char *z;
+
+  n = c->k + c->nu + c->m;
+  *C = talloc(char *, n);
+  *erased = talloc(int, n);
+  *zero = NULL;
+  z = NULL;
+  if (c->nu > 0) {
+    z = alloc_like(size, data_ptrs[0], zero);
+    if (z != NULL) bzero(z, size);
+  }
+  if (*C == NULL || *erased == NULL || (c->nu > 0 && z == NULL)) {
+    free(*C);
+    free(*erased);
+    free(*zero);
+    return -1;
+  }
+  bzero(*erased, sizeof(int)*n);
+  for (i = 0; i < c->k; i++) (*C)[i] = data_ptrs[i];
+  for (i = 0; i < c->nu; i++) (*C)[c->k+i] = z;
+  for (i = 0; i < c->m; i++) (*C)[c->k+c->nu+i] = coding_ptrs[i];
+  return 0;
+}
+
+int clay_encode(clay_code_t *c, char **data_ptrs, char **coding_ptrs, int size)
+{
+  char **C, *zero;
+  int *erased, i, rv;
+
+  if (!size_ok(c, size)) return -1;
+  if (setup_nodes(c, data_ptrs, coding_ptrs, size, &C, &erased, &zero) < 0) return -1;
+  for (i = 0; i < c->m; i++) erased[c->k+c->nu+i] = 1;
+  rv = clay_decode_nodes(c, erased, C, size);
+  free(C);
+  free(erased);
+  free(zero);
+  return rv;
+}
+
+int clay_decode(clay_code_t *c, int *erasures, char **data_ptrs, char **coding_ptrs, int size)
+{
+  char **C, *zero;
+  int *erased, i, ne, rv;
+
+  if (!size_ok(c, size)) return -1;
+  if (setup_nodes(c, data_ptrs, coding_ptrs, size, &C, &erased, &zero) < 0) return -1;
+  ne = 0;
+  rv = -1;
+  for (i = 0; erasures[i] != -1; i++) {
+    if (erasures[i] < 0 || erasures[i] >= c->k + c->m) goto done;
+    if (erased[node_of(c, erasures[i])]) continue;
+    erased[node_of(c, erasures[i])] = 1;
+    ne++;
+  }
+  if (ne > c->m) goto done;
+  rv = (ne == 0) ? 0 : clay_decode_nodes(c, erased, C, size);
+
+done:
+  free(C);
+  free(erased);
+  free(zero);
+  return rv;
+}
+
+int clay_repair_sub_chunks(clay_code_t *c, int lost, int *sub_chunks)
+{
+  int f, z, n;
+
+  f = node_of(c, lost);
+  n = 0;
+  for (z = 0; z < c->alpha; z++) {
+    if (digit(z, f / c->q, c->q) == f % c->q) sub_chunks[n++] = z;
+  }
+  return n;
+}
+
+void clay_repair_pack(clay_code_t *c, int lost, char *chunk, char *out, int size)
+{
+  int f, z, sc;
+
+  f = node_of(c, lost);
+  sc = size / c->alpha;
+  for (z = 0; z < c->alpha; z++) {
+    if (digit(z, f / c->q, c->q) == f % c->q) {
+      memcpy(out, chunk + z*sc, sc);
+      out += sc;
+    }
+  }
+}
+
+/* Repair.  Only the layers in which the lost node (x0,y0) is uncoupled
+   are read.  In each of them, the nodes outside column y0 can be
+   uncoupled from helper data alone, because their partners sit in
+   another repair layer.  The q nodes of column y0 are then decoded with
+   the uncoupled code.  That gives the lost node's symbol in this layer.
+   From each other node of the column, it also gives the lost node's
+   symbol in the layer that node is coupled with. */
+
+int clay_repair(clay_code_t *c, int lost, char **helpers, char *dest, int size)
+{
+  clay_coefs cf;
+  int n, kk, q, sc, part, f, x0, y0, i, j, r, x, y, z, zp, p, ne, rv;
+  int *zr, *erased, *rec, *dest_ids, *dm_ids;
+  char **H, **ptrs, *ubuf, *zero, *ubase, *zbase;
+
+  if (!size_ok(c, size) || lost < 0 || lost >= c->k + c->m) return -1;
+
+  q = c->q;
+  kk = c->k + c->nu;
+  n = kk + c->m;
+  sc = size / c->alpha;
+  part = size / q;
+  f = node_of(c, lost);
+  x0 = f % q;
+  y0 = f / q;
+  get_coefs(c, &cf);
+
+  zr = talloc(int, c->alpha);
+  erased = talloc(int, n);
+  rec = talloc(int, n*kk);
+  dest_ids = talloc(int, n);
+  dm_ids = talloc(int, kk);
+  H = talloc(char *, n);
+  ptrs = talloc(char *, n);
+  ubuf = alloc_like((long) n * part, dest, &ubase);
+  zero = alloc_like(part, dest, &zbase);
+  rv = -1;
+  if (zr == NULL || erased == NULL || rec == NULL || dest_ids == NULL || dm_ids == NULL ||
+      H == NULL || ptrs == NULL || ubuf == NULL || zero == NULL) goto done;
+
+  bzero(zero, part);
+  for (i = 0; i < c->k; i++) H[i] = helpers[i];
+  for (i = 0; i < c->nu; i++) H[c->k+i] = zero;
+  for (i = 0; i < c->m; i++) H[kk+i] = helpers[c->k+i];
+  H[f] = NULL;
+
+  r = 0;
+  for (z = 0; z < c->alpha; z++) zr[z] = (digit(z, y0, q) == x0) ? r++ : -1;
+
+  for (i = 0; i < n; i++) erased[i] = (i / q == y0);
+  ne = jerasure_make_recovery_matrix(kk, c->m, c->w, c->matrix, erased, rec, dest_ids, dm_ids);
+  if (ne < 0) goto done;
+
+  for (z = 0; z < c->alpha; z++) {
+    if (zr[z] < 0) continue;
+
+    for (i = 0; i < n; i++) {
+      x = i % q;
+      y = i / q;
+      ptrs[i] = ubuf + (long) i * part + zr[z]*sc;
+      if (y == y0) continue;
+      if (x == digit(z, y, q)) {
+        ptrs[i] = H[i] + zr[z]*sc;
+        continue;
+      }
+      p = y*q + digit(z, y, q);
+      zp = set_digit(z, y, x, q);
+      mult_region(c->w, H[i] + zr[z]*sc, cf.b, sc, ptrs[i], 0);
+      mult_region(c->w, H[p] + zr[zp]*sc, cf.a, sc, ptrs[i], 1);
+    }
+
+    for (i = 0; i < ne; i++) {
+      jerasure_matrix_dotprod(kk, c->w, rec + i*kk, dm_ids, dest_ids[i], ptrs, ptrs + kk, sc);
+    }
+
+    /* The lost node is uncoupled here, and coupled with column y0 elsewhere */
+
+    memcpy(dest + z*sc, ptrs[f], sc);
+    for (x = 0; x < q; x++) {
+      if (x == x0) continue;
+      j = y0*q + x;
+      zp = set_digit(z, y0, x, q);
+      mult_region(c->w, H[j] + zr[z]*sc, cf.ginv, sc, dest + zp*sc, 0);
+      mult_region(c->w, ptrs[j], cf.gsum, sc, dest + zp*sc, 1);
+    }
+  }
+  rv = 0;
+
+done:
+  free(zr); free(erased); free(rec); free(dest_ids); free(dm_ids);
+  free(H); free(ptrs); free(ubase); free(zbase);
+  return rv;
+}
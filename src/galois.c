@@ -49,6 +49,11 @@
 #include <string.h>
 #include <errno.h>
 #include <assert.h>
+#include <pthread.h>
+
+#ifdef __SSSE3__
+#include <tmmintrin.h>
+#endif
 
 #include "galois.h"
 
@@ -56,13 +61,33 @@
 gf_t *gfp_array[MAX_GF_INSTANCES] = { 0 };
 int  gfp_is_composite[MAX_GF_INSTANCES] = { 0 };
 
-gf_t *galois_get_field_ptr(int w)
+/* Fields are created lazily on first use, possibly from several threads at
+   once.  Readers load gfp_array[w] with acquire semantics and only take
+   gfp_lock when the slot is empty; writers build the gf_t completely and
+   then publish it with a release store, so a reader never sees a
+   half-initialized field. */
+
+static pthread_mutex_t gfp_lock = PTHREAD_MUTEX_INITIALIZER;
+
+/* gfp_altmap[w] is set when the field installed for w does not store
+   region words in the standard layout (GF-Complete's ALTMAP regions).  It
+   is written under gfp_lock. */
+
+static int gfp_altmap[MAX_GF_INSTANCES];
+
+static gf_t *load_field(int w)
 {
-  if (gfp_array[w] != NULL) {
-    return gfp_array[w];
-  }
+  return __atomic_load_n(&gfp_array[w], __ATOMIC_ACQUIRE);
+}
 
-  return NULL;
+static void publish_field(int w, gf_t *gf)
+{
+  __atomic_store_n(&gfp_array[w], gf, __ATOMIC_RELEASE);
+}
+
+gf_t *galois_get_field_ptr(int w)
+{
+  return load_field(w);
 }
 
 gf_t* galois_init_field(int w,
@@ -172,29 +197,51 @@ gf_t* galois_init_composite_field(int w,
 
 int galois_init_default_field(int w)
 {
+  gf_t *gf;
+  int ret = 0;
+
+  if (load_field(w) != NULL) return 0;
+
+  pthread_mutex_lock(&gfp_lock);
   if (gfp_array[w] == NULL) {
-    gfp_array[w] = (gf_t*)malloc(sizeof(gf_t));
-    if(gfp_array[w] == NULL)
-      return ENOMEM;
-    if (!gf_init_easy(gfp_array[w], w))
-      return EINVAL;
-  }
-  return 0;
+    gf = (gf_t*)malloc(sizeof(gf_t));
+    if (gf == NULL) {
+      ret = ENOMEM;
+    } else if (!gf_init_easy(gf, w)) {
+      free(gf);
+      ret = EINVAL;
+    } else {
+      gfp_is_composite[w] = 0;
+      __atomic_store_n(&gfp_altmap[w], 0, __ATOMIC_RELAXED);
+      publish_field(w, gf);
+    }
+  }
+  pthread_mutex_unlock(&gfp_lock);
+  return ret;
 }
 
+/* Not safe against concurrent users of field w: callers must make sure no
+   other thread is still multiplying in it. */
+
 int galois_uninit_field(int w)
 {
   int ret = 0;
-  if (gfp_array[w] != NULL) {
+  gf_t *gf;
+
+  pthread_mutex_lock(&gfp_lock);
+  gf = gfp_array[w];
+  if (gf != NULL) {
     int recursive = 1;
-    ret = gf_free(gfp_array[w], recursive);
-    free(gfp_array[w]);
-    gfp_array[w] = NULL;
+    publish_field(w, NULL);
+    __atomic_store_n(&gfp_altmap[w], 0, __ATOMIC_RELAXED);
+    ret = gf_free(gf, recursive);
+    free(gf);
   }
+  pthread_mutex_unlock(&gfp_lock);
   return ret;
 }
 
-static void galois_init(int w)
+static gf_t *galois_init(int w)
 {
   if (w <= 0 || w > 32) {
     fprintf(stderr, "ERROR -- cannot init default Galois field for w=%d\n", w);
@@ -211,6 +258,24 @@ static void galois_init(int w)
     assert(0);
     break;
   }
+  return load_field(w);
+}
+
+/* Returns the field for w, creating the default one if needed. */
+
+static gf_t *galois_field(int w)
+{
+  gf_t *gf;
+
+  gf = load_field(w);
+  if (gf == NULL) gf = galois_init(w);
+  return gf;
+}
+
+int galois_warmup(int w)
+{
+  if (w <= 0 || w > 32) return -1;
+  return (galois_init_default_field(w) == 0) ? 0 : -1;
 }
 
 
@@ -243,8 +308,48 @@ static int is_valid_gf(gf_t *gf, int w)
   return 1;
 }
 
+/* Multiplies a test region with gf and compares each word with a single
+   multiply.  Only w = 8, 16 and 32 have alternate layouts. */
+
+static int region_layout_is_standard(gf_t *gf, int w)
+{
+  unsigned char *src, *dest;
+  uint32_t sw, dw;
+  int i, j, nb, standard;
+  void *p;
+
+  if (w != 8 && w != 16 && w != 32) return 1;
+  if (posix_memalign(&p, 64, 512) != 0) return 0;
+  src = p;
+  dest = src + 256;
+  for (i = 0; i < 256; i++) src[i] = i*37 + 11;
+  gf->multiply_region.w32(gf, src, dest, 0x5b, 256, 0);
+
+  nb = w/8;
+  standard = 1;
+  for (i = 0; i < 256 && standard; i += nb) {
+    sw = 0;
+    dw = 0;
+    for (j = 0; j < nb; j++) {
+      sw |= (uint32_t) src[i+j] << (8*j);
+      dw |= (uint32_t) dest[i+j] << (8*j);
+    }
+    if (gf->multiply.w32(gf, sw, 0x5b) != dw) standard = 0;
+  }
+  free(p);
+  return standard;
+}
+
+int galois_standard_region_layout(int w)
+{
+  if (w <= 0 || w >= MAX_GF_INSTANCES) return 1;
+  return !__atomic_load_n(&gfp_altmap[w], __ATOMIC_RELAXED);
+}
+
 void galois_change_technique(gf_t *gf, int w)
 {
+  int standard;
+
   if (w <= 0 || w > 32) {
     fprintf(stderr, "ERROR -- cannot support Galois field for w=%d\n", w);
     assert(0);
@@ -255,23 +360,25 @@ void galois_change_technique(gf_t *gf, int w)
     assert(0);
   }
 
+  standard = region_layout_is_standard(gf, w);
+
+  pthread_mutex_lock(&gfp_lock);
   if (gfp_array[w] != NULL) {
     gf_free(gfp_array[w], gfp_is_composite[w]);
   }
 
-  gfp_array[w] = gf;
+  __atomic_store_n(&gfp_altmap[w], !standard, __ATOMIC_RELAXED);
+  publish_field(w, gf);
+  pthread_mutex_unlock(&gfp_lock);
 }
 
 int galois_single_multiply(int x, int y, int w)
 {
   if (x == 0 || y == 0) return 0;
   
-  if (gfp_array[w] == NULL) {
-    galois_init(w);
-  }
-
   if (w <= 32) {
-    return gfp_array[w]->multiply.w32(gfp_array[w], x, y);
+    gf_t *gf = galois_field(w);
+    return gf->multiply.w32(gf, x, y);
   } else {
     fprintf(stderr, "ERROR -- Galois field not implemented for w=%d\n", w);
     return 0;
@@ -283,12 +390,9 @@ int galois_single_divide(int x, int y, int w)
   if (x == 0) return 0;
   if (y == 0) return -1;
 
-  if (gfp_array[w] == NULL) {
-    galois_init(w);
-  }
-
   if (w <= 32) {
-    return gfp_array[w]->divide.w32(gfp_array[w], x, y);
+    gf_t *gf = galois_field(w);
+    return gf->divide.w32(gf, x, y);
   } else {
     fprintf(stderr, "ERROR -- Galois field not implemented for w=%d\n", w);
     return 0;
@@ -301,10 +405,39 @@ void galois_w08_region_multiply(char *region,      /* Region to multiply */
                                   char *r2,          /* If r2 != NULL, products go here */
                                   int add)
 {
-  if (gfp_array[8] == NULL) {
-    galois_init(8);
-  }
-  gfp_array[8]->multiply_region.w32(gfp_array[8], region, r2, multby, nbytes, add);
+  gf_t *gf = galois_field(8);
+
+  gf->multiply_region.w32(gf, region, r2, multby, nbytes, add);
+}
+
+/* w = 4 and w = 2 regions hold packed elements.  GF-Complete's general
+   fields do not use that layout for w = 2, so both go through the
+   prepared tables. */
+
+static void packed_region_multiply(char *region, int multby, int w, int nbytes, char *r2, int add)
+{
+  galois_prepared_t p;
+
+  galois_prepare_multiply(multby, w, &p);
+  galois_region_multiply_prepared(region, &p, nbytes, r2, add);
+}
+
+void galois_w04_region_multiply(char *region,      /* Region to multiply */
+                                  int multby,       /* Number to multiply by */
+                                  int nbytes,        /* Number of bytes in region */
+                                  char *r2,          /* If r2 != NULL, products go here */
+                                  int add)
+{
+  packed_region_multiply(region, multby, 4, nbytes, r2, add);
+}
+
+void galois_w02_region_multiply(char *region,      /* Region to multiply */
+                                  int multby,       /* Number to multiply by */
+                                  int nbytes,        /* Number of bytes in region */
+                                  char *r2,          /* If r2 != NULL, products go here */
+                                  int add)
+{
+  packed_region_multiply(region, multby, 2, nbytes, r2, add);
 }
 
 void galois_w16_region_multiply(char *region,      /* Region to multiply */
@@ -313,10 +446,9 @@ void galois_w16_region_multiply(char *region,      /* Region to multiply */
                                   char *r2,          /* If r2 != NULL, products go here */
                                   int add)
 {
-  if (gfp_array[16] == NULL) {
-    galois_init(16);
-  }
-  gfp_array[16]->multiply_region.w32(gfp_array[16], region, r2, multby, nbytes, add);
+  gf_t *gf = galois_field(16);
+
+  gf->multiply_region.w32(gf, region, r2, multby, nbytes, add);
 }
 
 
@@ -326,34 +458,231 @@ void galois_w32_region_multiply(char *region,      /* Region to multiply */
                                   char *r2,          /* If r2 != NULL, products go here */
                                   int add)
 {
-  if (gfp_array[32] == NULL) {
-    galois_init(32);
+  gf_t *gf = galois_field(32);
+
+  gf->multiply_region.w32(gf, region, r2, multby, nbytes, add);
+}
+
+/* For w = 2 and 4, a region holds 8/w elements per byte, packed from the
+   low bits up.  A nibble holds 4/w of them, so a nibble is multiplied as a
+   unit, and the tables are laid out as for w = 8: one byte from each of
+   two nibbles.  These give the number of nibble tables and bytes per word. */
+
+static int prepared_nibbles(int w)
+{
+  return (w < 8) ? 2 : w/4;
+}
+
+static int prepared_bytes(int w)
+{
+  return (w < 8) ? 1 : w/8;
+}
+
+/* multby times the packed elements of a nibble */
+
+static int packed_multiply(int multby, int nibble, int w)
+{
+  int i, mask, prod;
+
+  mask = (1 << w) - 1;
+  prod = 0;
+  for (i = 0; i < 4; i += w) {
+    prod |= galois_single_multiply(multby, (nibble >> i) & mask, w) << i;
   }
-  gfp_array[32]->multiply_region.w32(gfp_array[32], region, r2, multby, nbytes, add);
+  return prod;
 }
 
-void galois_w8_region_xor(void *src, void *dest, int nbytes)
+void galois_prepare_multiply(int multby, int w, galois_prepared_t *p)
 {
-  if (gfp_array[8] == NULL) {
-    galois_init(8);
+  int i, j, e, nb, prod;
+
+  if (w != 2 && w != 4 && w != 8 && w != 16 && w != 32) {
+    fprintf(stderr, "ERROR: galois_prepare_multiply() called and w is not 2, 4, 8, 16 or 32\n");
+    assert(0);
+  }
+
+  /* Table i*nb+j holds byte j of multby times each value of nibble i */
+
+  nb = prepared_bytes(w);
+  p->w = w;
+  p->multby = multby;
+  memset(p->tables, 0, sizeof(p->tables));
+  for (i = 0; i < prepared_nibbles(w); i++) {
+    for (e = 0; e < 16; e++) {
+      if (w < 8) {
+        prod = packed_multiply(multby, e, w) << (4*i);
+      } else {
+        prod = galois_single_multiply(multby, (int) ((uint32_t) e << (4*i)), w);
+      }
+      for (j = 0; j < nb; j++) p->tables[i*nb+j][e] = ((uint32_t) prod >> (8*j)) & 0xff;
+    }
   }
-  gfp_array[8]->multiply_region.w32(gfp_array[32], src, dest, 1, nbytes, 1);
 }
 
-void galois_w16_region_xor(void *src, void *dest, int nbytes)
+/* One word at a time from the tables, for the ends of regions. */
+
+static void prepared_multiply_words(galois_prepared_t *p, unsigned char *src,
+                                    unsigned char *dest, int nbytes, int add)
 {
-  if (gfp_array[16] == NULL) {
-    galois_init(16);
+  int x, i, j, nb;
+  uint32_t word, prod;
+
+  nb = prepared_bytes(p->w);
+  for (x = 0; x < nbytes; x += nb) {
+    word = 0;
+    for (j = 0; j < nb; j++) word |= (uint32_t) src[x+j] << (8*j);
+    prod = 0;
+    for (i = 0; i < prepared_nibbles(p->w); i++) {
+      for (j = 0; j < nb; j++) {
+        prod ^= (uint32_t) p->tables[i*nb+j][(word >> (4*i)) & 0xf] << (8*j);
+      }
+    }
+    for (j = 0; j < nb; j++) {
+      if (add) {
+        dest[x+j] ^= (prod >> (8*j)) & 0xff;
+      } else {
+        dest[x+j] = (prod >> (8*j)) & 0xff;
+      }
+    }
   }
-  gfp_array[16]->multiply_region.w32(gfp_array[16], src, dest, 1, nbytes, 1);
+}
+
+#ifdef __SSSE3__
+
+/* The SSSE3 kernels work on 16 words at a time.  The words are split into
+   byte planes, each nibble of each plane is looked up with pshufb, and the
+   output planes are put back together into words.  They assume little
+   endian words, which is what SSSE3 machines have. */
+
+static int prepared_multiply_ssse3(galois_prepared_t *p, unsigned char *src,
+                                   unsigned char *dest, int nbytes, int add)
+{
+  __m128i t[32], mask, v[4], n[8], o[4], tmp[4], tr;
+  int i, j, x, nb, block;
+
+  nb = prepared_bytes(p->w);
+  block = 16*nb;
+  for (i = 0; i < 2*nb*nb; i++) t[i] = _mm_loadu_si128((__m128i *) p->tables[i]);
+  mask = _mm_set1_epi8(0x0f);
+  tr = _mm_setr_epi8(0, 4, 8, 12, 1, 5, 9, 13, 2, 6, 10, 14, 3, 7, 11, 15);
+
+  for (x = 0; x + block <= nbytes; x += block) {
+    for (i = 0; i < nb; i++) v[i] = _mm_loadu_si128((__m128i *) (src+x+16*i));
+
+    /* v[j] becomes byte plane j of the 16 words */
+
+    if (nb == 2) {
+      tmp[0] = _mm_set1_epi16(0x00ff);
+      tmp[1] = _mm_packus_epi16(_mm_and_si128(v[0], tmp[0]), _mm_and_si128(v[1], tmp[0]));
+      v[1] = _mm_packus_epi16(_mm_srli_epi16(v[0], 8), _mm_srli_epi16(v[1], 8));
+      v[0] = tmp[1];
+    } else if (nb == 4) {
+      for (i = 0; i < 4; i++) v[i] = _mm_shuffle_epi8(v[i], tr);
+      tmp[0] = _mm_unpacklo_epi32(v[0], v[1]);
+      tmp[1] = _mm_unpacklo_epi32(v[2], v[3]);
+      tmp[2] = _mm_unpackhi_epi32(v[0], v[1]);
+      tmp[3] = _mm_unpackhi_epi32(v[2], v[3]);
+      v[0] = _mm_unpacklo_epi64(tmp[0], tmp[1]);
+      v[1] = _mm_unpackhi_epi64(tmp[0], tmp[1]);
+      v[2] = _mm_unpacklo_epi64(tmp[2], tmp[3]);
+      v[3] = _mm_unpackhi_epi64(tmp[2], tmp[3]);
+    }
+
+    for (j = 0; j < nb; j++) {
+      n[2*j] = _mm_and_si128(v[j], mask);
+      n[2*j+1] = _mm_and_si128(_mm_srli_epi64(v[j], 4), mask);
+    }
+
+    for (j = 0; j < nb; j++) {
+      o[j] = _mm_shuffle_epi8(t[j], n[0]);
+      for (i = 1; i < 2*nb; i++) {
+        o[j] = _mm_xor_si128(o[j], _mm_shuffle_epi8(t[i*nb+j], n[i]));
+      }
+    }
+
+    /* Back from byte planes to words */
+
+    if (nb == 2) {
+      tmp[0] = _mm_unpacklo_epi8(o[0], o[1]);
+      o[1] = _mm_unpackhi_epi8(o[0], o[1]);
+      o[0] = tmp[0];
+    } else if (nb == 4) {
+      tmp[0] = _mm_unpacklo_epi32(o[0], o[1]);
+      tmp[1] = _mm_unpacklo_epi32(o[2], o[3]);
+      tmp[2] = _mm_unpackhi_epi32(o[0], o[1]);
+      tmp[3] = _mm_unpackhi_epi32(o[2], o[3]);
+      o[0] = _mm_shuffle_epi8(_mm_unpacklo_epi64(tmp[0], tmp[1]), tr);
+      o[1] = _mm_shuffle_epi8(_mm_unpackhi_epi64(tmp[0], tmp[1]), tr);
+      o[2] = _mm_shuffle_epi8(_mm_unpacklo_epi64(tmp[2], tmp[3]), tr);
+      o[3] = _mm_shuffle_epi8(_mm_unpackhi_epi64(tmp[2], tmp[3]), tr);
+    }
+
+    for (i = 0; i < nb; i++) {
+      if (add) o[i] = _mm_xor_si128(o[i], _mm_loadu_si128((__m128i *) (dest+x+16*i)));
+      _mm_storeu_si128((__m128i *) (dest+x+16*i), o[i]);
+    }
+  }
+  return x;
+}
+
+#endif
+
+void galois_region_multiply_prepared(char *region, galois_prepared_t *p, int nbytes,
+                                     char *r2, int add)
+{
+  int done;
+
+  if (r2 == NULL) {
+    r2 = region;
+    add = 0;
+  }
+
+  /* The tables only know the standard layout. */
+
+  if (p->w >= 8 && !galois_standard_region_layout(p->w)) {
+    switch (p->w) {
+      case 8:  galois_w08_region_multiply(region, p->multby, nbytes, r2, add); break;
+      case 16: galois_w16_region_multiply(region, p->multby, nbytes, r2, add); break;
+      case 32: galois_w32_region_multiply(region, p->multby, nbytes, r2, add); break;
+    }
+    return;
+  }
+
+#ifdef __SSSE3__
+  done = prepared_multiply_ssse3(p, (unsigned char *) region, (unsigned char *) r2, nbytes, add);
+  prepared_multiply_words(p, (unsigned char *) region + done, (unsigned char *) r2 + done,
+                          nbytes - done, add);
+#else
+  (void) done;
+  switch (p->w) {
+    case 2:
+    case 4:  prepared_multiply_words(p, (unsigned char *) region, (unsigned char *) r2, nbytes, add); break;
+    case 8:  galois_w08_region_multiply(region, p->multby, nbytes, r2, add); break;
+    case 16: galois_w16_region_multiply(region, p->multby, nbytes, r2, add); break;
+    case 32: galois_w32_region_multiply(region, p->multby, nbytes, r2, add); break;
+  }
+#endif
+}
+
+void galois_w8_region_xor(void *src, void *dest, int nbytes)
+{
+  gf_t *gf = galois_field(8);
+
+  gf->multiply_region.w32(gf, src, dest, 1, nbytes, 1);
+}
+
+void galois_w16_region_xor(void *src, void *dest, int nbytes)
+{
+  gf_t *gf = galois_field(16);
+
+  gf->multiply_region.w32(gf, src, dest, 1, nbytes, 1);
 }
 
 void galois_w32_region_xor(void *src, void *dest, int nbytes)
 {
-  if (gfp_array[32] == NULL) {
-    galois_init(32);
-  }
-  gfp_array[32]->multiply_region.w32(gfp_array[32], src, dest, 1, nbytes, 1);
+  gf_t *gf = galois_field(32);
+
+  gf->multiply_region.w32(gf, src, dest, 1, nbytes, 1);
 }
 
 void galois_region_xor(char *src, char *dest, int nbytes)
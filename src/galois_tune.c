@@ -0,0 +1,390 @@
+/* *
+ * Copyright (c) 2014, James S. Plank and Kevin Greenan
+ * All rights reserved.
+ *
+ * Jerasure - A C/C++ Library for a Variety of Reed-Solomon and RAID-6 Erasure
+ * Coding Techniques
+ *
+ * Revision 2.0: Galois Field backend now links to GF-Complete
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *  - Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ *  - Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ *
+ *  - Neither the name of the University of Tennessee nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY
+ * WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "galois.h"
+#include "galois_tune.h"
+
+#define talloc(type, num) (type *) malloc(sizeof(type)*(num))
+
+/* Each candidate is timed for at least this long */
+
+#define TUNE_MIN_SECONDS 0.02
+#define TUNE_MIN_ITERATIONS 4
+
+/* Number of words of each candidate's output checked against the default field */
+
+#define TUNE_CHECK_WORDS 256
+
+typedef struct {
+  const char *name;
+  int w;
+  int mult_type;
+  int region_type;
+  int arg1;
+  int arg2;
+} tune_candidate;
+
+/* The first candidate for each w must be DEFAULT: it is the reference the
+   others are checked against. */
+
+static tune_candidate candidates[] = {
+  { "DEFAULT",           8, GF_MULT_DEFAULT,     GF_REGION_DEFAULT,      0, 0 },
+  { "TABLE",             8, GF_MULT_TABLE,       GF_REGION_DEFAULT,      0, 0 },
+  { "TABLE_DOUBLE",      8, GF_MULT_TABLE,       GF_REGION_DOUBLE_TABLE, 0, 0 },
+  { "SPLIT_8_4_SIMD",    8, GF_MULT_SPLIT_TABLE, GF_REGION_SIMD,         8, 4 },
+  { "SPLIT_8_4_NOSIMD",  8, GF_MULT_SPLIT_TABLE, GF_REGION_NOSIMD,       8, 4 },
+  { "LOG",               8, GF_MULT_LOG_TABLE,   GF_REGION_DEFAULT,      0, 0 },
+  { "BYTWO_b",           8, GF_MULT_BYTWO_b,     GF_REGION_DEFAULT,      0, 0 },
+
+  { "DEFAULT",          16, GF_MULT_DEFAULT,     GF_REGION_DEFAULT,      0, 0 },
+  { "SPLIT_16_4_SIMD",  16, GF_MULT_SPLIT_TABLE, GF_REGION_SIMD,        16, 4 },
+  { "SPLIT_16_4_NOSIMD",16, GF_MULT_SPLIT_TABLE, GF_REGION_NOSIMD,      16, 4 },
+  { "SPLIT_16_8",       16, GF_MULT_SPLIT_TABLE, GF_REGION_DEFAULT,     16, 8 },
+  { "LOG",              16, GF_MULT_LOG_TABLE,   GF_REGION_DEFAULT,      0, 0 },
+  { "BYTWO_b",          16, GF_MULT_BYTWO_b,     GF_REGION_DEFAULT,      0, 0 },
+
+  { "DEFAULT",          32, GF_MULT_DEFAULT,     GF_REGION_DEFAULT,      0, 0 },
+  { "SPLIT_32_4_SIMD",  32, GF_MULT_SPLIT_TABLE, GF_REGION_SIMD,        32, 4 },
+  { "SPLIT_32_4_NOSIMD",32, GF_MULT_SPLIT_TABLE, GF_REGION_NOSIMD,      32, 4 },
+  { "SPLIT_32_8",       32, GF_MULT_SPLIT_TABLE, GF_REGION_DEFAULT,     32, 8 },
+  { "SPLIT_8_8",        32, GF_MULT_SPLIT_TABLE, GF_REGION_DEFAULT,      8, 8 },
+  { "GROUP_4_8",        32, GF_MULT_GROUP,       GF_REGION_DEFAULT,      4, 8 },
+  { "CARRY_FREE",       32, GF_MULT_CARRY_FREE,  GF_REGION_DEFAULT,      0, 0 },
+  { "BYTWO_b",          32, GF_MULT_BYTWO_b,     GF_REGION_DEFAULT,      0, 0 },
+  { NULL, 0, 0, 0, 0, 0 }
+};
+
+typedef struct {
+  gf_t *gf;
+  void *scratch;
+} tune_field;
+
+/* Builds the field for c into f.  Returns 0, or -1 if GF-Complete does not
+   support the technique on this host. */
+
+static int make_field(tune_candidate *c, tune_field *f)
+{
+  int size;
+
+  f->gf = NULL;
+  f->scratch = NULL;
+  size = gf_scratch_size(c->w, c->mult_type, c->region_type, GF_DIVIDE_DEFAULT,
+                         c->arg1, c->arg2);
+  if (size <= 0) return -1;
+
+  f->gf = talloc(gf_t, 1);
+  f->scratch = malloc(size);
+  if (f->gf == NULL || f->scratch == NULL ||
+      !gf_init_hard(f->gf, c->w, c->mult_type, c->region_type, GF_DIVIDE_DEFAULT,
+                    0, c->arg1, c->arg2, NULL, f->scratch)) {
+    free(f->gf);
+    free(f->scratch);
+    f->gf = NULL;
+    f->scratch = NULL;
+    return -1;
+  }
+  return 0;
+}
+
+static void free_field(tune_field *f)
+{
+  if (f->gf == NULL) return;
+  gf_free(f->gf, 0);
+  free(f->gf);
+  free(f->scratch);
+  f->gf = NULL;
+  f->scratch = NULL;
+}
+
+static tune_candidate *find_candidate(int w, const char *name)
+{
+  tune_candidate *c;
+
+  for (c = candidates; c->name != NULL; c++) {
+    if (c->w == w && strcmp(c->name, name) == 0) return c;
+  }
+  return NULL;
+}
+
+static double now_seconds(void)
+{
+  struct timespec ts;
+
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+static uint32_t read_word(unsigned char *p, int i, int w)
+{
+  if (w == 8) return p[i];
+  if (w == 16) return ((uint16_t *) p)[i];
+  return ((uint32_t *) p)[i];
+}
+
+/* Returns 1 if f multiplies the first words of src by multby the same way
+   the reference field does. */
+
+static int agrees(tune_field *f, gf_t *ref, int w, unsigned char *src, unsigned char *dst,
+                  int blocksize, uint32_t multby)
+{
+  int i, nwords;
+
+  nwords = blocksize / (w/8);
+  if (nwords > TUNE_CHECK_WORDS) nwords = TUNE_CHECK_WORDS;
+  f->gf->multiply_region.w32(f->gf, src, dst, multby, nwords * (w/8), 0);
+  for (i = 0; i < nwords; i++) {
+    if (read_word(dst, i, w) != ref->multiply.w32(ref, read_word(src, i, w), multby)) return 0;
+  }
+  return 1;
+}
+
+/* Returns the region-multiply rate of f in MB/s */
+
+static double time_field(tune_field *f, unsigned char *src, unsigned char *dst,
+                         int blocksize, uint32_t multby)
+{
+  double start, elapsed;
+  long iterations;
+
+  f->gf->multiply_region.w32(f->gf, src, dst, multby, blocksize, 1);
+  iterations = 0;
+  start = now_seconds();
+  do {
+    f->gf->multiply_region.w32(f->gf, src, dst, multby, blocksize, 1);
+    iterations++;
+    elapsed = now_seconds() - start;
+  } while (elapsed < TUNE_MIN_SECONDS || iterations < TUNE_MIN_ITERATIONS);
+
+  return (double) blocksize * iterations / elapsed / (1024.0 * 1024.0);
+}
+
+static int check_args(int w, int blocksize)
+{
+  if (w != 8 && w != 16 && w != 32) return -1;
+  if (blocksize <= 0 || blocksize % (w/8) != 0) return -1;
+  return 0;
+}
+
+int galois_autotune(int w, int blocksize, galois_tune_result_t *result)
+{
+  tune_candidate *c, *best_c;
+  tune_field ref, f, best;
+  unsigned char *src, *dst;
+  uint32_t multby, seed;
+  double rate, best_rate;
+  int i;
+
+  if (check_args(w, blocksize) < 0) return -1;
+
+  src = NULL;
+  dst = NULL;
+  if (posix_memalign((void **) &src, 64, blocksize) != 0) return -1;
+  if (posix_memalign((void **) &dst, 64, blocksize) != 0) {
+    free(src);
+    return -1;
+  }
+  seed = 0x9e3779b9;
+  for (i = 0; i < blocksize; i++) {
+    seed = seed * 1103515245 + 12345;
+    src[i] = seed >> 16;
+  }
+  memset(dst, 0, blocksize);
+  multby = 0xe5a3c2b7 & ((w == 32) ? 0xffffffff : ((1u << w) - 1));
+
+  best_c = find_candidate(w, "DEFAULT");
+  if (make_field(best_c, &ref) < 0) {
+    free(src);
+    free(dst);
+    return -1;
+  }
+
+  best.gf = NULL;
+  best.scratch = NULL;
+  best_rate = -1;
+  for (c = candidates; c->name != NULL; c++) {
+    if (c->w != w) continue;
+    if (make_field(c, &f) < 0) continue;
+    if (!agrees(&f, ref.gf, w, src, dst, blocksize, multby)) {
+      free_field(&f);
+      continue;
+    }
+    rate = time_field(&f, src, dst, blocksize, multby);
+    if (rate > best_rate) {
+      free_field(&best);
+      best = f;
+      best_c = c;
+      best_rate = rate;
+    } else {
+      free_field(&f);
+    }
+  }
+  free_field(&ref);
+  free(src);
+  free(dst);
+
+  if (best.gf == NULL) return -1;
+
+  /* galois_change_technique takes the gf_t; its scratch memory goes with it */
+
+  galois_change_technique(best.gf, w);
+
+  if (result != NULL) {
+    result->w = w;
+    result->blocksize = blocksize;
+    strncpy(result->technique, best_c->name, GALOIS_TUNE_NAME_LEN-1);
+    result->technique[GALOIS_TUNE_NAME_LEN-1] = '\0';
+    result->mb_per_sec = best_rate;
+    result->from_cache = 0;
+  }
+  return 0;
+}
+
+int galois_tune_install(int w, const char *name)
+{
+  tune_candidate *c;
+  tune_field f;
+
+  if (name == NULL) return -1;
+  c = find_candidate(w, name);
+  if (c == NULL) return -1;
+  if (make_field(c, &f) < 0) return -1;
+  galois_change_technique(f.gf, w);
+  return 0;
+}
+
+static void host_name(char *buf, int len)
+{
+  char *s;
+
+  if (gethostname(buf, len) != 0) strcpy(buf, "unknown");
+  buf[len-1] = '\0';
+  for (s = buf; *s != '\0'; s++) if (*s == ' ' || *s == '\t' || *s == '\n') *s = '_';
+}
+
+/* Looks up host/w/blocksize in the cache file.  Returns 1 and fills
+   technique and *rate if found. */
+
+static int cache_lookup(const char *path, const char *host, int w, int blocksize,
+                        char *technique, double *rate)
+{
+  FILE *f;
+  char line[256], h[256], t[GALOIS_TUNE_NAME_LEN];
+  int lw, lb, found;
+  double r;
+
+  f = fopen(path, "r");
+  if (f == NULL) return 0;
+  found = 0;
+  while (!found && fgets(line, sizeof(line), f) != NULL) {
+    if (sscanf(line, "%255s %d %d %31s %lf", h, &lw, &lb, t, &r) != 5) continue;
+    if (strcmp(h, host) == 0 && lw == w && lb == blocksize) {
+      strcpy(technique, t);
+      *rate = r;
+      found = 1;
+    }
+  }
+  fclose(f);
+  return found;
+}
+
+/* Rewrites the cache file with this entry in place of any old one for
+   host/w/blocksize.  The new file is renamed over the old so that readers
+   never see a partial file. */
+
+static void cache_store(const char *path, const char *host, galois_tune_result_t *r)
+{
+  FILE *in, *out;
+  char line[256], h[256], *tmp;
+  int lw, lb;
+
+  tmp = talloc(char, strlen(path) + 32);
+  if (tmp == NULL) return;
+  sprintf(tmp, "%s.tmp.%ld", path, (long) getpid());
+  out = fopen(tmp, "w");
+  if (out == NULL) {
+    free(tmp);
+    return;
+  }
+
+  in = fopen(path, "r");
+  if (in != NULL) {
+    while (fgets(line, sizeof(line), in) != NULL) {
+      if (sscanf(line, "%255s %d %d", h, &lw, &lb) == 3 &&
+          strcmp(h, host) == 0 && lw == r->w && lb == r->blocksize) continue;
+      fputs(line, out);
+    }
+    fclose(in);
+  }
+  fprintf(out, "%s %d %d %s %.1f\n", host, r->w, r->blocksize, r->technique, r->mb_per_sec);
+
+  if (fclose(out) != 0 || rename(tmp, path) != 0) remove(tmp);
+  free(tmp);
+}
+
+int galois_autotune_cached(int w, int blocksize, const char *cache_path,
+                           galois_tune_result_t *result)
+{
+  galois_tune_result_t r;
+  char host[256];
+
+  if (check_args(w, blocksize) < 0) return -1;
+  if (cache_path == NULL) return galois_autotune(w, blocksize, result);
+
+  host_name(host, sizeof(host));
+  if (cache_lookup(cache_path, host, w, blocksize, r.technique, &r.mb_per_sec) &&
+      galois_tune_install(w, r.technique) == 0) {
+    r.w = w;
+    r.blocksize = blocksize;
+    r.from_cache = 1;
+    if (result != NULL) *result = r;
+    return 0;
+  }
+
+  if (galois_autotune(w, blocksize, &r) < 0) return -1;
+  cache_store(cache_path, host, &r);
+  if (result != NULL) *result = r;
+  return 0;
+}
@@ -48,16 +48,221 @@
 #include <stdlib.h>
 #include <string.h>
 #include <assert.h>
+#include <pthread.h>
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
 
 #include "galois.h"
 #include "jerasure.h"
 
 #define talloc(type, num) (type *) malloc(sizeof(type)*(num))
 
+/* The word sizes of the matrix routines.  w = 2 and w = 4 regions hold
+   packed elements, as in galois_w04_region_multiply. */
+
+static int matrix_w(int w)
+{
+  return (w == 2 || w == 4 || w == 8 || w == 16 || w == 32);
+}
+
 static double jerasure_total_xor_bytes = 0;
 static double jerasure_total_gf_bytes = 0;
 static double jerasure_total_memcpy_bytes = 0;
 
+static int jerasure_nt_threshold = 0;
+
+void jerasure_set_nontemporal_threshold(int nbytes)
+{
+  jerasure_nt_threshold = (nbytes < 0) ? 0 : nbytes;
+}
+
+static int use_nontemporal(int size)
+{
+  return (jerasure_nt_threshold > 0 && size >= jerasure_nt_threshold);
+}
+
+static int jerasure_zero_detect = 0;
+
+void jerasure_set_zero_detection(int on)
+{
+  jerasure_zero_detect = (on != 0);
+}
+
+/* Encoders registered for one (k, m, w, matrix).  Registering and
+   unregistering must not race with jerasure_matrix_encode, so the table is
+   only locked against itself.  An unregistered slot has a NULL encode and
+   can be reused. */
+
+#define JERASURE_MAX_ENCODERS 16
+
+typedef struct {
+  int k, m, w;
+  int *matrix;
+  jerasure_encoder_fn encode;
+  void *arg;
+} registered_encoder;
+
+static registered_encoder encoders[JERASURE_MAX_ENCODERS];
+static int n_encoders = 0;
+static pthread_mutex_t encoders_lock = PTHREAD_MUTEX_INITIALIZER;
+
+int jerasure_register_matrix_encoder(int k, int m, int w, int *matrix,
+                                     jerasure_encoder_fn encode, void *arg)
+{
+  int i, *copy;
+
+  if (k <= 0 || m <= 0 || matrix == NULL || encode == NULL) return -1;
+  copy = talloc(int, k*m);
+  if (copy == NULL) return -1;
+  memcpy(copy, matrix, sizeof(int)*k*m);
+
+  pthread_mutex_lock(&encoders_lock);
+  for (i = 0; i < n_encoders && encoders[i].encode != NULL; i++) ;
+  if (i == JERASURE_MAX_ENCODERS) {
+    pthread_mutex_unlock(&encoders_lock);
+    free(copy);
+    return -1;
+  }
+  encoders[i].k = k;
+  encoders[i].m = m;
+  encoders[i].w = w;
+  encoders[i].matrix = copy;
+  encoders[i].encode = encode;
+  encoders[i].arg = arg;
+  if (i == n_encoders) n_encoders++;
+  pthread_mutex_unlock(&encoders_lock);
+  return i;
+}
+
+void jerasure_unregister_matrix_encoder(int id)
+{
+  if (id < 0 || id >= JERASURE_MAX_ENCODERS) return;
+  pthread_mutex_lock(&encoders_lock);
+  if (id < n_encoders && encoders[id].encode != NULL) {
+    free(encoders[id].matrix);
+    encoders[id].matrix = NULL;
+    encoders[id].encode = NULL;
+  }
+  pthread_mutex_unlock(&encoders_lock);
+}
+
+/* Returns 0 if a registered encoder took the call */
+
+static int registered_encode(int k, int m, int w, int *matrix,
+                             char **data_ptrs, char **coding_ptrs, int size)
+{
+  registered_encoder *e;
+  int i;
+
+  for (i = 0; i < n_encoders; i++) {
+    e = encoders+i;
+    if (e->encode == NULL || e->k != k || e->m != m || e->w != w) continue;
+    if (memcmp(e->matrix, matrix, sizeof(int)*k*m) != 0) continue;
+    if (e->encode(e->arg, data_ptrs, coding_ptrs, size) == 0) return 0;
+  }
+  return -1;
+}
+
+int jerasure_region_is_zero(char *p, int nbytes)
+{
+  int i;
+#ifdef __SSE2__
+  __m128i acc;
+
+  for (i = 0; i + 64 <= nbytes; i += 64) {
+    acc = _mm_or_si128(_mm_or_si128(_mm_loadu_si128((__m128i *) (p+i)),
+                                    _mm_loadu_si128((__m128i *) (p+i+16))),
+                       _mm_or_si128(_mm_loadu_si128((__m128i *) (p+i+32)),
+                                    _mm_loadu_si128((__m128i *) (p+i+48))));
+    if (_mm_movemask_epi8(_mm_cmpeq_epi8(acc, _mm_setzero_si128())) != 0xffff) return 0;
+  }
+#else
+  long acc, word;
+  int j;
+
+  for (i = 0; i + 8*(int)sizeof(long) <= nbytes; i += 8*sizeof(long)) {
+    acc = 0;
+    for (j = 0; j < 8; j++) {
+      memcpy(&word, p+i+j*sizeof(long), sizeof(long));
+      acc |= word;
+    }
+    if (acc != 0) return 0;
+  }
+#endif
+  for (; i < nbytes; i++) if (p[i] != 0) return 0;
+  return 1;
+}
+
+int jerasure_tile_size(int n)
+{
+  int tile;
+
+  tile = JERASURE_FUSED_CACHE / n;
+  tile -= tile % 64;
+  if (tile < 1024) tile = 1024;
+  return tile;
+}
+
+/* memcpy with non-temporal stores, so that dest does not go through the
+   cache.  Without SSE2, this is just memcpy. */
+
+static void nt_memcpy(char *dest, char *src, int nbytes)
+{
+#ifdef __SSE2__
+  int head;
+
+  head = (16 - ((unsigned long) dest & 15)) & 15;
+  if (head > nbytes) head = nbytes;
+  memcpy(dest, src, head);
+  dest += head;
+  src += head;
+  nbytes -= head;
+
+  while (nbytes >= 64) {
+    _mm_stream_si128((__m128i *) dest,      _mm_loadu_si128((__m128i *) src));
+    _mm_stream_si128((__m128i *) (dest+16), _mm_loadu_si128((__m128i *) (src+16)));
+    _mm_stream_si128((__m128i *) (dest+32), _mm_loadu_si128((__m128i *) (src+32)));
+    _mm_stream_si128((__m128i *) (dest+48), _mm_loadu_si128((__m128i *) (src+48)));
+    dest += 64;
+    src += 64;
+    nbytes -= 64;
+  }
+  while (nbytes >= 16) {
+    _mm_stream_si128((__m128i *) dest, _mm_loadu_si128((__m128i *) src));
+    dest += 16;
+    src += 16;
+    nbytes -= 16;
+  }
+  memcpy(dest, src, nbytes);
+  _mm_sfence();
+#else
+  memcpy(dest, src, nbytes);
+#endif
+}
+
+static char *alloc_scratch(int nbytes)
+{
+  void *p;
+
+  if (posix_memalign(&p, 64, nbytes) != 0) {
+    fprintf(stderr, "ERROR: jerasure cannot allocate %d bytes of scratch memory\n", nbytes);
+    assert(0);
+  }
+  return (char *) p;
+}
+
+/* Scratch regions that region multiplies from src can write into.
+   GF-Complete needs source and destination at the same address mod 16,
+   so the regions start at src's offset into the block.  Free *base. */
+
+static char *alloc_scratch_like(int nbytes, char *src, char **base)
+{
+  *base = alloc_scratch(nbytes + 16);
+  return *base + ((uintptr_t) src & 15);
+}
+
 void jerasure_print_matrix(int *m, int rows, int cols, int w)
 {
   int i, j;
@@ -172,7 +377,7 @@ int jerasure_matrix_decode(int k, int m, int w, int *matrix, int row_k_ones, int
   int *tmpids;
   int *erased, *decoding_matrix, *dm_ids;
 
-  if (w != 8 && w != 16 && w != 32) return -1;
+  if (!matrix_w(w)) return -1;
 
   erased = jerasure_erasures_to_erased(k, m, erasures);
   if (erased == NULL) return -1;
@@ -305,21 +510,160 @@ int *jerasure_matrix_to_bitmatrix(int k, int m, int w, int *matrix)
   return bitmatrix;
 }
 
+/* Computes each tile of the coding devices into a scratch buffer that stays
+   in the cache, and then streams it out with nt_memcpy. */
+
+static void matrix_encode_nontemporal(int k, int m, int w, int *matrix,
+                          char **data_ptrs, char **coding_ptrs, int size)
+{
+  char **dptrs, **sptrs, *scratch, *base;
+  int *dest_ids;
+  int i, tile, off, len;
+
+  tile = jerasure_tile_size(k+m);
+  scratch = alloc_scratch_like(tile*m, data_ptrs[0], &base);
+  dptrs = talloc(char *, k);
+  sptrs = talloc(char *, m);
+  dest_ids = talloc(int, m);
+  if (dptrs == NULL || sptrs == NULL || dest_ids == NULL) {
+    fprintf(stderr, "ERROR: jerasure_matrix_encode() cannot allocate memory\n");
+    assert(0);
+  }
+  for (i = 0; i < m; i++) {
+    sptrs[i] = scratch + i*tile;
+    dest_ids[i] = k+i;
+  }
+
+  for (off = 0; off < size; off += tile) {
+    len = size - off;
+    if (len > tile) len = tile;
+    for (i = 0; i < k; i++) dptrs[i] = data_ptrs[i] + off;
+    jerasure_matrix_multi_dotprod(k, w, m, matrix, NULL, dest_ids, dptrs, sptrs, len);
+    for (i = 0; i < m; i++) {
+      nt_memcpy(coding_ptrs[i] + off, sptrs[i], len);
+      jerasure_total_memcpy_bytes += len;
+    }
+  }
+
+  free(base);
+  free(dptrs);
+  free(sptrs);
+  free(dest_ids);
+}
+
 void jerasure_matrix_encode(int k, int m, int w, int *matrix,
                           char **data_ptrs, char **coding_ptrs, int size)
 {
   int i;
+  int *dest_ids;
   
-  if (w != 8 && w != 16 && w != 32) {
-    fprintf(stderr, "ERROR: jerasure_matrix_encode() and w is not 8, 16 or 32\n");
+  if (!matrix_w(w)) {
+    fprintf(stderr, "ERROR: jerasure_matrix_encode() and w is not 2, 4, 8, 16 or 32\n");
     assert(0);
   }
 
+  /* A registered encoder is used whenever one matches, whatever the
+     store and zero-detection modes. */
+
+  if (n_encoders > 0 && registered_encode(k, m, w, matrix, data_ptrs, coding_ptrs, size) == 0) return;
+
+  if (use_nontemporal(size)) {
+    matrix_encode_nontemporal(k, m, w, matrix, data_ptrs, coding_ptrs, size);
+    return;
+  }
+
+  /* Zero detection works on tiles, so it goes through the tiled kernel. */
+
+  if (jerasure_zero_detect) {
+    dest_ids = talloc(int, m);
+    if (dest_ids == NULL) {
+      fprintf(stderr, "ERROR: jerasure_matrix_encode() cannot allocate memory\n");
+      assert(0);
+    }
+    for (i = 0; i < m; i++) dest_ids[i] = k+i;
+    jerasure_matrix_multi_dotprod(k, w, m, matrix, NULL, dest_ids, data_ptrs, coding_ptrs, size);
+    free(dest_ids);
+    return;
+  }
+
   for (i = 0; i < m; i++) {
     jerasure_matrix_dotprod(k, w, matrix+(i*k), NULL, k+i, data_ptrs, coding_ptrs, size);
   }
 }
 
+/* Compares the m freshly computed regions in computed against the stored
+   coding regions at offset off.  On a mismatch, records the device and
+   offset of the earliest bad byte and returns -1. */
+
+static int compare_coding(int k, int m, char **computed, char **coding_ptrs, int off, int len,
+                          int *bad_device, int *bad_offset)
+{
+  int i, j, first, dev;
+
+  first = len;
+  dev = -1;
+  for (i = 0; i < m; i++) {
+    if (memcmp(computed[i], coding_ptrs[i]+off, len) == 0) continue;
+    for (j = 0; j < first; j++) {
+      if (computed[i][j] != coding_ptrs[i][off+j]) {
+        first = j;
+        dev = k+i;
+        break;
+      }
+    }
+  }
+  if (dev == -1) return 0;
+  if (bad_device != NULL) *bad_device = dev;
+  if (bad_offset != NULL) *bad_offset = off+first;
+  return -1;
+}
+
+int jerasure_matrix_verify(int k, int m, int w, int *matrix,
+                          char **data_ptrs, char **coding_ptrs, int size,
+                          int *bad_device, int *bad_offset)
+{
+  char **dptrs, **sptrs, *scratch, *base;
+  int *dest_ids;
+  int i, tile, off, len, rv;
+
+  if (!matrix_w(w)) {
+    fprintf(stderr, "ERROR: jerasure_matrix_verify() and w is not 2, 4, 8, 16 or 32\n");
+    assert(0);
+  }
+
+  /* The parity of each tile is computed into scratch, which stays in
+     cache, and compared with the stored parity before moving on. */
+
+  tile = jerasure_tile_size(k+m);
+  scratch = alloc_scratch_like(tile*m, data_ptrs[0], &base);
+  dptrs = talloc(char *, k);
+  sptrs = talloc(char *, m);
+  dest_ids = talloc(int, m);
+  if (dptrs == NULL || sptrs == NULL || dest_ids == NULL) {
+    fprintf(stderr, "ERROR: jerasure_matrix_verify() cannot allocate memory\n");
+    assert(0);
+  }
+  for (i = 0; i < m; i++) {
+    sptrs[i] = scratch + i*tile;
+    dest_ids[i] = k+i;
+  }
+
+  rv = 0;
+  for (off = 0; off < size && rv == 0; off += tile) {
+    len = size - off;
+    if (len > tile) len = tile;
+    for (i = 0; i < k; i++) dptrs[i] = data_ptrs[i] + off;
+    jerasure_matrix_multi_dotprod(k, w, m, matrix, NULL, dest_ids, dptrs, sptrs, len);
+    rv = compare_coding(k, m, sptrs, coding_ptrs, off, len, bad_device, bad_offset);
+  }
+
+  free(base);
+  free(dptrs);
+  free(sptrs);
+  free(dest_ids);
+  return rv;
+}
+
 void jerasure_bitmatrix_dotprod(int k, int w, int *bitmatrix_row,
                              int *src_ids, int dest_id,
                              char **data_ptrs, char **coding_ptrs, int size, int packetsize)
@@ -588,8 +932,8 @@ void jerasure_matrix_dotprod(int k, int w, int *matrix_row,
   char *dptr, *sptr;
   int i;
 
-  if (w != 1 && w != 8 && w != 16 && w != 32) {
-    fprintf(stderr, "ERROR: jerasure_matrix_dotprod() called and w is not 1, 8, 16 or 32\n");
+  if (w != 1 && !matrix_w(w)) {
+    fprintf(stderr, "ERROR: jerasure_matrix_dotprod() called and w is not 1, 2, 4, 8, 16 or 32\n");
     assert(0);
   }
 
@@ -631,6 +975,8 @@ void jerasure_matrix_dotprod(int k, int w, int *matrix_row,
         sptr = coding_ptrs[src_ids[i]-k];
       }
       switch (w) {
+        case 2:  galois_w02_region_multiply(sptr, matrix_row[i], size, dptr, init); break;
+        case 4:  galois_w04_region_multiply(sptr, matrix_row[i], size, dptr, init); break;
         case 8:  galois_w08_region_multiply(sptr, matrix_row[i], size, dptr, init); break;
         case 16: galois_w16_region_multiply(sptr, matrix_row[i], size, dptr, init); break;
         case 32: galois_w32_region_multiply(sptr, matrix_row[i], size, dptr, init); break;
@@ -642,6 +988,217 @@ void jerasure_matrix_dotprod(int k, int w, int *matrix_row,
 }
 
 
+/* This is jerasure_matrix_dotprod for several destinations at once.  Row r
+   of matrix (rows*k elements) produces device dest_ids[r].  The regions are
+   processed in tiles that fit in the cache, and each source tile is applied
+   to every destination before moving on, so each source is read from memory
+   only once. */
+
+void jerasure_matrix_multi_dotprod(int k, int w, int rows, int *matrix,
+                          int *src_ids, int *dest_ids,
+                          char **data_ptrs, char **coding_ptrs, int size)
+{
+  jerasure_matrix_multi_dotprod_prepared(k, w, rows, matrix, NULL, src_ids, dest_ids,
+                                         data_ptrs, coding_ptrs, size);
+}
+
+galois_prepared_t *jerasure_matrix_prepare(int rows, int cols, int w, int *matrix)
+{
+  galois_prepared_t *tables;
+  int i;
+
+  if (!matrix_w(w)) return NULL;
+  tables = talloc(galois_prepared_t, rows*cols);
+  if (tables == NULL) return NULL;
+  for (i = 0; i < rows*cols; i++) galois_prepare_multiply(matrix[i], w, tables+i);
+  return tables;
+}
+
+void jerasure_matrix_encode_prepared(int k, int m, int w, int *matrix, galois_prepared_t *tables,
+                          char **data_ptrs, char **coding_ptrs, int size)
+{
+  int *dest_ids;
+  int i;
+
+  dest_ids = talloc(int, m);
+  if (dest_ids == NULL) {
+    fprintf(stderr, "ERROR: jerasure_matrix_encode_prepared() cannot allocate memory\n");
+    assert(0);
+  }
+  for (i = 0; i < m; i++) dest_ids[i] = k+i;
+  jerasure_matrix_multi_dotprod_prepared(k, w, m, matrix, tables, NULL, dest_ids,
+                                         data_ptrs, coding_ptrs, size);
+  free(dest_ids);
+}
+
+void jerasure_matrix_multi_dotprod_prepared(int k, int w, int rows, int *matrix,
+                          galois_prepared_t *tables, int *src_ids, int *dest_ids,
+                          char **data_ptrs, char **coding_ptrs, int size)
+{
+  int tile, off, len;
+  int i, r, c;
+  char *sptr, **dptrs;
+  int *init;
+
+  if (!matrix_w(w)) {
+    fprintf(stderr, "ERROR: jerasure_matrix_multi_dotprod() called and w is not 2, 4, 8, 16 or 32\n");
+    assert(0);
+  }
+  if (rows <= 0) return;
+
+  dptrs = talloc(char *, rows);
+  init = talloc(int, rows);
+  if (dptrs == NULL || init == NULL) {
+    fprintf(stderr, "ERROR: jerasure_matrix_multi_dotprod() cannot allocate memory\n");
+    assert(0);
+  }
+
+  for (r = 0; r < rows; r++) {
+    dptrs[r] = (dest_ids[r] < k) ? data_ptrs[dest_ids[r]] : coding_ptrs[dest_ids[r]-k];
+  }
+
+  /* Size the tile so that one tile of every source and destination fits
+     in JERASURE_FUSED_CACHE bytes. */
+
+  tile = jerasure_tile_size(k + rows);
+
+  for (off = 0; off < size; off += tile) {
+    len = size - off;
+    if (len > tile) len = tile;
+
+    for (r = 0; r < rows; r++) init[r] = 0;
+
+    for (i = 0; i < k; i++) {
+      if (src_ids == NULL) {
+        sptr = data_ptrs[i];
+      } else if (src_ids[i] < k) {
+        sptr = data_ptrs[src_ids[i]];
+      } else {
+        sptr = coding_ptrs[src_ids[i]-k];
+      }
+      sptr += off;
+
+      /* A tile of zeros adds nothing, so skip it.  If every source tile of
+         a row is skipped, the row is zeroed below. */
+
+      if (jerasure_zero_detect && jerasure_region_is_zero(sptr, len)) continue;
+
+      for (r = 0; r < rows; r++) {
+        c = matrix[r*k+i];
+        if (c == 0) continue;
+        if (c == 1) {
+          if (init[r] == 0) {
+            memcpy(dptrs[r]+off, sptr, len);
+            jerasure_total_memcpy_bytes += len;
+          } else {
+            galois_region_xor(sptr, dptrs[r]+off, len);
+            jerasure_total_xor_bytes += len;
+          }
+        } else if (tables != NULL) {
+          galois_region_multiply_prepared(sptr, tables+(r*k+i), len, dptrs[r]+off, init[r]);
+          jerasure_total_gf_bytes += len;
+        } else {
+          switch (w) {
+            case 2:  galois_w02_region_multiply(sptr, c, len, dptrs[r]+off, init[r]); break;
+            case 4:  galois_w04_region_multiply(sptr, c, len, dptrs[r]+off, init[r]); break;
+            case 8:  galois_w08_region_multiply(sptr, c, len, dptrs[r]+off, init[r]); break;
+            case 16: galois_w16_region_multiply(sptr, c, len, dptrs[r]+off, init[r]); break;
+            case 32: galois_w32_region_multiply(sptr, c, len, dptrs[r]+off, init[r]); break;
+          }
+          jerasure_total_gf_bytes += len;
+        }
+        init[r] = 1;
+      }
+    }
+
+    /* A row of zeros produces zeros */
+
+    for (r = 0; r < rows; r++) {
+      if (init[r] == 0) memset(dptrs[r]+off, 0, len);
+    }
+  }
+
+  free(dptrs);
+  free(init);
+}
+
+/* Row i of the recovery matrix expresses erased device i (in increasing
+   order of id) in terms of the k survivors in dm_ids.  For data devices,
+   this is the row of the decoding matrix.  For coding devices, it is the
+   coding row multiplied by the decoding matrix. */
+
+int jerasure_make_recovery_matrix(int k, int m, int w, int *matrix, int *erased,
+                                  int *recovery_matrix, int *dest_ids, int *dm_ids)
+{
+  int *decoding_matrix;
+  int i, j, x, e, tmp;
+
+  decoding_matrix = talloc(int, k*k);
+  if (decoding_matrix == NULL) return -1;
+
+  if (jerasure_make_decoding_matrix(k, m, w, matrix, erased, decoding_matrix, dm_ids) < 0) {
+    free(decoding_matrix);
+    return -1;
+  }
+
+  e = 0;
+  for (i = 0; i < k; i++) {
+    if (erased[i]) {
+      memcpy(recovery_matrix+e*k, decoding_matrix+i*k, sizeof(int)*k);
+      dest_ids[e] = i;
+      e++;
+    }
+  }
+
+  for (i = 0; i < m; i++) {
+    if (erased[k+i]) {
+      for (j = 0; j < k; j++) {
+        tmp = 0;
+        for (x = 0; x < k; x++) {
+          tmp ^= galois_single_multiply(matrix[i*k+x], decoding_matrix[x*k+j], w);
+        }
+        recovery_matrix[e*k+j] = tmp;
+      }
+      dest_ids[e] = k+i;
+      e++;
+    }
+  }
+
+  free(decoding_matrix);
+  return e;
+}
+
+int jerasure_matrix_decode_fused(int k, int m, int w, int *matrix, int *erasures,
+                          char **data_ptrs, char **coding_ptrs, int size)
+{
+  int *erased, *recovery_matrix, *dest_ids, *dm_ids;
+  int e;
+
+  if (!matrix_w(w)) return -1;
+
+  erased = jerasure_erasures_to_erased(k, m, erasures);
+  if (erased == NULL) return -1;
+
+  recovery_matrix = talloc(int, (k+m)*k);
+  dest_ids = talloc(int, k+m);
+  dm_ids = talloc(int, k);
+  e = -1;
+  if (recovery_matrix != NULL && dest_ids != NULL && dm_ids != NULL) {
+    e = jerasure_make_recovery_matrix(k, m, w, matrix, erased, recovery_matrix, dest_ids, dm_ids);
+  }
+  if (e > 0) {
+    jerasure_matrix_multi_dotprod(k, w, e, recovery_matrix, dm_ids, dest_ids,
+                                  data_ptrs, coding_ptrs, size);
+  }
+
+  free(erased);
+  free(recovery_matrix);
+  free(dest_ids);
+  free(dm_ids);
+  return (e < 0) ? -1 : 0;
+}
+
+
 int jerasure_bitmatrix_decode(int k, int m, int w, int *bitmatrix, int row_k_ones, int *erasures,
                             char **data_ptrs, char **coding_ptrs, int size, int packetsize)
 {
@@ -730,7 +1287,7 @@ int jerasure_bitmatrix_decode(int k, int m, int w, int *bitmatrix, int row_k_one
   return 0;
 }
 
-static char **set_up_ptrs_for_scheduled_decoding(int k, int m, int *erasures, char **data_ptrs, char **coding_ptrs)
+char **jerasure_set_up_ptrs_for_scheduled_decoding(int k, int m, int *erasures, char **data_ptrs, char **coding_ptrs)
 {
   int ddf, cdf;
   int *erased;
@@ -804,7 +1361,7 @@ static int set_up_ids_for_scheduled_decoding(int k, int m, int *erasures, int *r
   erased = jerasure_erasures_to_erased(k, m, erasures);
   if (erased == NULL) return -1;
 
-  /* See set_up_ptrs_for_scheduled_decoding for how these are set */
+  /* See jerasure_set_up_ptrs_for_scheduled_decoding for how these are set */
 
   j = k;
   x = k;
@@ -833,7 +1390,7 @@ static int set_up_ids_for_scheduled_decoding(int k, int m, int *erasures, int *r
   return 0;
 }
 
-static int **jerasure_generate_decoding_schedule(int k, int m, int w, int *bitmatrix, int *erasures, int smart)
+int **jerasure_generate_decoding_schedule(int k, int m, int w, int *bitmatrix, int *erasures, int smart)
 {
   int i, j, x, drive, y, index, z;
   int *decoding_matrix, *inverse, *real_decoding_matrix;
@@ -996,7 +1553,7 @@ int jerasure_schedule_decode_lazy(int k, int m, int w, int *bitmatrix, int *eras
   char **ptrs;
   int **schedule;
  
-  ptrs = set_up_ptrs_for_scheduled_decoding(k, m, erasures, data_ptrs, coding_ptrs);
+  ptrs = jerasure_set_up_ptrs_for_scheduled_decoding(k, m, erasures, data_ptrs, coding_ptrs);
   if (ptrs == NULL) return -1;
 
   schedule = jerasure_generate_decoding_schedule(k, m, w, bitmatrix, erasures, smart);
@@ -1034,7 +1591,7 @@ int jerasure_schedule_decode_cache(int k, int m, int w, int ***scache, int *eras
 
   schedule = scache[index];
 
-  ptrs = set_up_ptrs_for_scheduled_decoding(k, m, erasures, data_ptrs, coding_ptrs);
+  ptrs = jerasure_set_up_ptrs_for_scheduled_decoding(k, m, erasures, data_ptrs, coding_ptrs);
   if (ptrs == NULL) return -1;
 
 
@@ -1231,11 +1788,31 @@ void jerasure_do_scheduled_operations(char **ptrs, int **operations, int packets
 void jerasure_schedule_encode(int k, int m, int w, int **schedule,
                                    char **data_ptrs, char **coding_ptrs, int size, int packetsize)
 {
-  char **ptr_copy;
+  char **ptr_copy, *scratch;
   int i, tdone;
 
   ptr_copy = talloc(char *, (k+m));
   for (i = 0; i < k; i++) ptr_copy[i] = data_ptrs[i];
+
+  /* With non-temporal stores, each slice of coding packets is built in a
+     scratch buffer and then streamed out. */
+
+  if (use_nontemporal(size)) {
+    scratch = alloc_scratch(m*packetsize*w);
+    for (i = 0; i < m; i++) ptr_copy[i+k] = scratch + i*packetsize*w;
+    for (tdone = 0; tdone < size; tdone += packetsize*w) {
+      jerasure_do_scheduled_operations(ptr_copy, schedule, packetsize);
+      for (i = 0; i < m; i++) {
+        nt_memcpy(coding_ptrs[i] + tdone, ptr_copy[i+k], packetsize*w);
+        jerasure_total_memcpy_bytes += packetsize*w;
+      }
+      for (i = 0; i < k; i++) ptr_copy[i] += (packetsize*w);
+    }
+    free(scratch);
+    free(ptr_copy);
+    return;
+  }
+
   for (i = 0; i < m; i++) ptr_copy[i+k] = coding_ptrs[i];
   for (tdone = 0; tdone < size; tdone += packetsize*w) {
     jerasure_do_scheduled_operations(ptr_copy, schedule, packetsize);
@@ -1243,6 +1820,37 @@ void jerasure_schedule_encode(int k, int m, int w, int **schedule,
   }
   free(ptr_copy);
 }
+
+int jerasure_schedule_verify(int k, int m, int w, int **schedule,
+                             char **data_ptrs, char **coding_ptrs, int size, int packetsize,
+                             int *bad_device, int *bad_offset)
+{
+  char **ptr_copy, *scratch;
+  int i, tdone, rv;
+
+  /* Like the non-temporal encode: each slice of coding packets is built
+     in scratch, and then compared instead of stored. */
+
+  ptr_copy = talloc(char *, (k+m));
+  if (ptr_copy == NULL) {
+    fprintf(stderr, "ERROR: jerasure_schedule_verify() cannot allocate memory\n");
+    assert(0);
+  }
+  scratch = alloc_scratch(m*packetsize*w);
+  for (i = 0; i < k; i++) ptr_copy[i] = data_ptrs[i];
+  for (i = 0; i < m; i++) ptr_copy[i+k] = scratch + i*packetsize*w;
+
+  rv = 0;
+  for (tdone = 0; tdone < size && rv == 0; tdone += packetsize*w) {
+    jerasure_do_scheduled_operations(ptr_copy, schedule, packetsize);
+    rv = compare_coding(k, m, ptr_copy+k, coding_ptrs, tdone, packetsize*w, bad_device, bad_offset);
+    for (i = 0; i < k; i++) ptr_copy[i] += (packetsize*w);
+  }
+
+  free(scratch);
+  free(ptr_copy);
+  return rv;
+}
     
 int **jerasure_dumb_bitmatrix_to_schedule(int k, int m, int w, int *bitmatrix)
 {
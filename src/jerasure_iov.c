@@ -0,0 +1,292 @@
+/* *
+ * Copyright (c) 2014, James S. Plank and Kevin Greenan
+ * All rights reserved.
+ *
+ * Jerasure - A C/C++ Library for a Variety of Reed-Solomon and RAID-6 Erasure
+ * Coding Techniques
+ *
+ * Revision 2.0: Galois Field backend now links to GF-Complete
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *  - Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ *  - Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ *
+ *  - Neither the name of the University of Tennessee nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY
+ * WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+
+#include "jerasure.h"
+#include "jerasure_iov.h"
+
+#define talloc(type, num) (type *) malloc(sizeof(type)*(num))
+
+/* A position in a segmented device. */
+
+typedef struct {
+  struct iovec *iov;
+  int iovcnt;
+  int seg;          /* Current segment */
+  size_t off;       /* Offset in the current segment */
+} iov_cursor;
+
+/* Moves past exhausted and empty segments. */
+
+static void cursor_settle(iov_cursor *c)
+{
+  while (c->seg < c->iovcnt && c->off == c->iov[c->seg].iov_len) {
+    c->seg++;
+    c->off = 0;
+  }
+}
+
+static void cursor_advance(iov_cursor *c, int nbytes)
+{
+  size_t left;
+
+  while (nbytes > 0) {
+    left = c->iov[c->seg].iov_len - c->off;
+    if ((size_t) nbytes < left) {
+      c->off += nbytes;
+      nbytes = 0;
+    } else {
+      nbytes -= left;
+      c->seg++;
+      c->off = 0;
+    }
+    cursor_settle(c);
+  }
+}
+
+/* Copies nbytes between the device at c and buf, crossing segments as
+   needed.  The cursor does not move. */
+
+static void cursor_copy(iov_cursor *c, char *buf, int nbytes, int to_device)
+{
+  iov_cursor t;
+  size_t len;
+  char *p;
+
+  t = *c;
+  while (nbytes > 0) {
+    p = (char *) t.iov[t.seg].iov_base + t.off;
+    len = t.iov[t.seg].iov_len - t.off;
+    if (len > (size_t) nbytes) len = nbytes;
+    if (to_device) {
+      memcpy(p, buf, len);
+    } else {
+      memcpy(buf, p, len);
+    }
+    buf += len;
+    nbytes -= len;
+    t.off += len;
+    cursor_settle(&t);
+  }
+}
+
+/* Sets up cursors for the k+m devices.  Returns -1 if one of them holds
+   fewer than size bytes. */
+
+static int cursors_init(int k, int m, struct iovec **data_iov, int *data_iovcnt,
+                        struct iovec **coding_iov, int *coding_iovcnt, int size,
+                        iov_cursor *c)
+{
+  int i, j;
+  size_t total;
+
+  for (i = 0; i < k+m; i++) {
+    c[i].iov = (i < k) ? data_iov[i] : coding_iov[i-k];
+    c[i].iovcnt = (i < k) ? data_iovcnt[i] : coding_iovcnt[i-k];
+    c[i].seg = 0;
+    c[i].off = 0;
+    total = 0;
+    for (j = 0; j < c[i].iovcnt; j++) total += c[i].iov[j].iov_len;
+    if (total < (size_t) size) return -1;
+    cursor_settle(c+i);
+  }
+  return 0;
+}
+
+/* GF-Complete's region multiplies need a source and destination at the
+   same address mod 16, and word aligned. */
+
+#define IOV_ALIGN 16
+#define IOV_BOUNCE_BYTES 4096
+
+static int ptrs_aligned(char **ptrs, int n, int wb)
+{
+  int i;
+  unsigned long a;
+
+  a = (unsigned long) ptrs[0] % IOV_ALIGN;
+  if (a % wb != 0) return 0;
+  for (i = 1; i < n; i++) {
+    if ((unsigned long) ptrs[i] % IOV_ALIGN != a) return 0;
+  }
+  return 1;
+}
+
+/* jerasure_matrix_multi_dotprod on segmented devices.  Each pass codes the
+   longest run, in whole words, that stays inside the current segment of
+   every device, if the devices are aligned alike there.  Otherwise, up to
+   IOV_BOUNCE_BYTES of every device are gathered into an aligned bounce
+   buffer, coded there, and the destinations are scattered back.  That
+   also covers runs shorter than a word. */
+
+static void iov_multi_dotprod(int k, int m, int w, int rows, int *matrix,
+                              int *src_ids, int *dest_ids, iov_cursor *c, int size)
+{
+  char **ptrs, *bounce;
+  size_t len, left;
+  int i, r, wb, done;
+  void *p;
+
+  wb = w/8;
+  ptrs = talloc(char *, k+m);
+  bounce = NULL;
+  if (posix_memalign(&p, IOV_ALIGN, (size_t) (k+m)*IOV_BOUNCE_BYTES) == 0) bounce = p;
+  if (ptrs == NULL || bounce == NULL) {
+    fprintf(stderr, "ERROR: jerasure_matrix_*_iov() cannot allocate memory\n");
+    assert(0);
+  }
+
+  done = 0;
+  while (done < size) {
+    len = size - done;
+    for (i = 0; i < k+m; i++) {
+      left = c[i].iov[c[i].seg].iov_len - c[i].off;
+      if (left < len) len = left;
+      ptrs[i] = (char *) c[i].iov[c[i].seg].iov_base + c[i].off;
+    }
+    len -= len % wb;
+
+    if (len > 0 && ptrs_aligned(ptrs, k+m, wb)) {
+      jerasure_matrix_multi_dotprod(k, w, rows, matrix, src_ids, dest_ids,
+                                    ptrs, ptrs+k, (int) len);
+    } else {
+      len = size - done;
+      if (len > IOV_BOUNCE_BYTES) len = IOV_BOUNCE_BYTES;
+      for (i = 0; i < k+m; i++) {
+        ptrs[i] = bounce + i*IOV_BOUNCE_BYTES;
+        cursor_copy(c+i, ptrs[i], (int) len, 0);
+      }
+      jerasure_matrix_multi_dotprod(k, w, rows, matrix, src_ids, dest_ids,
+                                    ptrs, ptrs+k, (int) len);
+      for (r = 0; r < rows; r++) {
+        cursor_copy(c+dest_ids[r], ptrs[dest_ids[r]], (int) len, 1);
+      }
+    }
+
+    for (i = 0; i < k+m; i++) cursor_advance(c+i, (int) len);
+    done += (int) len;
+  }
+
+  free(ptrs);
+  free(bounce);
+}
+
+static void check_args(char *fn, int w, int size)
+{
+  if (w != 8 && w != 16 && w != 32) {
+    fprintf(stderr, "ERROR: %s() called and w is not 8, 16 or 32\n", fn);
+    assert(0);
+  }
+  if (size % (w/8) != 0) {
+    fprintf(stderr, "ERROR: %s() called and size is not a multiple of w/8\n", fn);
+    assert(0);
+  }
+}
+
+void jerasure_matrix_encode_iov(int k, int m, int w, int *matrix,
+                                struct iovec **data_iov, int *data_iovcnt,
+                                struct iovec **coding_iov, int *coding_iovcnt, int size)
+{
+  iov_cursor *c;
+  int *dest_ids;
+  int i;
+
+  check_args("jerasure_matrix_encode_iov", w, size);
+
+  c = talloc(iov_cursor, k+m);
+  dest_ids = talloc(int, m);
+  if (c == NULL || dest_ids == NULL) {
+    fprintf(stderr, "ERROR: jerasure_matrix_encode_iov() cannot allocate memory\n");
+    assert(0);
+  }
+  if (cursors_init(k, m, data_iov, data_iovcnt, coding_iov, coding_iovcnt, size, c) < 0) {
+    fprintf(stderr, "ERROR: jerasure_matrix_encode_iov() called and a device is shorter than size\n");
+    assert(0);
+  }
+
+  for (i = 0; i < m; i++) dest_ids[i] = k+i;
+  iov_multi_dotprod(k, m, w, m, matrix, NULL, dest_ids, c, size);
+
+  free(c);
+  free(dest_ids);
+}
+
+int jerasure_matrix_decode_iov(int k, int m, int w, int *matrix, int *erasures,
+                               struct iovec **data_iov, int *data_iovcnt,
+                               struct iovec **coding_iov, int *coding_iovcnt, int size)
+{
+  iov_cursor *c;
+  int *erased, *recovery_matrix, *dest_ids, *dm_ids;
+  int e;
+
+  check_args("jerasure_matrix_decode_iov", w, size);
+
+  c = talloc(iov_cursor, k+m);
+  if (c == NULL) return -1;
+  if (cursors_init(k, m, data_iov, data_iovcnt, coding_iov, coding_iovcnt, size, c) < 0) {
+    free(c);
+    return -1;
+  }
+
+  erased = jerasure_erasures_to_erased(k, m, erasures);
+  if (erased == NULL) {
+    free(c);
+    return -1;
+  }
+
+  recovery_matrix = talloc(int, (k+m)*k);
+  dest_ids = talloc(int, k+m);
+  dm_ids = talloc(int, k);
+  e = -1;
+  if (recovery_matrix != NULL && dest_ids != NULL && dm_ids != NULL) {
+    e = jerasure_make_recovery_matrix(k, m, w, matrix, erased, recovery_matrix, dest_ids, dm_ids);
+  }
+  if (e > 0) iov_multi_dotprod(k, m, w, e, recovery_matrix, dm_ids, dest_ids, c, size);
+
+  free(c);
+  free(erased);
+  free(recovery_matrix);
+  free(dest_ids);
+  free(dm_ids);
+  return (e < 0) ? -1 : 0;
+}
@@ -0,0 +1,843 @@
+/* *
+ * Copyright (c) 2014, James S. Plank and Kevin Greenan
+ * All rights reserved.
+ *
+ * Jerasure - A C/C++ Library for a Variety of Reed-Solomon and RAID-6 Erasure
+ * Coding Techniques
+ *
+ * Revision 2.0: Galois Field backend now links to GF-Complete
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *  - Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ *  - Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ *
+ *  - Neither the name of the University of Tennessee nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY
+ * WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#ifdef __linux__
+#define _GNU_SOURCE
+#endif
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+#include <pthread.h>
+#include <sched.h>
+#include <dirent.h>
+#include <unistd.h>
+#include <sys/mman.h>
+
+#if defined(HAVE_LIBNUMA) && defined(HAVE_NUMA_H)
+#define USE_LIBNUMA
+#include <numa.h>
+#endif
+
+#include "galois.h"
+#include "jerasure.h"
+#include "jerasure_mt.h"
+
+#define talloc(type, num) (type *) malloc(sizeof(type)*(num))
+
+struct jerasure_mt_pool {
+  int nthreads;                 /* Threads that run tasks */
+  int policy;                   /* JERASURE_MT_AFFINITY_xxx */
+  int caller_works;             /* Whether the calling thread is thread 0 */
+  int nworkers;                 /* Worker threads that were started */
+  pthread_t *workers;
+  int *cpus;                    /* CPU of each thread, or -1 */
+  int *nodes;                   /* NUMA node of each thread, or -1 */
+  pthread_mutex_t call_lock;    /* Serializes jerasure_mt_parallel_for */
+  pthread_mutex_t lock;         /* Protects everything below */
+  pthread_cond_t work_cv;
+  pthread_cond_t done_cv;
+  void (*fn)(void *arg, int task, int thread);
+  void *arg;
+  int ntasks;
+  int next;
+  int finished;
+  unsigned long generation;
+  int shutdown;
+};
+
+typedef struct {
+  jerasure_mt_pool_t *pool;
+  int id;
+} worker_arg;
+
+/* ------------------------------------------------------------ */
+/* Topology */
+
+/* Returns the NUMA node of each CPU in cpu_node[0..ncpus-1] (-1 if
+   unknown).  This uses libnuma when we have it, and otherwise reads the
+   node cpulists from sysfs. */
+
+static void get_cpu_nodes(int *cpu_node, int ncpus)
+{
+  int i;
+#ifdef USE_LIBNUMA
+  int use_libnuma = (numa_available() >= 0);
+#endif
+
+  for (i = 0; i < ncpus; i++) cpu_node[i] = -1;
+
+#ifdef USE_LIBNUMA
+  if (use_libnuma) {
+    for (i = 0; i < ncpus; i++) cpu_node[i] = numa_node_of_cpu(i);
+    return;
+  }
+#endif
+
+#ifdef __linux__
+  {
+    DIR *d;
+    struct dirent *de;
+    FILE *f;
+    char fn[300];
+    int node, lo, hi, n;
+    char sep;
+
+    d = opendir("/sys/devices/system/node");
+    if (d == NULL) return;
+    while ((de = readdir(d)) != NULL) {
+      if (sscanf(de->d_name, "node%d", &node) != 1) continue;
+      sprintf(fn, "/sys/devices/system/node/node%d/cpulist", node);
+      f = fopen(fn, "r");
+      if (f == NULL) continue;
+
+      /* The format is ranges separated by commas: "0-3,8-11" */
+
+      while (fscanf(f, "%d", &lo) == 1) {
+        hi = lo;
+        n = fscanf(f, "%c", &sep);
+        if (n == 1 && sep == '-') {
+          if (fscanf(f, "%d", &hi) != 1) break;
+          n = fscanf(f, "%c", &sep);
+        }
+        for (i = lo; i <= hi && i < ncpus; i++) if (i >= 0) cpu_node[i] = node;
+        if (n != 1 || sep != ',') break;
+      }
+      fclose(f);
+    }
+    closedir(d);
+  }
+#endif
+}
+
+/* Picks the CPU and node for each of the nthreads threads, according to the
+   policy.  Only the CPUs that the process may run on are used. */
+
+static void place_threads(jerasure_mt_pool_t *pool)
+{
+  int i;
+
+  for (i = 0; i < pool->nthreads; i++) {
+    pool->cpus[i] = -1;
+    pool->nodes[i] = -1;
+  }
+  if (pool->policy == JERASURE_MT_AFFINITY_NONE) return;
+
+#ifdef __linux__
+  {
+    cpu_set_t allowed;
+    int *cpu_node, *cpus, *used, *order;
+    int ncpus, nnodes, node, c, t, n;
+
+    if (sched_getaffinity(0, sizeof(cpu_set_t), &allowed) != 0) return;
+
+    cpu_node = talloc(int, CPU_SETSIZE);
+    cpus = talloc(int, CPU_SETSIZE);
+    used = talloc(int, CPU_SETSIZE);
+    order = talloc(int, CPU_SETSIZE);
+    if (cpu_node == NULL || cpus == NULL || used == NULL || order == NULL) {
+      free(cpu_node);
+      free(cpus);
+      free(used);
+      free(order);
+      return;
+    }
+    get_cpu_nodes(cpu_node, CPU_SETSIZE);
+    for (c = 0; c < CPU_SETSIZE; c++) if (cpu_node[c] < 0) cpu_node[c] = 0;
+
+    ncpus = 0;
+    nnodes = 0;
+    for (c = 0; c < CPU_SETSIZE; c++) {
+      if (CPU_ISSET(c, &allowed)) {
+        cpus[ncpus++] = c;
+        if (cpu_node[c] >= nnodes) nnodes = cpu_node[c]+1;
+      }
+    }
+    if (ncpus == 0) nnodes = 0;
+
+    if (pool->policy == JERASURE_MT_AFFINITY_COMPACT || nnodes <= 1) {
+
+      /* Thread i goes on the i-th allowed CPU */
+
+      for (t = 0; t < pool->nthreads && ncpus > 0; t++) {
+        pool->cpus[t] = cpus[t % ncpus];
+        pool->nodes[t] = cpu_node[pool->cpus[t]];
+      }
+
+    } else {
+
+      /* Order the CPUs by taking one from each node in turn, and give
+         thread i the i-th CPU of that order. */
+
+      n = 0;
+      for (c = 0; c < ncpus; c++) used[c] = 0;
+      while (n < ncpus) {
+        for (node = 0; node < nnodes; node++) {
+          for (c = 0; c < ncpus; c++) {
+            if (!used[c] && cpu_node[cpus[c]] == node) break;
+          }
+          if (c < ncpus) {
+            used[c] = 1;
+            order[n++] = cpus[c];
+          }
+        }
+      }
+      for (t = 0; t < pool->nthreads; t++) {
+        pool->cpus[t] = order[t % ncpus];
+        pool->nodes[t] = cpu_node[pool->cpus[t]];
+      }
+    }
+
+    free(cpu_node);
+    free(cpus);
+    free(used);
+    free(order);
+  }
+#endif
+}
+
+static void pin_self(int cpu)
+{
+#ifdef __linux__
+  cpu_set_t set;
+
+  if (cpu < 0) return;
+  CPU_ZERO(&set);
+  CPU_SET(cpu, &set);
+  pthread_setaffinity_np(pthread_self(), sizeof(cpu_set_t), &set);
+#else
+  (void) cpu;
+#endif
+}
+
+/* ------------------------------------------------------------ */
+/* The pool */
+
+/* Grabs tasks until there are none left.  Called with pool->lock held, and
+   returns with it held. */
+
+static void run_tasks(jerasure_mt_pool_t *pool, int id)
+{
+  int task;
+
+  while (pool->next < pool->ntasks) {
+    task = pool->next++;
+    pthread_mutex_unlock(&pool->lock);
+    pool->fn(pool->arg, task, id);
+    pthread_mutex_lock(&pool->lock);
+    pool->finished++;
+    if (pool->finished == pool->ntasks) pthread_cond_signal(&pool->done_cv);
+  }
+}
+
+/* In pinned pools, thread id always gets the same contiguous block of tasks,
+   so that it touches the same part of the regions each time. */
+
+static void run_block(jerasure_mt_pool_t *pool, int id)
+{
+  int task, first, last;
+
+  first = (int) (((long) pool->ntasks * id) / pool->nthreads);
+  last = (int) (((long) pool->ntasks * (id+1)) / pool->nthreads);
+  if (first == last) return;
+
+  pthread_mutex_unlock(&pool->lock);
+  for (task = first; task < last; task++) pool->fn(pool->arg, task, id);
+  pthread_mutex_lock(&pool->lock);
+  pool->finished += (last - first);
+  if (pool->finished == pool->ntasks) pthread_cond_signal(&pool->done_cv);
+}
+
+static void run_share(jerasure_mt_pool_t *pool, int id)
+{
+  if (pool->policy == JERASURE_MT_AFFINITY_NONE) {
+    run_tasks(pool, id);
+  } else {
+    run_block(pool, id);
+  }
+}
+
+static void *worker_main(void *v)
+{
+  worker_arg *wa = (worker_arg *) v;
+  jerasure_mt_pool_t *pool = wa->pool;
+  int id = wa->id;
+  unsigned long seen;
+
+  free(wa);
+  pin_self(pool->cpus[id]);
+
+  /* Workers are started before the first job is posted, so begin at the
+     pool's initial generation rather than reading it here: a worker that is
+     slow to start must still run its share of the first job. */
+
+  seen = 0;
+  pthread_mutex_lock(&pool->lock);
+  while (!pool->shutdown) {
+    if (pool->generation != seen) {
+      seen = pool->generation;
+      run_share(pool, id);
+    } else {
+      pthread_cond_wait(&pool->work_cv, &pool->lock);
+    }
+  }
+  pthread_mutex_unlock(&pool->lock);
+  return NULL;
+}
+
+jerasure_mt_pool_t *jerasure_mt_pool_create_affinity(int nthreads, int policy)
+{
+  jerasure_mt_pool_t *pool;
+  worker_arg *wa;
+  int i;
+
+  if (policy != JERASURE_MT_AFFINITY_NONE &&
+      policy != JERASURE_MT_AFFINITY_COMPACT &&
+      policy != JERASURE_MT_AFFINITY_SCATTER) return NULL;
+
+  if (nthreads <= 0) {
+    nthreads = (int) sysconf(_SC_NPROCESSORS_ONLN);
+    if (nthreads <= 0) nthreads = 1;
+  }
+
+  pool = talloc(jerasure_mt_pool_t, 1);
+  if (pool == NULL) return NULL;
+  memset(pool, 0, sizeof(jerasure_mt_pool_t));
+  pool->nthreads = nthreads;
+  pool->policy = policy;
+
+  /* The calling thread can't be pinned, so it only works in unpinned pools */
+
+  pool->caller_works = (policy == JERASURE_MT_AFFINITY_NONE);
+
+  pool->workers = talloc(pthread_t, nthreads);
+  pool->cpus = talloc(int, nthreads);
+  pool->nodes = talloc(int, nthreads);
+  if (pool->workers == NULL || pool->cpus == NULL || pool->nodes == NULL) {
+    free(pool->workers);
+    free(pool->cpus);
+    free(pool->nodes);
+    free(pool);
+    return NULL;
+  }
+
+  pthread_mutex_init(&pool->call_lock, NULL);
+  pthread_mutex_init(&pool->lock, NULL);
+  pthread_cond_init(&pool->work_cv, NULL);
+  pthread_cond_init(&pool->done_cv, NULL);
+
+  place_threads(pool);
+
+  /* pool->nworkers only counts workers that actually started, so
+     that destroy joins the right ones. */
+
+  for (i = (pool->caller_works) ? 1 : 0; i < nthreads; i++) {
+    wa = talloc(worker_arg, 1);
+    if (wa == NULL) break;
+    wa->pool = pool;
+    wa->id = i;
+    if (pthread_create(&pool->workers[pool->nworkers], NULL, worker_main, wa) != 0) {
+      free(wa);
+      break;
+    }
+    pool->nworkers++;
+  }
+
+  if (i != nthreads) {
+    jerasure_mt_pool_destroy(pool);
+    return NULL;
+  }
+  return pool;
+}
+
+jerasure_mt_pool_t *jerasure_mt_pool_create(int nthreads)
+{
+  return jerasure_mt_pool_create_affinity(nthreads, JERASURE_MT_AFFINITY_NONE);
+}
+
+void jerasure_mt_pool_destroy(jerasure_mt_pool_t *pool)
+{
+  int i;
+
+  if (pool == NULL) return;
+
+  pthread_mutex_lock(&pool->lock);
+  pool->shutdown = 1;
+  pthread_cond_broadcast(&pool->work_cv);
+  pthread_mutex_unlock(&pool->lock);
+
+  for (i = 0; i < pool->nworkers; i++) pthread_join(pool->workers[i], NULL);
+
+  pthread_cond_destroy(&pool->done_cv);
+  pthread_cond_destroy(&pool->work_cv);
+  pthread_mutex_destroy(&pool->lock);
+  pthread_mutex_destroy(&pool->call_lock);
+  free(pool->workers);
+  free(pool->cpus);
+  free(pool->nodes);
+  free(pool);
+}
+
+int jerasure_mt_pool_size(jerasure_mt_pool_t *pool)
+{
+  return (pool == NULL) ? 1 : pool->nthreads;
+}
+
+int jerasure_mt_thread_cpu(jerasure_mt_pool_t *pool, int thread)
+{
+  if (pool == NULL || thread < 0 || thread >= pool->nthreads) return -1;
+  return pool->cpus[thread];
+}
+
+int jerasure_mt_thread_node(jerasure_mt_pool_t *pool, int thread)
+{
+  if (pool == NULL || thread < 0 || thread >= pool->nthreads) return -1;
+  return pool->nodes[thread];
+}
+
+void jerasure_mt_parallel_for(jerasure_mt_pool_t *pool, int ntasks,
+                              void (*fn)(void *arg, int task, int thread), void *arg)
+{
+  int i;
+
+  if (ntasks <= 0) return;
+
+  if (pool == NULL || (pool->caller_works && (pool->nthreads == 1 || ntasks == 1))) {
+    for (i = 0; i < ntasks; i++) fn(arg, i, 0);
+    return;
+  }
+
+  pthread_mutex_lock(&pool->call_lock);
+  pthread_mutex_lock(&pool->lock);
+  pool->fn = fn;
+  pool->arg = arg;
+  pool->ntasks = ntasks;
+  pool->next = 0;
+  pool->finished = 0;
+  pool->generation++;
+  pthread_cond_broadcast(&pool->work_cv);
+
+  /* In unpinned pools, the calling thread is thread 0 and works too */
+
+  if (pool->caller_works) run_share(pool, 0);
+  while (pool->finished < pool->ntasks) pthread_cond_wait(&pool->done_cv, &pool->lock);
+
+  pool->fn = NULL;
+  pool->arg = NULL;
+  pthread_mutex_unlock(&pool->lock);
+  pthread_mutex_unlock(&pool->call_lock);
+}
+
+/* ------------------------------------------------------------ */
+/* Buffers */
+
+typedef struct {
+  char *buf;
+  int n;
+  int size;
+  int tile;
+} touch_job;
+
+static void touch_tile(void *v, int task, int thread)
+{
+  touch_job *j = (touch_job *) v;
+  int i, off, len;
+
+  (void) thread;
+  off = task * j->tile;
+  len = j->size - off;
+  if (len > j->tile) len = j->tile;
+  for (i = 0; i < j->n; i++) memset(j->buf + (long) i*j->size + off, 0, len);
+}
+
+char *jerasure_mt_alloc(jerasure_mt_pool_t *pool, int n, int size)
+{
+  touch_job j;
+  void *p;
+  long total;
+
+  if (n <= 0 || size <= 0) return NULL;
+  total = (long) n * size;
+
+  /* mmap gives us pages that have not been touched yet, so they are placed
+     on the node of the thread that zeros them. */
+
+  p = mmap(NULL, total, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+  if (p == MAP_FAILED) return NULL;
+
+  j.buf = (char *) p;
+  j.n = n;
+  j.size = size;
+  j.tile = jerasure_mt_tile_size(pool, size);
+  jerasure_mt_parallel_for(pool, (size + j.tile - 1) / j.tile, touch_tile, &j);
+  return (char *) p;
+}
+
+void jerasure_mt_free(char *buf, int n, int size)
+{
+  if (buf != NULL) munmap(buf, (long) n * size);
+}
+
+/* Aim for a few tiles per thread so that the load balances, but don't
+   make them so small that the per-tile overhead shows. */
+
+int jerasure_mt_tile_size(jerasure_mt_pool_t *pool, int size)
+{
+  int tile, nthreads;
+
+  nthreads = jerasure_mt_pool_size(pool);
+  if (nthreads == 1) {
+    tile = size;
+  } else {
+    tile = size / (nthreads * 4);
+    if (tile < JERASURE_MT_MIN_TILE) tile = JERASURE_MT_MIN_TILE;
+  }
+  tile = ((tile + JERASURE_MT_ALIGN - 1) / JERASURE_MT_ALIGN) * JERASURE_MT_ALIGN;
+  if (tile <= 0) tile = JERASURE_MT_ALIGN;
+  return tile;
+}
+
+/* ------------------------------------------------------------ */
+/* Matrix encoding */
+
+typedef struct {
+  int k, m, w;
+  int *matrix;
+  int *dest_ids;
+  char **data_ptrs;
+  char **coding_ptrs;
+  int size;
+  int tile;
+  char **tptrs;           /* (k+m) tile pointers per thread */
+} encode_job;
+
+static void encode_tile(void *v, int task, int thread)
+{
+  encode_job *j = (encode_job *) v;
+  char **dptrs, **cptrs;
+  int i, off, len;
+
+  off = task * j->tile;
+  len = j->size - off;
+  if (len > j->tile) len = j->tile;
+
+  dptrs = j->tptrs + thread*(j->k+j->m);
+  cptrs = dptrs + j->k;
+  for (i = 0; i < j->k; i++) dptrs[i] = j->data_ptrs[i] + off;
+  for (i = 0; i < j->m; i++) cptrs[i] = j->coding_ptrs[i] + off;
+
+  jerasure_matrix_multi_dotprod(j->k, j->w, j->m, j->matrix, NULL, j->dest_ids, dptrs, cptrs, len);
+}
+
+void jerasure_matrix_encode_mt(jerasure_mt_pool_t *pool,
+                               int k, int m, int w, int *matrix,
+                               char **data_ptrs, char **coding_ptrs, int size)
+{
+  encode_job j;
+  int i;
+
+  if (w != 8 && w != 16 && w != 32) {
+    fprintf(stderr, "ERROR: jerasure_matrix_encode_mt() and w is not 8, 16 or 32\n");
+    assert(0);
+  }
+
+  /* Pay the field setup cost here rather than in the first worker */
+
+  galois_warmup(w);
+
+  j.dest_ids = talloc(int, m);
+  j.tptrs = talloc(char *, (k+m)*jerasure_mt_pool_size(pool));
+  if (j.dest_ids == NULL || j.tptrs == NULL) {
+    fprintf(stderr, "ERROR: jerasure_matrix_encode_mt() cannot allocate memory\n");
+    assert(0);
+  }
+  for (i = 0; i < m; i++) j.dest_ids[i] = k+i;
+
+  j.k = k;
+  j.m = m;
+  j.w = w;
+  j.matrix = matrix;
+  j.data_ptrs = data_ptrs;
+  j.coding_ptrs = coding_ptrs;
+  j.size = size;
+  j.tile = jerasure_mt_tile_size(pool, size);
+
+  jerasure_mt_parallel_for(pool, (size + j.tile - 1) / j.tile, encode_tile, &j);
+
+  free(j.dest_ids);
+  free(j.tptrs);
+}
+
+/* ------------------------------------------------------------ */
+/* Matrix decoding */
+
+/* Each tile is decoded with jerasure_matrix_multi_dotprod and the recovery
+   matrix, which rebuilds the erased data and coding devices of the tile in
+   one pass over the survivors. */
+
+typedef struct {
+  int k, m, w;
+  int e;
+  int *recovery_matrix;
+  int *dest_ids;
+  int *dm_ids;
+  char **data_ptrs;
+  char **coding_ptrs;
+  int size;
+  int tile;
+  char **tptrs;           /* (k+m) tile pointers per thread */
+} decode_job;
+
+static void decode_tile(void *v, int task, int thread)
+{
+  decode_job *j = (decode_job *) v;
+  char **dptrs, **cptrs;
+  int i, off, len;
+
+  off = task * j->tile;
+  len = j->size - off;
+  if (len > j->tile) len = j->tile;
+
+  dptrs = j->tptrs + thread*(j->k+j->m);
+  cptrs = dptrs + j->k;
+  for (i = 0; i < j->k; i++) dptrs[i] = j->data_ptrs[i] + off;
+  for (i = 0; i < j->m; i++) cptrs[i] = j->coding_ptrs[i] + off;
+
+  jerasure_matrix_multi_dotprod(j->k, j->w, j->e, j->recovery_matrix, j->dm_ids, j->dest_ids,
+                                dptrs, cptrs, len);
+}
+
+int jerasure_matrix_decode_mt(jerasure_mt_pool_t *pool,
+                              int k, int m, int w,
+                              int *matrix, int row_k_ones, int *erasures,
+                              char **data_ptrs, char **coding_ptrs, int size)
+{
+  decode_job j;
+  int e, ntasks, rv;
+  int *erased, *recovery_matrix, *dest_ids, *dm_ids;
+  char **tptrs;
+
+  /* row_k_ones is not needed: every erased device is rebuilt from the
+     survivors directly. */
+
+  (void) row_k_ones;
+
+  if (w != 8 && w != 16 && w != 32) return -1;
+
+  erased = jerasure_erasures_to_erased(k, m, erasures);
+  if (erased == NULL) return -1;
+
+  rv = -1;
+  recovery_matrix = talloc(int, (k+m)*k);
+  dest_ids = talloc(int, k+m);
+  dm_ids = talloc(int, k);
+  tptrs = talloc(char *, (k+m)*jerasure_mt_pool_size(pool));
+  if (recovery_matrix == NULL || dest_ids == NULL || dm_ids == NULL || tptrs == NULL) goto done;
+
+  e = jerasure_make_recovery_matrix(k, m, w, matrix, erased, recovery_matrix, dest_ids, dm_ids);
+  if (e < 0) goto done;
+
+  rv = 0;
+  if (e == 0) goto done;
+
+  j.k = k;
+  j.m = m;
+  j.w = w;
+  j.e = e;
+  j.recovery_matrix = recovery_matrix;
+  j.dest_ids = dest_ids;
+  j.dm_ids = dm_ids;
+  j.data_ptrs = data_ptrs;
+  j.coding_ptrs = coding_ptrs;
+  j.size = size;
+  j.tile = jerasure_mt_tile_size(pool, size);
+  j.tptrs = tptrs;
+
+  ntasks = (size + j.tile - 1) / j.tile;
+  jerasure_mt_parallel_for(pool, ntasks, decode_tile, &j);
+
+done:
+  free(tptrs);
+  free(erased);
+  free(recovery_matrix);
+  free(dest_ids);
+  free(dm_ids);
+  return rv;
+}
+
+/* ------------------------------------------------------------ */
+/* Schedules */
+
+typedef struct {
+  int nptrs;
+  char **ptrs;
+  int **schedule;
+  int packetsize;
+  int slice;              /* w*packetsize */
+  int slices_per_task;
+  int nslices;
+  char **tptrs;           /* nptrs pointers per thread */
+} schedule_job;
+
+static void schedule_task(void *v, int task, int thread)
+{
+  schedule_job *j = (schedule_job *) v;
+  char **ptrs;
+  int i, s, first, last, off;
+
+  first = task * j->slices_per_task;
+  last = first + j->slices_per_task;
+  if (last > j->nslices) last = j->nslices;
+  off = first * j->slice;
+
+  ptrs = j->tptrs + thread*j->nptrs;
+  for (i = 0; i < j->nptrs; i++) ptrs[i] = j->ptrs[i] + off;
+
+  for (s = first; s < last; s++) {
+    jerasure_do_scheduled_operations(ptrs, j->schedule, j->packetsize);
+    for (i = 0; i < j->nptrs; i++) ptrs[i] += j->slice;
+  }
+}
+
+static int run_schedule(jerasure_mt_pool_t *pool, int nptrs, char **ptrs, int **schedule,
+                        int w, int size, int packetsize)
+{
+  schedule_job j;
+  int tile, ntasks;
+
+  j.nptrs = nptrs;
+  j.ptrs = ptrs;
+  j.schedule = schedule;
+  j.packetsize = packetsize;
+  j.slice = packetsize*w;
+  j.nslices = (size + j.slice - 1) / j.slice;
+  if (j.nslices == 0) return 0;
+
+  tile = jerasure_mt_tile_size(pool, size);
+  j.slices_per_task = tile / j.slice;
+  if (j.slices_per_task < 1) j.slices_per_task = 1;
+
+  j.tptrs = talloc(char *, nptrs*jerasure_mt_pool_size(pool));
+  if (j.tptrs == NULL) return -1;
+
+  ntasks = (j.nslices + j.slices_per_task - 1) / j.slices_per_task;
+  jerasure_mt_parallel_for(pool, ntasks, schedule_task, &j);
+
+  free(j.tptrs);
+  return 0;
+}
+
+void jerasure_schedule_encode_mt(jerasure_mt_pool_t *pool,
+                                 int k, int m, int w, int **schedule,
+                                 char **data_ptrs, char **coding_ptrs, int size, int packetsize)
+{
+  char **ptrs;
+  int i;
+
+  ptrs = talloc(char *, k+m);
+  if (ptrs == NULL) {
+    fprintf(stderr, "jerasure_schedule_encode_mt - cannot allocate memory\n");
+    assert(0);
+  }
+  for (i = 0; i < k; i++) ptrs[i] = data_ptrs[i];
+  for (i = 0; i < m; i++) ptrs[i+k] = coding_ptrs[i];
+
+  if (run_schedule(pool, k+m, ptrs, schedule, w, size, packetsize) < 0) {
+    fprintf(stderr, "jerasure_schedule_encode_mt - cannot allocate memory\n");
+    assert(0);
+  }
+  free(ptrs);
+}
+
+int jerasure_schedule_decode_lazy_mt(jerasure_mt_pool_t *pool,
+                                     int k, int m, int w, int *bitmatrix, int *erasures,
+                                     char **data_ptrs, char **coding_ptrs, int size, int packetsize,
+                                     int smart)
+{
+  char **ptrs;
+  int **schedule;
+  int rv;
+
+  ptrs = jerasure_set_up_ptrs_for_scheduled_decoding(k, m, erasures, data_ptrs, coding_ptrs);
+  if (ptrs == NULL) return -1;
+
+  schedule = jerasure_generate_decoding_schedule(k, m, w, bitmatrix, erasures, smart);
+  if (schedule == NULL) {
+    free(ptrs);
+    return -1;
+  }
+
+  rv = run_schedule(pool, k+m, ptrs, schedule, w, size, packetsize);
+
+  jerasure_free_schedule(schedule);
+  free(ptrs);
+  return rv;
+}
+
+int jerasure_schedule_decode_cache_mt(jerasure_mt_pool_t *pool,
+                                      int k, int m, int w, int ***scache, int *erasures,
+                                      char **data_ptrs, char **coding_ptrs, int size, int packetsize)
+{
+  char **ptrs;
+  int **schedule;
+  int index, rv;
+
+  if (erasures[1] == -1) {
+    index = erasures[0]*(k+m) + erasures[0];
+  } else if (erasures[2] == -1) {
+    index = erasures[0]*(k+m) + erasures[1];
+  } else {
+    return -1;
+  }
+
+  schedule = scache[index];
+
+  ptrs = jerasure_set_up_ptrs_for_scheduled_decoding(k, m, erasures, data_ptrs, coding_ptrs);
+  if (ptrs == NULL) return -1;
+
+  rv = run_schedule(pool, k+m, ptrs, schedule, w, size, packetsize);
+
+  free(ptrs);
+  return rv;
+}
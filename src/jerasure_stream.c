@@ -0,0 +1,218 @@
+/* *
+ * Copyright (c) 2014, James S. Plank and Kevin Greenan
+ * All rights reserved.
+ *
+ * Jerasure - A C/C++ Library for a Variety of Reed-Solomon and RAID-6 Erasure
+ * Coding Techniques
+ *
+ * Revision 2.0: Galois Field backend now links to GF-Complete
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *  - Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ *  - Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ *
+ *  - Neither the name of the University of Tennessee nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY
+ * WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "jerasure.h"
+#include "jerasure_stripe.h"
+#include "jerasure_stream.h"
+
+#define talloc(type, num) (type *) malloc(sizeof(type)*(num))
+
+struct jerasure_stream {
+  int k, m, w;
+  int *matrix;                 /* Matrix streams */
+  int **schedule;              /* Schedule streams */
+  int packetsize;
+  int blocksize;
+  int granule;                 /* Blocksizes must be multiples of this */
+  jerasure_stream_callback callback;
+  void *arg;
+  jerasure_stripe_t *stripe;   /* Where partial stripes are collected */
+  int fill;                    /* Bytes of the current stripe so far */
+  long nstripes;
+  char **direct;               /* Data pointers into the caller's buffer */
+};
+
+static jerasure_stream_t *stream_create(int k, int m, int w, int *matrix, int **schedule,
+                                        int blocksize, int packetsize, int granule,
+                                        jerasure_stream_callback callback, void *arg)
+{
+  jerasure_stream_t *s;
+
+  if (k <= 0 || m <= 0 || blocksize <= 0 || blocksize % granule != 0 || callback == NULL) {
+    return NULL;
+  }
+
+  s = talloc(jerasure_stream_t, 1);
+  if (s == NULL) return NULL;
+  s->k = k;
+  s->m = m;
+  s->w = w;
+  s->matrix = matrix;
+  s->schedule = schedule;
+  s->packetsize = packetsize;
+  s->blocksize = blocksize;
+  s->granule = granule;
+  s->callback = callback;
+  s->arg = arg;
+  s->fill = 0;
+  s->nstripes = 0;
+  s->direct = talloc(char *, k);
+  s->stripe = jerasure_alloc_stripe(k, m, blocksize, 0);
+  if (s->direct == NULL || s->stripe == NULL) {
+    jerasure_stream_destroy(s);
+    return NULL;
+  }
+  return s;
+}
+
+jerasure_stream_t *jerasure_stream_create_matrix(int k, int m, int w, int *matrix, int blocksize,
+                                                 jerasure_stream_callback callback, void *arg)
+{
+  if (w != 8 && w != 16 && w != 32) return NULL;
+  return stream_create(k, m, w, matrix, NULL, blocksize, 0, sizeof(long), callback, arg);
+}
+
+jerasure_stream_t *jerasure_stream_create_schedule(int k, int m, int w, int **schedule,
+                                                   int blocksize, int packetsize,
+                                                   jerasure_stream_callback callback, void *arg)
+{
+  if (packetsize <= 0 || packetsize % sizeof(long) != 0) return NULL;
+  return stream_create(k, m, w, NULL, schedule, blocksize, packetsize, w*packetsize,
+                       callback, arg);
+}
+
+/* Encodes one stripe and hands it to the callback. */
+
+static int stream_emit(jerasure_stream_t *s, char **data, char **coding, int blocksize, int nbytes)
+{
+  if (s->matrix != NULL) {
+    jerasure_matrix_encode(s->k, s->m, s->w, s->matrix, data, coding, blocksize);
+  } else {
+    jerasure_schedule_encode(s->k, s->m, s->w, s->schedule, data, coding, blocksize, s->packetsize);
+  }
+  s->nstripes++;
+  return (s->callback(s->arg, s->nstripes-1, data, coding, blocksize, nbytes) == 0) ? 0 : -1;
+}
+
+int jerasure_stream_append(jerasure_stream_t *s, char *buf, int len)
+{
+  int i, bs, n, off;
+  long full;
+
+  bs = s->blocksize;
+  full = (long) s->k * bs;
+
+  while (len > 0) {
+
+    /* A whole stripe in the caller's buffer is encoded in place, if its
+       blocks are aligned like the coding blocks mod 16, as GF-Complete
+       requires of the source and destination of a region multiply. */
+
+    if (s->fill == 0 && len >= full && bs % 16 == 0 &&
+        (unsigned long) buf % 16 == (unsigned long) s->stripe->coding[0] % 16) {
+      for (i = 0; i < s->k; i++) s->direct[i] = buf + (long) i * bs;
+      if (stream_emit(s, s->direct, s->stripe->coding, bs, (int) full) < 0) return -1;
+      buf += full;
+      len -= full;
+      continue;
+    }
+
+    /* Otherwise, copy into the stripe, up to the end of the current block. */
+
+    i = s->fill / bs;
+    off = s->fill % bs;
+    n = bs - off;
+    if (n > len) n = len;
+    memcpy(s->stripe->data[i] + off, buf, n);
+    buf += n;
+    len -= n;
+    s->fill += n;
+
+    if (s->fill == full) {
+      s->fill = 0;
+      if (stream_emit(s, s->stripe->data, s->stripe->coding, bs, (int) full) < 0) return -1;
+    }
+  }
+  return 0;
+}
+
+int jerasure_stream_finalize(jerasure_stream_t *s)
+{
+  jerasure_stripe_t *last;
+  int i, bs, per, n, from, first, rv;
+  char *src;
+
+  if (s->fill == 0) return 0;
+
+  /* The smallest blocksize that holds what is left. */
+
+  per = (s->fill + s->k - 1) / s->k;
+  bs = ((per + s->granule - 1) / s->granule) * s->granule;
+
+  last = jerasure_alloc_stripe(s->k, s->m, bs, 0);
+  if (last == NULL) return -1;
+
+  /* Lay the bytes out again in blocks of bs, and pad with zeros. */
+
+  for (i = 0; i < s->k; i++) {
+    from = i*bs;
+    n = s->fill - from;
+    if (n < 0) n = 0;
+    if (n > bs) n = bs;
+    if (n > 0) {
+      src = s->stripe->data[from / s->blocksize] + from % s->blocksize;
+      first = s->blocksize - from % s->blocksize;
+      if (first >= n) {
+        memcpy(last->data[i], src, n);
+      } else {
+        memcpy(last->data[i], src, first);
+        memcpy(last->data[i] + first, s->stripe->data[from / s->blocksize + 1], n - first);
+      }
+    }
+    memset(last->data[i] + n, 0, bs - n);
+  }
+
+  n = s->fill;
+  s->fill = 0;
+  rv = stream_emit(s, last->data, last->coding, bs, n);
+  jerasure_free_stripe(last);
+  return rv;
+}
+
+void jerasure_stream_destroy(jerasure_stream_t *s)
+{
+  if (s == NULL) return;
+  jerasure_free_stripe(s->stripe);
+  free(s->direct);
+  free(s);
+}
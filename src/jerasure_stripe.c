@@ -0,0 +1,207 @@
+/* *
+ * Copyright (c) 2014, James S. Plank and Kevin Greenan
+ * All rights reserved.
+ *
+ * Jerasure - A C/C++ Library for a Variety of Reed-Solomon and RAID-6 Erasure
+ * Coding Techniques
+ *
+ * Revision 2.0: Galois Field backend now links to GF-Complete
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *  - Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ *  - Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ *
+ *  - Neither the name of the University of Tennessee nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY
+ * WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#ifdef __linux__
+#define _GNU_SOURCE
+#endif
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+#include <sys/mman.h>
+
+#include "jerasure_stripe.h"
+
+#define talloc(type, num) (type *) malloc(sizeof(type)*(num))
+
+/* How the memory of a stripe was obtained. */
+
+#define STRIPE_MEMALIGN 0
+#define STRIPE_MMAP     1
+
+static pthread_mutex_t stripe_lock = PTHREAD_MUTEX_INITIALIZER;
+static jerasure_stripe_t *stripe_free_list = NULL;
+static int stripe_nfree = 0;
+static int stripe_hugepages = 0;
+
+void jerasure_stripe_set_hugepages(int on)
+{
+  pthread_mutex_lock(&stripe_lock);
+  stripe_hugepages = (on != 0);
+  pthread_mutex_unlock(&stripe_lock);
+}
+
+/* Tries huge pages first, then normal pages with a hint to the kernel to
+   back them with transparent huge pages.  Returns NULL if mmap fails, in
+   which case the caller uses posix_memalign. */
+
+static char *stripe_mmap(size_t bytes)
+{
+  void *p;
+
+#ifdef MAP_HUGETLB
+  p = mmap(NULL, bytes, PROT_READ | PROT_WRITE,
+           MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+  if (p != MAP_FAILED) return (char *) p;
+#endif
+
+  p = mmap(NULL, bytes, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+  if (p == MAP_FAILED) return NULL;
+#ifdef MADV_HUGEPAGE
+  madvise(p, bytes, MADV_HUGEPAGE);
+#endif
+  return (char *) p;
+}
+
+static void stripe_release(jerasure_stripe_t *s)
+{
+  if (s->how == STRIPE_MMAP) {
+    munmap(s->base, s->bytes);
+  } else {
+    free(s->base);
+  }
+  free(s->data);
+  free(s);
+}
+
+jerasure_stripe_t *jerasure_alloc_stripe(int k, int m, int blocksize, int align)
+{
+  jerasure_stripe_t *s, **sp;
+  void *p;
+  int i, huge;
+
+  if (align == 0) align = JERASURE_STRIPE_ALIGN;
+  if (k <= 0 || m < 0 || blocksize <= 0 || align < 0 || (align & (align-1)) != 0) {
+    return NULL;
+  }
+  if (align < (int) sizeof(void *)) align = sizeof(void *);
+
+  /* Reuse a freed stripe of the same shape if there is one. */
+
+  pthread_mutex_lock(&stripe_lock);
+  huge = stripe_hugepages;
+  for (sp = &stripe_free_list; *sp != NULL; sp = &((*sp)->next)) {
+    s = *sp;
+    if (s->k == k && s->m == m && s->blocksize == blocksize && s->align == align) {
+      *sp = s->next;
+      stripe_nfree--;
+      pthread_mutex_unlock(&stripe_lock);
+      s->next = NULL;
+      return s;
+    }
+  }
+  pthread_mutex_unlock(&stripe_lock);
+
+  s = talloc(jerasure_stripe_t, 1);
+  if (s == NULL) return NULL;
+  s->data = talloc(char *, k+m);
+  if (s->data == NULL) {
+    free(s);
+    return NULL;
+  }
+  s->coding = s->data + k;
+  s->k = k;
+  s->m = m;
+  s->blocksize = blocksize;
+  s->align = align;
+  s->stride = ((blocksize + align - 1) / align) * align;
+  s->bytes = (size_t) s->stride * (k+m);
+  s->next = NULL;
+  s->base = NULL;
+
+  /* mmap returns page-aligned memory, which covers any align up to the page
+     size.  Huge pages must be mapped in multiples of their size. */
+
+  if (huge && s->bytes >= JERASURE_STRIPE_HUGE_SIZE && align <= 4096) {
+    s->bytes = ((s->bytes + JERASURE_STRIPE_HUGE_SIZE - 1) / JERASURE_STRIPE_HUGE_SIZE)
+               * JERASURE_STRIPE_HUGE_SIZE;
+    s->base = stripe_mmap(s->bytes);
+    s->how = STRIPE_MMAP;
+  }
+  if (s->base == NULL) {
+    s->bytes = (size_t) s->stride * (k+m);
+    if (posix_memalign(&p, align, s->bytes) != 0) {
+      free(s->data);
+      free(s);
+      return NULL;
+    }
+    s->base = (char *) p;
+    s->how = STRIPE_MEMALIGN;
+  }
+
+  for (i = 0; i < k+m; i++) s->data[i] = s->base + (size_t) i * s->stride;
+  return s;
+}
+
+void jerasure_free_stripe(jerasure_stripe_t *stripe)
+{
+  if (stripe == NULL) return;
+
+  pthread_mutex_lock(&stripe_lock);
+  if (stripe_nfree < JERASURE_STRIPE_POOL_MAX) {
+    stripe->next = stripe_free_list;
+    stripe_free_list = stripe;
+    stripe_nfree++;
+    stripe = NULL;
+  }
+  pthread_mutex_unlock(&stripe_lock);
+
+  if (stripe != NULL) stripe_release(stripe);
+}
+
+void jerasure_stripe_pool_drain(void)
+{
+  jerasure_stripe_t *s, *next;
+
+  pthread_mutex_lock(&stripe_lock);
+  s = stripe_free_list;
+  stripe_free_list = NULL;
+  stripe_nfree = 0;
+  pthread_mutex_unlock(&stripe_lock);
+
+  for (; s != NULL; s = next) {
+    next = s->next;
+    stripe_release(s);
+  }
+}
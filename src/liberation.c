@@ -47,6 +47,8 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <assert.h>
+#include <pthread.h>
 
 #include "galois.h"
 #include "jerasure.h"
@@ -260,3 +262,933 @@ int *blaum_roth_coding_bitmatrix(int k, int w)
 
   return matrix;
 }
+
+/* RDP and EVENODD.  Both use a prime p = w+1, and view each group of w
+   packets of a device as a column of w cells, one per row.  The diagonal
+   of the cell in row r of column position c is (r+c) mod p.  In RDP, data
+   devices take positions 0 .. k-1 and P takes position p-1, so Q is the
+   parity of diagonals 0 .. p-2 over the data and P.  In EVENODD, data
+   devices take positions 0 .. k-1 and Q[d] is the parity of diagonal d over
+   the data, XOR'd with the parity S of the missing diagonal p-1.  Missing
+   positions hold zeros. */
+
+static int is_odd_prime(int p)
+{
+  int i;
+
+  if (p < 3 || p % 2 == 0) return 0;
+  for (i = 3; i*i <= p; i += 2) if (p % i == 0) return 0;
+  return 1;
+}
+
+static int rdp_args_ok(int k, int w)
+{
+  return (is_odd_prime(w+1) && k > 0 && k <= w);
+}
+
+static int evenodd_args_ok(int k, int w)
+{
+  return (is_odd_prime(w+1) && k > 0 && k <= w+1);
+}
+
+/* Row of the cell of column position c on diagonal d, or -1 if that cell
+   is in the imaginary row p-1 */
+
+static int diagonal_row(int d, int c, int p)
+{
+  int r;
+
+  r = (d - c) % p;
+  if (r < 0) r += p;
+  return (r == p-1) ? -1 : r;
+}
+
+/* Sets up the identity P rows of a 2w x kw bitmatrix */
+
+static int *xor_code_bitmatrix(int k, int w)
+{
+  int *matrix, r, c;
+
+  matrix = talloc(int, 2*k*w*w);
+  if (matrix == NULL) return NULL;
+  bzero(matrix, sizeof(int)*2*k*w*w);
+  for (r = 0; r < w; r++) {
+    for (c = 0; c < k; c++) matrix[r*k*w+c*w+r] = 1;
+  }
+  return matrix;
+}
+
+int *rdp_coding_bitmatrix(int k, int w)
+{
+  int *matrix, *q, p, d, c, r, j;
+
+  if (!rdp_args_ok(k, w)) return NULL;
+  matrix = xor_code_bitmatrix(k, w);
+  if (matrix == NULL) return NULL;
+
+  p = w+1;
+  for (d = 0; d < w; d++) {
+    q = matrix + (w+d)*k*w;
+    for (c = 0; c < k; c++) {
+      r = diagonal_row(d, c, p);
+      if (r >= 0) q[c*w+r] ^= 1;
+    }
+
+    /* The P cell on this diagonal brings in its whole row */
+
+    r = diagonal_row(d, p-1, p);
+    if (r >= 0) {
+      for (j = 0; j < k; j++) q[j*w+r] ^= 1;
+    }
+  }
+  return matrix;
+}
+
+int *evenodd_coding_bitmatrix(int k, int w)
+{
+  int *matrix, *q, p, d, c, r;
+
+  if (!evenodd_args_ok(k, w)) return NULL;
+  matrix = xor_code_bitmatrix(k, w);
+  if (matrix == NULL) return NULL;
+
+  p = w+1;
+  for (d = 0; d < w; d++) {
+    q = matrix + (w+d)*k*w;
+    for (c = 0; c < k; c++) {
+      r = diagonal_row(d, c, p);
+      if (r >= 0) q[c*w+r] ^= 1;
+      r = diagonal_row(p-1, c, p);
+      if (r >= 0) q[c*w+r] ^= 1;
+    }
+  }
+  return matrix;
+}
+
+/* Copies src to dest if *started is zero, and XORs it in otherwise */
+
+static void put_packet(char *src, char *dest, int packetsize, int *started)
+{
+  if (*started) {
+    galois_region_xor(src, dest, packetsize);
+  } else {
+    memcpy(dest, src, packetsize);
+    *started = 1;
+  }
+}
+
+static void encode_row_parity(int k, int w, char **data, char *p_col, int packetsize)
+{
+  int r, c, started;
+
+  for (r = 0; r < w; r++) {
+    started = 0;
+    for (c = 0; c < k; c++) put_packet(data[c]+r*packetsize, p_col+r*packetsize, packetsize, &started);
+  }
+}
+
+void rdp_encode(int k, int w, char **data_ptrs, char **coding_ptrs, int size, int packetsize)
+{
+  char **cols, *q;
+  int *started, p, c, r, d, done;
+
+  if (!rdp_args_ok(k, w) || size % (w*packetsize) != 0) {
+    fprintf(stderr, "rdp_encode: bad k=%d, w=%d, size=%d or packetsize=%d\n", k, w, size, packetsize);
+    assert(0);
+  }
+
+  p = w+1;
+  cols = talloc(char *, k+1);
+  started = talloc(int, w);
+  if (cols == NULL || started == NULL) {
+    fprintf(stderr, "rdp_encode: cannot allocate memory\n");
+    assert(0);
+  }
+
+  for (done = 0; done < size; done += w*packetsize) {
+    for (c = 0; c < k; c++) cols[c] = data_ptrs[c] + done;
+    cols[k] = coding_ptrs[0] + done;
+    q = coding_ptrs[1] + done;
+
+    encode_row_parity(k, w, cols, cols[k], packetsize);
+
+    /* Walk the columns, including P at position p-1, dropping each cell
+       into its diagonal.  Every diagonal is started by a copy. */
+
+    bzero(started, sizeof(int)*w);
+    for (c = 0; c <= k; c++) {
+      for (r = 0; r < w; r++) {
+        d = (r + ((c == k) ? p-1 : c)) % p;
+        if (d == p-1) continue;
+        put_packet(cols[c]+r*packetsize, q+d*packetsize, packetsize, started+d);
+      }
+    }
+  }
+
+  free(cols);
+  free(started);
+}
+
+void evenodd_encode(int k, int w, char **data_ptrs, char **coding_ptrs, int size, int packetsize)
+{
+  char **cols, *q, *s;
+  int *started, s_started, p, c, r, d, done;
+
+  if (!evenodd_args_ok(k, w) || size % (w*packetsize) != 0) {
+    fprintf(stderr, "evenodd_encode: bad k=%d, w=%d, size=%d or packetsize=%d\n", k, w, size, packetsize);
+    assert(0);
+  }
+
+  p = w+1;
+  cols = talloc(char *, k);
+  started = talloc(int, w);
+  s = talloc(char, packetsize);
+  if (cols == NULL || started == NULL || s == NULL) {
+    fprintf(stderr, "evenodd_encode: cannot allocate memory\n");
+    assert(0);
+  }
+
+  for (done = 0; done < size; done += w*packetsize) {
+    for (c = 0; c < k; c++) cols[c] = data_ptrs[c] + done;
+    q = coding_ptrs[1] + done;
+
+    encode_row_parity(k, w, cols, coding_ptrs[0] + done, packetsize);
+
+    bzero(started, sizeof(int)*w);
+    s_started = 0;
+    for (c = 0; c < k; c++) {
+      for (r = 0; r < w; r++) {
+        d = (r+c) % p;
+        if (d == p-1) {
+          put_packet(cols[c]+r*packetsize, s, packetsize, &s_started);
+        } else {
+          put_packet(cols[c]+r*packetsize, q+d*packetsize, packetsize, started+d);
+        }
+      }
+    }
+
+    /* Fold the adjuster S into every diagonal */
+
+    for (d = 0; d < w; d++) {
+      if (!s_started) {
+        if (!started[d]) bzero(q+d*packetsize, packetsize);
+      } else {
+        put_packet(s, q+d*packetsize, packetsize, started+d);
+      }
+    }
+  }
+
+  free(cols);
+  free(s);
+  free(started);
+}
+
+/* Decoding.  The parity equations of either code are listed as sets of
+   cells that XOR to zero.  Cell r of device i (data 0 .. k-1, then P and
+   Q) is i*w+r, and EVENODD's S is cell (k+2)*w.  Recovery peels the
+   equations: any equation with one unknown cell solves that cell.  For
+   RDP, this is exactly the row/diagonal chain reconstruction.  For
+   EVENODD, the sum of all of its equations is also listed, since it gives
+   S directly from P and Q.  The order in which cells are solved depends
+   only on the erasures, so it is worked out once and then replayed for
+   every group of w packets. */
+
+typedef struct {
+  int neqs;
+  int *start;     /* Equation i is cells[start[i]] .. cells[start[i+1]-1] */
+  int *cells;
+} xor_equations;
+
+static int add_cell(xor_equations *x, int cell)
+{
+  x->cells[x->start[x->neqs+1]++] = cell;
+  return cell;
+}
+
+static void next_equation(xor_equations *x)
+{
+  x->neqs++;
+  x->start[x->neqs+1] = x->start[x->neqs];
+}
+
+static int alloc_equations(xor_equations *x, int neqs, int ncells)
+{
+  x->neqs = 0;
+  x->start = talloc(int, neqs+2);
+  x->cells = talloc(int, ncells);
+  if (x->start == NULL || x->cells == NULL) {
+    free(x->start);
+    free(x->cells);
+    return -1;
+  }
+  x->start[0] = 0;
+  x->start[1] = 0;
+  return 0;
+}
+
+static int rdp_equations(int k, int w, xor_equations *x)
+{
+  int p, r, d, c;
+
+  p = w+1;
+  if (alloc_equations(x, 2*w, 2*w*(k+2)) < 0) return -1;
+  for (r = 0; r < w; r++) {
+    for (c = 0; c < k; c++) add_cell(x, c*w+r);
+    add_cell(x, k*w+r);
+    next_equation(x);
+  }
+  for (d = 0; d < w; d++) {
+    for (c = 0; c < k; c++) {
+      r = diagonal_row(d, c, p);
+      if (r >= 0) add_cell(x, c*w+r);
+    }
+    r = diagonal_row(d, p-1, p);
+    if (r >= 0) add_cell(x, k*w+r);
+    add_cell(x, (k+1)*w+d);
+    next_equation(x);
+  }
+  return 0;
+}
+
+static int evenodd_equations(int k, int w, xor_equations *x)
+{
+  int p, r, d, c, s;
+
+  p = w+1;
+  s = (k+2)*w;
+  if (alloc_equations(x, 2*w+2, (2*w+1)*(k+2) + 2*w + 1) < 0) return -1;
+  for (r = 0; r < w; r++) {
+    for (c = 0; c < k; c++) add_cell(x, c*w+r);
+    add_cell(x, k*w+r);
+    next_equation(x);
+  }
+  for (d = 0; d < p; d++) {
+    for (c = 0; c < k; c++) {
+      r = diagonal_row(d, c, p);
+      if (r >= 0) add_cell(x, c*w+r);
+    }
+    if (d < p-1) add_cell(x, (k+1)*w+d);
+    add_cell(x, s);
+    next_equation(x);
+  }
+  for (r = 0; r < w; r++) {
+    add_cell(x, k*w+r);
+    add_cell(x, (k+1)*w+r);
+  }
+  add_cell(x, s);
+  next_equation(x);
+  return 0;
+}
+
+/* Works out the order in which to solve the unknown cells.  plan gets
+   pairs (cell, equation), and the number of pairs is returned, or -1 if
+   some erased cell cannot be recovered. */
+
+static int plan_recovery(xor_equations *x, int ncells, int *unknown, int nerased, int *plan)
+{
+  int nsteps, e, i, u, target, progress;
+
+  nsteps = 0;
+  while (nerased > 0) {
+    progress = 0;
+    for (e = 0; e < x->neqs && nerased > 0; e++) {
+      u = 0;
+      target = -1;
+      for (i = x->start[e]; i < x->start[e+1]; i++) {
+        if (unknown[x->cells[i]]) {
+          u++;
+          target = x->cells[i];
+        }
+      }
+      if (u != 1) continue;
+      unknown[target] = 0;
+      if (target < ncells) nerased--;
+      plan[nsteps*2] = target;
+      plan[nsteps*2+1] = e;
+      nsteps++;
+      progress = 1;
+    }
+    if (!progress) return -1;
+  }
+  return nsteps;
+}
+
+static int xor_code_decode(int k, int w, int is_evenodd, int *erasures,
+                           char **data_ptrs, char **coding_ptrs, int size, int packetsize)
+{
+  xor_equations x;
+  int *unknown, *plan, ncells, nsteps, nerased, i, j, done, target, started;
+  char **dev, *s, *dest;
+
+  ncells = (k+2)*w;
+  unknown = talloc(int, ncells+1);
+  plan = talloc(int, 2*(ncells+1));
+  dev = talloc(char *, k+3);
+  s = talloc(char, packetsize);
+  x.start = NULL;
+  x.cells = NULL;
+  nsteps = -1;
+  if (unknown == NULL || plan == NULL || dev == NULL || s == NULL) goto done;
+  if ((is_evenodd ? evenodd_equations(k, w, &x) : rdp_equations(k, w, &x)) < 0) {
+    x.start = NULL;
+    x.cells = NULL;
+    goto done;
+  }
+
+  bzero(unknown, sizeof(int)*(ncells+1));
+  nerased = 0;
+  for (i = 0; erasures[i] != -1; i++) {
+    if (erasures[i] < 0 || erasures[i] >= k+2) goto done;
+    if (unknown[erasures[i]*w]) continue;
+    for (j = 0; j < w; j++) unknown[erasures[i]*w+j] = 1;
+    nerased += w;
+  }
+  if (nerased > 2*w) goto done;
+  unknown[ncells] = is_evenodd;
+
+  nsteps = plan_recovery(&x, ncells, unknown, nerased, plan);
+  if (nsteps <= 0) goto done;
+
+  for (done = 0; done < size; done += w*packetsize) {
+    for (i = 0; i < k; i++) dev[i] = data_ptrs[i] + done;
+    dev[k] = coding_ptrs[0] + done;
+    dev[k+1] = coding_ptrs[1] + done;
+    dev[k+2] = s;
+
+    for (i = 0; i < nsteps; i++) {
+      target = plan[i*2];
+      dest = dev[target/w] + (target%w)*packetsize;
+      started = 0;
+      for (j = x.start[plan[i*2+1]]; j < x.start[plan[i*2+1]+1]; j++) {
+        if (x.cells[j] == target) continue;
+        put_packet(dev[x.cells[j]/w] + (x.cells[j]%w)*packetsize, dest, packetsize, &started);
+      }
+      if (!started) bzero(dest, packetsize);
+    }
+  }
+
+done:
+  free(x.start);
+  free(x.cells);
+  free(unknown);
+  free(plan);
+  free(dev);
+  free(s);
+  return (nsteps < 0) ? -1 : 0;
+}
+
+int rdp_decode(int k, int w, int *erasures, char **data_ptrs, char **coding_ptrs,
+               int size, int packetsize)
+{
+  if (!rdp_args_ok(k, w) || size % (w*packetsize) != 0) return -1;
+  return xor_code_decode(k, w, 0, erasures, data_ptrs, coding_ptrs, size, packetsize);
+}
+
+int evenodd_decode(int k, int w, int *erasures, char **data_ptrs, char **coding_ptrs,
+                   int size, int packetsize)
+{
+  if (!evenodd_args_ok(k, w) || size % (w*packetsize) != 0) return -1;
+  return xor_code_decode(k, w, 1, erasures, data_ptrs, coding_ptrs, size, packetsize);
+}
+
+/* Decoding Liberation, Blaum-Roth and Liber8tion codes.  The generic
+   jerasure_schedule_decode_lazy inverts a kw x kw bitmatrix.  Here only the
+   erased data cells (at most 2w of them) are unknowns.  Each surviving
+   coding row gives an equation: its syndrome is the XOR of the known cells
+   in it, and equals the XOR of its unknown cells.  Eliminating on the
+   2w x 2w system says which syndromes make up each unknown cell.  The
+   cells are then produced greedily, each one in the cheapest of three
+   ways, as in bit-matrix scheduling:
+
+     - XOR the syndromes that make it up;
+     - start from a cell already recovered and XOR the syndromes in which
+       the two differ; or
+     - take one equation whose other unknown cells are already recovered,
+       and XOR those into its syndrome (the chains of the code).
+
+   A syndrome used by a single cell is built in that cell's buffer, so a
+   single erasure costs the same as rebuilding it from P.  Erased coding
+   devices are re-encoded at the end.  The result is a schedule in the
+   format of jerasure_do_scheduled_operations, in which device k+2 is
+   scratch space for shared syndromes. */
+
+typedef struct {
+  int **ops;
+  int nops;
+  int space;
+} op_list;
+
+static int add_op(op_list *l, int sd, int sp, int dd, int dp, int is_xor)
+{
+  int **tmp, *op;
+
+  if (l->nops+1 >= l->space) {
+    l->space = (l->space == 0) ? 64 : l->space*2;
+    tmp = (int **) realloc(l->ops, sizeof(int *)*l->space);
+    if (tmp == NULL) return -1;
+    l->ops = tmp;
+  }
+  op = talloc(int, 5);
+  if (op == NULL) return -1;
+  op[0] = sd;
+  op[1] = sp;
+  op[2] = dd;
+  op[3] = dp;
+  op[4] = is_xor;
+  l->ops[l->nops++] = op;
+  return 0;
+}
+
+static int **finish_ops(op_list *l, int ok)
+{
+  int i;
+
+  if (ok && add_op(l, -1, 0, 0, 0, 0) == 0) return l->ops;
+  for (i = 0; i < l->nops; i++) free(l->ops[i]);
+  free(l->ops);
+  return NULL;
+}
+
+/* Adds ops setting (dd,dp) to the XOR of the n cells in sd/sp.  If
+   started, (dd,dp) already holds a term. */
+
+static int add_xor_ops(op_list *l, int n, int *sd, int *sp, int dd, int dp, int started)
+{
+  int i;
+
+  for (i = 0; i < n; i++) {
+    if (add_op(l, sd[i], sp[i], dd, dp, started || i > 0) < 0) return -1;
+  }
+  return 0;
+}
+
+static int **raid6_bitmatrix_decoding_schedule(int k, int w, int *bitmatrix, int *erasures)
+{
+  op_list l;
+  int erased[2], nerased, *is_erased, *uid, nu, ne, nrow;
+  int *u_dev, *u_row, *e_coding, *e_row;
+  char *a, *t, *solved, *in_e;
+  int *choice_kind, *choice_arg, *uses, *slot, *direct, *order;
+  int *sd, *sp;
+  int i, j, c, r, e, u, v, n, best, best_cost, best_kind, best_arg, cost, ok, nslots;
+
+  l.ops = NULL;
+  l.nops = 0;
+  l.space = 0;
+  ok = 0;
+
+  is_erased = talloc(int, k+2);
+  uid = talloc(int, k*w);
+  u_dev = talloc(int, 2*w);
+  u_row = talloc(int, 2*w);
+  e_coding = talloc(int, 2*w);
+  e_row = talloc(int, 2*w);
+  a = talloc(char, 2*w*4*w);
+  solved = talloc(char, 2*w);
+  in_e = talloc(char, 2*w);
+  choice_kind = talloc(int, 2*w);
+  choice_arg = talloc(int, 2*w);
+  uses = talloc(int, 2*w);
+  slot = talloc(int, 2*w);
+  direct = talloc(int, 2*w);
+  order = talloc(int, 2*w);
+  sd = talloc(int, (k+2)*w+2*w);
+  sp = talloc(int, (k+2)*w+2*w);
+  if (is_erased == NULL || uid == NULL || u_dev == NULL || u_row == NULL || e_coding == NULL ||
+      e_row == NULL || a == NULL || solved == NULL || in_e == NULL ||
+      choice_kind == NULL || choice_arg == NULL || uses == NULL || slot == NULL ||
+      direct == NULL || order == NULL || sd == NULL || sp == NULL) goto done;
+
+  bzero(is_erased, sizeof(int)*(k+2));
+  nerased = 0;
+  for (i = 0; erasures[i] != -1; i++) {
+    if (erasures[i] < 0 || erasures[i] >= k+2) goto done;
+    if (is_erased[erasures[i]]) continue;
+    if (nerased == 2) goto done;
+    is_erased[erasures[i]] = 1;
+    erased[nerased++] = erasures[i];
+  }
+
+  /* Unknowns are the erased data cells; equations are the surviving coding rows */
+
+  nu = 0;
+  for (c = 0; c < k; c++) {
+    for (r = 0; r < w; r++) {
+      uid[c*w+r] = -1;
+      if (is_erased[c]) {
+        u_dev[nu] = c;
+        u_row[nu] = r;
+        uid[c*w+r] = nu++;
+      }
+    }
+  }
+  ne = 0;
+  for (j = 0; j < 2; j++) {
+    if (is_erased[k+j]) continue;
+    for (r = 0; r < w; r++) {
+      e_coding[ne] = j;
+      e_row[ne] = r;
+      ne++;
+    }
+  }
+
+  /* Row e of a is [ unknowns of equation e | identity ], nrow wide */
+
+  nrow = nu + ne;
+  bzero(a, nrow*ne);
+  for (e = 0; e < ne; e++) {
+    int *brow = bitmatrix + (e_coding[e]*w + e_row[e])*k*w;
+    for (i = 0; i < k*w; i++) {
+      if (brow[i] && uid[i] >= 0) a[e*nrow+uid[i]] = 1;
+    }
+    a[e*nrow+nu+e] = 1;
+  }
+
+  /* Gauss-Jordan on the unknown columns, with the pivot for unknown u
+     swapped into row u.  Afterwards, the identity part of row u (at
+     t + u*nrow) lists the syndromes whose XOR is u. */
+
+  for (u = 0; u < nu; u++) {
+    for (e = u; e < ne && !a[e*nrow+u]; e++) ;
+    if (e == ne) goto done;
+    if (e != u) {
+      for (i = 0; i < nrow; i++) {
+        char x = a[e*nrow+i];
+        a[e*nrow+i] = a[u*nrow+i];
+        a[u*nrow+i] = x;
+      }
+    }
+    for (e = 0; e < ne; e++) {
+      if (e != u && a[e*nrow+u]) {
+        for (i = 0; i < nrow; i++) a[e*nrow+i] ^= a[u*nrow+i];
+      }
+    }
+  }
+  t = a + nu;
+
+  /* Pick how to make each unknown, cheapest first.  choice_kind is 0 for
+     its syndromes, 1 for unknown choice_arg plus the difference, and 2
+     for equation choice_arg plus its other unknowns.  The equations used
+     by kind 2 are the original ones, which a's first nu columns no longer
+     hold, so they are recomputed from the bitmatrix. */
+
+  bzero(solved, nu);
+  for (n = 0; n < nu; n++) {
+    best = -1;
+    best_cost = 0;
+    best_kind = 0;
+    best_arg = 0;
+    for (u = 0; u < nu; u++) {
+      if (solved[u]) continue;
+      cost = 0;
+      for (e = 0; e < ne; e++) cost += t[u*nrow+e];
+      if (best < 0 || cost < best_cost) {
+        best = u; best_cost = cost; best_kind = 0; best_arg = 0;
+      }
+      for (v = 0; v < nu; v++) {
+        if (!solved[v]) continue;
+        cost = 1;
+        for (e = 0; e < ne; e++) cost += (t[u*nrow+e] != t[v*nrow+e]);
+        if (cost < best_cost) {
+          best = u; best_cost = cost; best_kind = 1; best_arg = v;
+        }
+      }
+      for (e = 0; e < ne; e++) {
+        int *brow = bitmatrix + (e_coding[e]*w + e_row[e])*k*w;
+        int has_u = 0, others = 0, open = 0;
+        for (i = 0; i < k*w; i++) {
+          if (!brow[i] || uid[i] < 0) continue;
+          if (uid[i] == u) has_u = 1;
+          else if (solved[uid[i]]) others++;
+          else open++;
+        }
+        if (has_u && open == 0 && 1+others < best_cost) {
+          best = u; best_cost = 1+others; best_kind = 2; best_arg = e;
+        }
+      }
+    }
+    solved[best] = 1;
+    order[n] = best;
+    choice_kind[best] = best_kind;
+    choice_arg[best] = best_arg;
+  }
+
+  /* Syndromes used by exactly one unknown are built in place */
+
+  bzero(uses, sizeof(int)*ne);
+  for (u = 0; u < nu; u++) {
+    for (e = 0; e < ne; e++) {
+      switch (choice_kind[u]) {
+        case 0: uses[e] += t[u*nrow+e]; break;
+        case 1: uses[e] += (t[u*nrow+e] != t[choice_arg[u]*nrow+e]); break;
+        case 2: uses[e] += (e == choice_arg[u]); break;
+      }
+    }
+  }
+  for (u = 0; u < nu; u++) direct[u] = -1;
+  for (u = 0; u < nu; u++) {
+    for (e = 0; e < ne && direct[u] < 0; e++) {
+      if (uses[e] != 1) continue;
+      if ((choice_kind[u] == 0 && t[u*nrow+e]) ||
+          (choice_kind[u] == 1 && t[u*nrow+e] != t[choice_arg[u]*nrow+e]) ||
+          (choice_kind[u] == 2 && e == choice_arg[u])) direct[u] = e;
+    }
+  }
+  nslots = 0;
+  for (e = 0; e < ne; e++) {
+    slot[e] = -1;
+    if (uses[e] == 0) continue;
+    for (u = 0; u < nu && direct[u] != e; u++) ;
+    if (u == nu) slot[e] = nslots++;
+  }
+
+  /* Syndromes: XOR of the known cells of each equation, into its slot or
+     straight into the one unknown that uses it */
+
+  for (e = 0; e < ne; e++) {
+    int *brow = bitmatrix + (e_coding[e]*w + e_row[e])*k*w;
+    int dd, dp;
+
+    if (uses[e] == 0) continue;
+    n = 0;
+    for (i = 0; i < k*w; i++) {
+      if (brow[i] && uid[i] < 0) {
+        sd[n] = i/w;
+        sp[n] = i%w;
+        n++;
+      }
+    }
+    sd[n] = k+e_coding[e];
+    sp[n] = e_row[e];
+    n++;
+    if (slot[e] >= 0) {
+      dd = k+2;
+      dp = slot[e];
+    } else {
+      for (u = 0; direct[u] != e; u++) ;
+      dd = u_dev[u];
+      dp = u_row[u];
+    }
+    if (add_xor_ops(&l, n, sd, sp, dd, dp, 0) < 0) goto done;
+  }
+
+  /* The unknowns, in the order chosen */
+
+  for (n = 0; n < nu; n++) {
+    int m = 0;
+
+    u = order[n];
+    bzero(in_e, ne);
+    switch (choice_kind[u]) {
+      case 0:
+        for (e = 0; e < ne; e++) in_e[e] = t[u*nrow+e];
+        break;
+      case 1:
+        v = choice_arg[u];
+        for (e = 0; e < ne; e++) in_e[e] = (t[u*nrow+e] != t[v*nrow+e]);
+        sd[m] = u_dev[v];
+        sp[m] = u_row[v];
+        m++;
+        break;
+      case 2: {
+        int *brow;
+
+        e = choice_arg[u];
+        in_e[e] = 1;
+        brow = bitmatrix + (e_coding[e]*w + e_row[e])*k*w;
+        for (i = 0; i < k*w; i++) {
+          if (brow[i] && uid[i] >= 0 && uid[i] != u) {
+            sd[m] = u_dev[uid[i]];
+            sp[m] = u_row[uid[i]];
+            m++;
+          }
+        }
+        break;
+      }
+    }
+    for (e = 0; e < ne; e++) {
+      if (in_e[e] && e != direct[u]) {
+        sd[m] = k+2;
+        sp[m] = slot[e];
+        m++;
+      }
+    }
+    if (add_xor_ops(&l, m, sd, sp, u_dev[u], u_row[u], direct[u] >= 0) < 0) goto done;
+  }
+
+  /* Re-encode erased coding devices from the (now whole) data */
+
+  for (i = 0; i < nerased; i++) {
+    if (erased[i] < k) continue;
+    j = erased[i]-k;
+    for (r = 0; r < w; r++) {
+      int *brow = bitmatrix + (j*w + r)*k*w;
+      n = 0;
+      for (c = 0; c < k*w; c++) {
+        if (brow[c]) {
+          sd[n] = c/w;
+          sp[n] = c%w;
+          n++;
+        }
+      }
+      if (n == 0 || add_xor_ops(&l, n, sd, sp, k+j, r, 0) < 0) goto done;
+    }
+  }
+  ok = 1;
+
+done:
+  free(is_erased); free(uid); free(u_dev); free(u_row); free(e_coding); free(e_row);
+  free(a); free(solved); free(in_e); free(choice_kind); free(choice_arg);
+  free(uses); free(slot); free(direct); free(order); free(sd); free(sp);
+  return finish_ops(&l, ok);
+}
+
+/* Schedules depend only on the code, k, w and which devices are lost, so
+   they are built once per erasure pattern and kept.  The cache holds at
+   most RAID6_CACHE_MAX of them; past that, schedules are built per call. */
+
+#define RAID6_LIBERATION 0
+#define RAID6_BLAUM_ROTH 1
+#define RAID6_LIBER8TION 2
+
+#define RAID6_CACHE_MAX 1024
+
+typedef struct raid6_cached {
+  int code, k, w, e0, e1;
+  int **schedule;
+  struct raid6_cached *next;
+} raid6_cached;
+
+static raid6_cached *raid6_cache;
+static int raid6_cache_size;
+static pthread_mutex_t raid6_cache_lock = PTHREAD_MUTEX_INITIALIZER;
+
+static int *raid6_coding_bitmatrix(int code, int k, int w)
+{
+  switch (code) {
+    case RAID6_LIBERATION: return liberation_coding_bitmatrix(k, w);
+    case RAID6_BLAUM_ROTH: return blaum_roth_coding_bitmatrix(k, w);
+    default:               return liber8tion_coding_bitmatrix(k);
+  }
+}
+
+/* Returns the schedule for erased devices e0 < e1 (either may be -1),
+   and sets *cached if the cache owns it. */
+
+static int **raid6_get_schedule(int code, int k, int w, int e0, int e1, int *cached)
+{
+  raid6_cached *c;
+  int *bitmatrix, erasures[3], **schedule;
+
+  pthread_mutex_lock(&raid6_cache_lock);
+  for (c = raid6_cache; c != NULL; c = c->next) {
+    if (c->code == code && c->k == k && c->w == w && c->e0 == e0 && c->e1 == e1) break;
+  }
+  pthread_mutex_unlock(&raid6_cache_lock);
+  *cached = 1;
+  if (c != NULL) return c->schedule;
+
+  bitmatrix = raid6_coding_bitmatrix(code, k, w);
+  if (bitmatrix == NULL) return NULL;
+  erasures[0] = (e0 >= 0) ? e0 : e1;
+  erasures[1] = (e0 >= 0) ? e1 : -1;
+  erasures[2] = -1;
+  schedule = raid6_bitmatrix_decoding_schedule(k, w, bitmatrix, erasures);
+  free(bitmatrix);
+  if (schedule == NULL) return NULL;
+
+  pthread_mutex_lock(&raid6_cache_lock);
+  for (c = raid6_cache; c != NULL; c = c->next) {
+    if (c->code == code && c->k == k && c->w == w && c->e0 == e0 && c->e1 == e1) break;
+  }
+  if (c != NULL) {
+    jerasure_free_schedule(schedule);
+    schedule = c->schedule;
+  } else if (raid6_cache_size < RAID6_CACHE_MAX && (c = talloc(raid6_cached, 1)) != NULL) {
+    c->code = code;
+    c->k = k;
+    c->w = w;
+    c->e0 = e0;
+    c->e1 = e1;
+    c->schedule = schedule;
+    c->next = raid6_cache;
+    raid6_cache = c;
+    raid6_cache_size++;
+  } else {
+    *cached = 0;
+  }
+  pthread_mutex_unlock(&raid6_cache_lock);
+  return schedule;
+}
+
+static int raid6_bitmatrix_decode(int code, int k, int w, int *erasures,
+                                  char **data_ptrs, char **coding_ptrs, int size, int packetsize)
+{
+  int **schedule, i, tdone, e0, e1, cached;
+  char **ptrs, *scratch;
+
+  if (k <= 0 || w <= 0 || packetsize <= 0 || size % (w*packetsize) != 0) return -1;
+
+  /* The erased devices, at most two, with e0 < e1 and -1 for none */
+
+  e0 = -1;
+  e1 = -1;
+  for (i = 0; erasures[i] != -1; i++) {
+    if (erasures[i] < 0 || erasures[i] >= k+2) return -1;
+    if (erasures[i] == e0 || erasures[i] == e1) continue;
+    if (e0 >= 0) return -1;
+    if (e1 < 0) {
+      e1 = erasures[i];
+    } else if (erasures[i] < e1) {
+      e0 = erasures[i];
+    } else {
+      e0 = e1;
+      e1 = erasures[i];
+    }
+  }
+
+  schedule = raid6_get_schedule(code, k, w, e0, e1, &cached);
+  if (schedule == NULL) return -1;
+
+  ptrs = talloc(char *, k+3);
+  scratch = talloc(char, 2*w*packetsize);
+  if (ptrs == NULL || scratch == NULL) {
+    free(ptrs);
+    free(scratch);
+    if (!cached) jerasure_free_schedule(schedule);
+    return -1;
+  }
+  for (tdone = 0; tdone < size; tdone += w*packetsize) {
+    for (i = 0; i < k; i++) ptrs[i] = data_ptrs[i] + tdone;
+    ptrs[k] = coding_ptrs[0] + tdone;
+    ptrs[k+1] = coding_ptrs[1] + tdone;
+    ptrs[k+2] = scratch;
+    jerasure_do_scheduled_operations(ptrs, schedule, packetsize);
+  }
+
+  free(ptrs);
+  free(scratch);
+  if (!cached) jerasure_free_schedule(schedule);
+  return 0;
+}
+
+int liberation_decode(int k, int w, int *erasures, char **data_ptrs, char **coding_ptrs,
+                      int size, int packetsize)
+{
+  return raid6_bitmatrix_decode(RAID6_LIBERATION, k, w, erasures,
+                                data_ptrs, coding_ptrs, size, packetsize);
+}
+
+int blaum_roth_decode(int k, int w, int *erasures, char **data_ptrs, char **coding_ptrs,
+                      int size, int packetsize)
+{
+  return raid6_bitmatrix_decode(RAID6_BLAUM_ROTH, k, w, erasures,
+                                data_ptrs, coding_ptrs, size, packetsize);
+}
+
+int liber8tion_decode(int k, int *erasures, char **data_ptrs, char **coding_ptrs,
+                      int size, int packetsize)
+{
+  return raid6_bitmatrix_decode(RAID6_LIBER8TION, k, 8, erasures,
+                                data_ptrs, coding_ptrs, size, packetsize);
+}
@@ -0,0 +1,351 @@
+/* *
+ * Copyright (c) 2014, James S. Plank and Kevin Greenan
+ * All rights reserved.
+ *
+ * Jerasure - A C/C++ Library for a Variety of Reed-Solomon and RAID-6 Erasure
+ * Coding Techniques
+ *
+ * Revision 2.0: Galois Field backend now links to GF-Complete
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *  - Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ *  - Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ *
+ *  - Neither the name of the University of Tennessee nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY
+ * WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/* Jerasure's authors:
+
+   Revision 2.x - 2014: James S. Plank and Kevin M. Greenan
+   Revision 1.2 - 2008: James S. Plank, Scott Simmerman and Catherine D. Schuman.
+   Revision 1.0 - 2007: James S. Plank
+ */
+
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "galois.h"
+#include "jerasure.h"
+#include "lrc.h"
+
+#define talloc(type, num) (type *) malloc(sizeof(type)*(num))
+
+/* A repair is a list of steps.  Each rebuilds device dest as a dot
+   product of k terms, in the form taken by jerasure_matrix_dotprod: term
+   i is coef[i] times device src[i], and zero terms are never read. */
+
+typedef struct {
+  int dest;
+  int *coef;
+  int *src;
+} lrc_step;
+
+typedef struct {
+  int nsteps;
+  lrc_step *steps;
+} lrc_plan;
+
+static int lrc_group(int k, int l, int i)
+{
+  return (int) (((long) i * l) / k);
+}
+
+int *lrc_coding_matrix(int k, int l, int r, int w)
+{
+  int *matrix, i, j, x;
+
+  if (w != 8 && w != 16 && w != 32) return NULL;
+  if (l < 1 || l > k || r < 0) return NULL;
+  if (w < 30 && k >= (1 << w)) return NULL;
+
+  matrix = talloc(int, (l+r)*k);
+  if (matrix == NULL) return NULL;
+
+  for (j = 0; j < l; j++) {
+    for (i = 0; i < k; i++) matrix[j*k+i] = (lrc_group(k, l, i) == j);
+  }
+  for (i = 0; i < k; i++) {
+    x = 1;
+    for (j = 0; j < r; j++) {
+      x = galois_single_multiply(x, i+1, w);
+      matrix[(l+j)*k+i] = x;
+    }
+  }
+  return matrix;
+}
+
+static void free_plan(lrc_plan *p)
+{
+  int i;
+
+  for (i = 0; i < p->nsteps; i++) {
+    free(p->steps[i].coef);
+    free(p->steps[i].src);
+  }
+  free(p->steps);
+}
+
+static lrc_step *new_step(lrc_plan *p, int k, int dest)
+{
+  lrc_step *s;
+
+  s = p->steps + p->nsteps;
+  s->coef = talloc(int, k);
+  s->src = talloc(int, k);
+  if (s->coef == NULL || s->src == NULL) {
+    free(s->coef);
+    free(s->src);
+    return NULL;
+  }
+  bzero(s->coef, sizeof(int)*k);
+  bzero(s->src, sizeof(int)*k);
+  s->dest = dest;
+  p->nsteps++;
+  return s;
+}
+
+/* Coding row of device id (k <= id < k+l+r) */
+
+static int *coding_row(int k, int *matrix, int id)
+{
+  return matrix + (id-k)*k;
+}
+
+/* The global step: solve for the erased data in unknown[] from the fewest
+   surviving parities.  Candidates are tried local parities first, and one
+   is kept if it raises the rank over the unknown columns.  Returns 0 or
+   -1. */
+
+static int plan_global(int k, int l, int r, int w, int *matrix, int *erased,
+                       int *unknown, int nu, lrc_plan *p)
+{
+  int *basis, *pivot, *v, *rows, *sub, *inv, nrows, c, i, j, a, b, t, f, ok;
+  lrc_step *s;
+
+  basis = talloc(int, nu*nu);
+  pivot = talloc(int, nu);
+  v = talloc(int, nu);
+  rows = talloc(int, nu);
+  sub = talloc(int, nu*nu);
+  inv = talloc(int, nu*nu);
+  ok = -1;
+  if (basis == NULL || pivot == NULL || v == NULL || rows == NULL || sub == NULL || inv == NULL) goto done;
+
+  nrows = 0;
+  for (c = k; c < k+l+r && nrows < nu; c++) {
+    if (erased[c]) continue;
+
+    /* Local parities only help with their own group */
+
+    if (c < k+l) {
+      for (i = 0; i < nu && lrc_group(k, l, unknown[i]) != c-k; i++) ;
+      if (i == nu) continue;
+    }
+
+    for (i = 0; i < nu; i++) v[i] = coding_row(k, matrix, c)[unknown[i]];
+    for (j = 0; j < nrows; j++) {
+      if (v[pivot[j]] == 0) continue;
+      f = galois_single_divide(v[pivot[j]], basis[j*nu+pivot[j]], w);
+      for (i = 0; i < nu; i++) v[i] ^= galois_single_multiply(f, basis[j*nu+i], w);
+    }
+    for (i = 0; i < nu && v[i] == 0; i++) ;
+    if (i == nu) continue;
+    memcpy(basis+nrows*nu, v, sizeof(int)*nu);
+    pivot[nrows] = i;
+    rows[nrows] = c;
+    nrows++;
+  }
+  if (nrows < nu) goto done;
+
+  /* D_U = inv * (P_rows - M_rows,known * D_known).  Each erased data device
+     becomes a dot product over the known data and the chosen parities:
+     exactly k terms. */
+
+  for (a = 0; a < nu; a++) {
+    for (b = 0; b < nu; b++) sub[a*nu+b] = coding_row(k, matrix, rows[a])[unknown[b]];
+  }
+  if (jerasure_invert_matrix(sub, inv, nu, w) < 0) goto done;
+
+  for (b = 0; b < nu; b++) {
+    s = new_step(p, k, unknown[b]);
+    if (s == NULL) goto done;
+    t = 0;
+    for (j = 0; j < k; j++) {
+      for (i = 0; i < nu && unknown[i] != j; i++) ;
+      if (i < nu) continue;
+      f = 0;
+      for (a = 0; a < nu; a++) {
+        f ^= galois_single_multiply(inv[b*nu+a], coding_row(k, matrix, rows[a])[j], w);
+      }
+      s->src[t] = j;
+      s->coef[t] = f;
+      t++;
+    }
+    for (a = 0; a < nu; a++) {
+      s->src[t] = rows[a];
+      s->coef[t] = inv[b*nu+a];
+      t++;
+    }
+  }
+  ok = 0;
+
+done:
+  free(basis); free(pivot); free(v); free(rows); free(sub); free(inv);
+  return ok;
+}
+
+/* Builds the steps that rebuild every erased device, in order.  Returns 0
+   or -1. */
+
+static int make_plan(int k, int l, int r, int w, int *matrix, int *erasures, lrc_plan *p)
+{
+  int *erased, *lost, *unknown, n, nu, g, i, t, c, ok;
+  lrc_step *s;
+
+  p->nsteps = 0;
+  p->steps = talloc(lrc_step, k+l+r);
+  erased = talloc(int, k+l+r);
+  lost = talloc(int, l);
+  unknown = talloc(int, k);
+  ok = -1;
+  if (p->steps == NULL || erased == NULL || lost == NULL || unknown == NULL) goto done;
+
+  bzero(erased, sizeof(int)*(k+l+r));
+  for (i = 0; erasures[i] != -1; i++) {
+    if (erasures[i] < 0 || erasures[i] >= k+l+r) goto done;
+    erased[erasures[i]] = 1;
+  }
+
+  /* Count the erasures of each group, its local parity included */
+
+  bzero(lost, sizeof(int)*l);
+  for (i = 0; i < k; i++) lost[lrc_group(k, l, i)] += erased[i];
+  for (g = 0; g < l; g++) lost[g] += erased[k+g];
+
+  /* Groups with one erasure are repaired locally */
+
+  for (n = 0; n < k+l; n++) {
+    if (!erased[n]) continue;
+    g = (n < k) ? lrc_group(k, l, n) : n-k;
+    if (lost[g] != 1) continue;
+    s = new_step(p, k, n);
+    if (s == NULL) goto done;
+    t = 0;
+    for (i = 0; i < k; i++) {
+      if (i != n && lrc_group(k, l, i) == g) {
+        s->src[t] = i;
+        s->coef[t++] = 1;
+      }
+    }
+    if (n < k) {
+      s->src[t] = k+g;
+      s->coef[t++] = 1;
+    }
+  }
+
+  /* The other erased data are decoded together */
+
+  nu = 0;
+  for (i = 0; i < k; i++) {
+    if (erased[i] && lost[lrc_group(k, l, i)] > 1) unknown[nu++] = i;
+  }
+  if (nu > 0 && plan_global(k, l, r, w, matrix, erased, unknown, nu, p) < 0) goto done;
+
+  /* Then the parities that are still missing are encoded again */
+
+  for (c = k; c < k+l+r; c++) {
+    if (!erased[c] || (c < k+l && lost[c-k] == 1)) continue;
+    s = new_step(p, k, c);
+    if (s == NULL) goto done;
+    for (i = 0; i < k; i++) {
+      s->src[i] = i;
+      s->coef[i] = coding_row(k, matrix, c)[i];
+    }
+  }
+  ok = 0;
+
+done:
+  free(erased);
+  free(lost);
+  free(unknown);
+  if (ok < 0) {
+    if (p->steps != NULL) free_plan(p);
+    p->steps = NULL;
+    p->nsteps = 0;
+  }
+  return ok;
+}
+
+int lrc_repair_plan(int k, int l, int r, int w, int *matrix, int *erasures, int *reads)
+{
+  lrc_plan p;
+  int *read, *erased, i, j, n;
+
+  if (make_plan(k, l, r, w, matrix, erasures, &p) < 0) return -1;
+
+  read = talloc(int, k+l+r);
+  erased = talloc(int, k+l+r);
+  if (read == NULL || erased == NULL) {
+    free(read);
+    free(erased);
+    free_plan(&p);
+    return -1;
+  }
+  bzero(read, sizeof(int)*(k+l+r));
+  bzero(erased, sizeof(int)*(k+l+r));
+  for (i = 0; erasures[i] != -1; i++) erased[erasures[i]] = 1;
+  for (i = 0; i < p.nsteps; i++) {
+    for (j = 0; j < k; j++) {
+      if (p.steps[i].coef[j] != 0 && !erased[p.steps[i].src[j]]) read[p.steps[i].src[j]] = 1;
+    }
+  }
+
+  n = 0;
+  for (i = 0; i < k+l+r; i++) if (read[i]) reads[n++] = i;
+  reads[n] = -1;
+
+  free(read);
+  free(erased);
+  free_plan(&p);
+  return n;
+}
+
+int lrc_decode(int k, int l, int r, int w, int *matrix, int *erasures,
+               char **data_ptrs, char **coding_ptrs, int size)
+{
+  lrc_plan p;
+  int i;
+
+  if (make_plan(k, l, r, w, matrix, erasures, &p) < 0) return -1;
+  for (i = 0; i < p.nsteps; i++) {
+    jerasure_matrix_dotprod(k, w, p.steps[i].coef, p.steps[i].src, p.steps[i].dest,
+                            data_ptrs, coding_ptrs, size);
+  }
+  free_plan(&p);
+  return 0;
+}
@@ -48,6 +48,11 @@
 #include <stdlib.h>
 #include <string.h>
 #include <assert.h>
+#include <pthread.h>
+
+#ifdef __SSSE3__
+#include <tmmintrin.h>
+#endif
 
 #include <gf_complete.h>
 #include "galois.h"
@@ -98,51 +103,45 @@ int *reed_sol_vandermonde_coding_matrix(int k, int m, int w)
   return dist;
 }
 
-static int prim08 = -1;
-static gf_t GF08;
+/* The multiply-by-two fields are set up once per w with pthread_once so
+   that concurrent RAID-6 encoders never see a partially built gf_t. */
 
-void reed_sol_galois_w08_region_multby_2(char *region, int nbytes)
+static gf_t GF08, GF16, GF32;
+static pthread_once_t GF08_once = PTHREAD_ONCE_INIT;
+static pthread_once_t GF16_once = PTHREAD_ONCE_INIT;
+static pthread_once_t GF32_once = PTHREAD_ONCE_INIT;
+
+static void init_multby_2_field(gf_t *gf, int w)
 {
-  if (prim08 == -1) {
-    prim08 = galois_single_multiply((1 << 7), 2, 8);
-    if (!gf_init_hard(&GF08, 8, GF_MULT_BYTWO_b, GF_REGION_DEFAULT, GF_DIVIDE_DEFAULT,
-                      prim08, 0, 0, NULL, NULL)) {
-      fprintf(stderr, "Error: Can't initialize the GF for reed_sol_galois_w08_region_multby_2\n");
-      assert(0);
-    }
+  int prim;
+
+  prim = galois_single_multiply((1 << (w-1)), 2, w);
+  if (!gf_init_hard(gf, w, GF_MULT_BYTWO_b, GF_REGION_DEFAULT, GF_DIVIDE_DEFAULT,
+                    prim, 0, 0, NULL, NULL)) {
+    fprintf(stderr, "Error: Can't initialize the GF for reed_sol_galois_w%02d_region_multby_2\n", w);
+    assert(0);
   }
-  GF08.multiply_region.w32(&GF08, region, region, 2, nbytes, 0);
 }
 
-static int prim16 = -1;
-static gf_t GF16;
+static void init_GF08(void) { init_multby_2_field(&GF08, 8); }
+static void init_GF16(void) { init_multby_2_field(&GF16, 16); }
+static void init_GF32(void) { init_multby_2_field(&GF32, 32); }
+
+void reed_sol_galois_w08_region_multby_2(char *region, int nbytes)
+{
+  pthread_once(&GF08_once, init_GF08);
+  GF08.multiply_region.w32(&GF08, region, region, 2, nbytes, 0);
+}
 
 void reed_sol_galois_w16_region_multby_2(char *region, int nbytes)
 {
-  if (prim16 == -1) {
-    prim16 = galois_single_multiply((1 << 15), 2, 16);
-    if (!gf_init_hard(&GF16, 16, GF_MULT_BYTWO_b, GF_REGION_DEFAULT, GF_DIVIDE_DEFAULT,
-                      prim16, 0, 0, NULL, NULL)) {
-      fprintf(stderr, "Error: Can't initialize the GF for reed_sol_galois_w16_region_multby_2\n");
-      assert(0);
-    }
-  }
+  pthread_once(&GF16_once, init_GF16);
   GF16.multiply_region.w32(&GF16, region, region, 2, nbytes, 0);
 }
 
-static int prim32 = -1;
-static gf_t GF32;
-
 void reed_sol_galois_w32_region_multby_2(char *region, int nbytes)
 {
-  if (prim32 == -1) {
-    prim32 = galois_single_multiply((1 << 31), 2, 32);
-    if (!gf_init_hard(&GF32, 32, GF_MULT_BYTWO_b, GF_REGION_DEFAULT, GF_DIVIDE_DEFAULT,
-                      prim32, 0, 0, NULL, NULL)) {
-      fprintf(stderr, "Error: Can't initialize the GF for reed_sol_galois_w32_region_multby_2\n");
-      assert(0);
-    }
-  }
+  pthread_once(&GF32_once, init_GF32);
   GF32.multiply_region.w32(&GF32, region, region, 2, nbytes, 0);
 }
 
@@ -173,6 +172,210 @@ int reed_sol_r6_encode(int k, int w, char **data_ptrs, char **coding_ptrs, int s
   return 1;
 }
 
+/* RAID-6 decoding.  With P = sum(Dj) and Q = sum(2^j Dj), every pattern
+   of one or two erasures has a closed form.  P' and Q' are P and Q of the
+   surviving data only (the lost devices counted as zero); they are built
+   in the buffers of the lost devices, as the Linux md driver does.  Then,
+   with p = P+P' and q = Q+Q':
+
+     D      Dx = p                  DP   Dx = q / 2^x, then P
+     DQ     Dx = p, then Q          PQ   P and Q
+     DD     Dx = A p + B q,  Dy = p + Dx,
+            with A = 2^y / (2^x + 2^y) and B = 1 / (2^x + 2^y)
+
+   For w = 8, the last step is one pass over the four regions, using
+   pshufb nibble tables when SSSE3 is available. */
+
+/* Puts the XOR of the data, skipping devices x and y, into dest */
+
+static void r6_partial_p(int k, char **data_ptrs, int x, int y, char *dest, int size)
+{
+  int i, started;
+
+  started = 0;
+  for (i = 0; i < k; i++) {
+    if (i == x || i == y) continue;
+    if (started) {
+      galois_region_xor(data_ptrs[i], dest, size);
+    } else {
+      memcpy(dest, data_ptrs[i], size);
+      started = 1;
+    }
+  }
+  if (!started) bzero(dest, size);
+}
+
+static int r6_power_of_2(int e, int w)
+{
+  int i, x;
+
+  x = 1;
+  for (i = 0; i < e; i++) x = galois_single_multiply(x, 2, w);
+  return x;
+}
+
+/* Puts sum(2^j Dj), skipping devices x and y, into dest.  Each device is
+   multiplied and added in one pass with a prepared table, rather than by
+   Horner's rule, which also rewrites dest for every device. */
+
+static void r6_partial_q(int k, int w, char **data_ptrs, int x, int y, char *dest, int size)
+{
+  galois_prepared_t prep;
+  int i, g, started;
+
+  started = 0;
+  g = 1;
+  for (i = 0; i < k; i++) {
+    if (i != x && i != y) {
+      if (g == 1) {
+        if (started) galois_region_xor(data_ptrs[i], dest, size);
+        else memcpy(dest, data_ptrs[i], size);
+      } else {
+        galois_prepare_multiply(g, w, &prep);
+        galois_region_multiply_prepared(data_ptrs[i], &prep, size, dest, started);
+      }
+      started = 1;
+    }
+    g = galois_single_multiply(g, 2, w);
+  }
+  if (!started) bzero(dest, size);
+}
+
+/* dx holds Q', dy holds P'.  Leaves Dx in dx and Dy in dy. */
+
+static void r6_recover_two_data_w08(char *dx, char *dy, char *p, char *q, int a, int b, int size)
+{
+  unsigned char a_lo[16], a_hi[16], b_lo[16], b_hi[16];
+  unsigned char *x8, *y8, *p8, *q8, pv, qv, v;
+  int i;
+
+  for (i = 0; i < 16; i++) {
+    a_lo[i] = galois_single_multiply(i, a, 8);
+    a_hi[i] = galois_single_multiply(i << 4, a, 8);
+    b_lo[i] = galois_single_multiply(i, b, 8);
+    b_hi[i] = galois_single_multiply(i << 4, b, 8);
+  }
+  x8 = (unsigned char *) dx;
+  y8 = (unsigned char *) dy;
+  p8 = (unsigned char *) p;
+  q8 = (unsigned char *) q;
+  i = 0;
+
+#ifdef __SSSE3__
+  {
+    __m128i alo, ahi, blo, bhi, mask, pp, qq, r;
+
+    alo = _mm_loadu_si128((__m128i *) a_lo);
+    ahi = _mm_loadu_si128((__m128i *) a_hi);
+    blo = _mm_loadu_si128((__m128i *) b_lo);
+    bhi = _mm_loadu_si128((__m128i *) b_hi);
+    mask = _mm_set1_epi8(0x0f);
+    for (; i + 16 <= size; i += 16) {
+      pp = _mm_xor_si128(_mm_loadu_si128((__m128i *) (p8+i)), _mm_loadu_si128((__m128i *) (y8+i)));
+      qq = _mm_xor_si128(_mm_loadu_si128((__m128i *) (q8+i)), _mm_loadu_si128((__m128i *) (x8+i)));
+      r = _mm_xor_si128(_mm_shuffle_epi8(alo, _mm_and_si128(pp, mask)),
+                        _mm_shuffle_epi8(ahi, _mm_and_si128(_mm_srli_epi64(pp, 4), mask)));
+      r = _mm_xor_si128(r, _mm_shuffle_epi8(blo, _mm_and_si128(qq, mask)));
+      r = _mm_xor_si128(r, _mm_shuffle_epi8(bhi, _mm_and_si128(_mm_srli_epi64(qq, 4), mask)));
+      _mm_storeu_si128((__m128i *) (x8+i), r);
+      _mm_storeu_si128((__m128i *) (y8+i), _mm_xor_si128(pp, r));
+    }
+  }
+#endif
+
+  for (; i < size; i++) {
+    pv = p8[i] ^ y8[i];
+    qv = q8[i] ^ x8[i];
+    v = a_lo[pv & 0xf] ^ a_hi[pv >> 4] ^ b_lo[qv & 0xf] ^ b_hi[qv >> 4];
+    x8[i] = v;
+    y8[i] = pv ^ v;
+  }
+}
+
+static void r6_recover_two_data(int w, char *dx, char *dy, char *p, char *q, int a, int b, int size)
+{
+  galois_prepared_t pa, pb;
+
+  if (w == 8) {
+    r6_recover_two_data_w08(dx, dy, p, q, a, b, size);
+    return;
+  }
+  galois_region_xor(p, dy, size);
+  galois_region_xor(q, dx, size);
+  galois_prepare_multiply(a, w, &pa);
+  galois_prepare_multiply(b, w, &pb);
+  galois_region_multiply_prepared(dx, &pb, size, NULL, 0);
+  galois_region_multiply_prepared(dy, &pa, size, dx, 1);
+  galois_region_xor(dx, dy, size);
+}
+
+int reed_sol_r6_decode(int k, int w, int *erasures, char **data_ptrs, char **coding_ptrs, int size)
+{
+  int i, x, y, p_lost, q_lost, n, gx, gy, inv;
+  galois_prepared_t prep;
+
+  if (w != 8 && w != 16 && w != 32) return -1;
+
+  x = -1;
+  y = -1;
+  p_lost = 0;
+  q_lost = 0;
+  n = 0;
+  for (i = 0; erasures[i] != -1; i++) {
+    if (erasures[i] < 0 || erasures[i] >= k+2) return -1;
+    if (erasures[i] == k) {
+      n += !p_lost;
+      p_lost = 1;
+    } else if (erasures[i] == k+1) {
+      n += !q_lost;
+      q_lost = 1;
+    } else if (erasures[i] != x && erasures[i] != y) {
+      if (x == -1) x = erasures[i]; else y = erasures[i];
+      n++;
+    }
+    if (n > 2) return -1;
+  }
+  if (y != -1 && y < x) {
+    i = x; x = y; y = i;
+  }
+
+  if (y != -1) {
+
+    /* DD */
+
+    r6_partial_p(k, data_ptrs, x, y, data_ptrs[y], size);
+    r6_partial_q(k, w, data_ptrs, x, y, data_ptrs[x], size);
+    gx = r6_power_of_2(x, w);
+    gy = r6_power_of_2(y, w);
+    inv = galois_single_divide(1, gx ^ gy, w);
+    r6_recover_two_data(w, data_ptrs[x], data_ptrs[y], coding_ptrs[0], coding_ptrs[1],
+                        galois_single_multiply(gy, inv, w), inv, size);
+    return 0;
+  }
+
+  if (x != -1 && !p_lost) {
+
+    /* D and DQ */
+
+    r6_partial_p(k, data_ptrs, x, -1, data_ptrs[x], size);
+    galois_region_xor(coding_ptrs[0], data_ptrs[x], size);
+  } else if (x != -1) {
+
+    /* DP */
+
+    r6_partial_q(k, w, data_ptrs, x, -1, data_ptrs[x], size);
+    galois_region_xor(coding_ptrs[1], data_ptrs[x], size);
+    galois_prepare_multiply(galois_single_divide(1, r6_power_of_2(x, w), w), w, &prep);
+    galois_region_multiply_prepared(data_ptrs[x], &prep, size, NULL, 0);
+  }
+
+  /* P and Q are rebuilt from the (now whole) data */
+
+  if (p_lost) r6_partial_p(k, data_ptrs, -1, -1, coding_ptrs[0], size);
+  if (q_lost) r6_partial_q(k, w, data_ptrs, -1, -1, coding_ptrs[1], size);
+  return 0;
+}
+
 int *reed_sol_extended_vandermonde_matrix(int rows, int cols, int w)
 {
   int *vdm;
@@ -300,3 +503,211 @@ int *reed_sol_big_vandermonde_distribution_matrix(int rows, int cols, int w)
   return dist;
 }
 
+
+/* ------------------------------------------------------------ */
+/* Error correction.  The parity check matrix of the code is [ A | I ],
+   where A is the m*k coding matrix, so the syndrome of a stripe is A times
+   the data, plus the coding.  The syndrome is computed with the region
+   operations, a tile at a time, and only the words where it is not zero
+   are looked at one by one. */
+
+/* Entry r of column j of the parity check matrix */
+
+static int check_entry(int k, int *matrix, int r, int j)
+{
+  if (j < k) return matrix[r*k+j];
+  return (j-k == r) ? 1 : 0;
+}
+
+/* Solves for error values val at the e devices in pos, so that the
+   columns of the parity check matrix at pos, times val, equal the m-word
+   syndrome s.  Returns 0 if there is a solution and every value is
+   non-zero, and -1 otherwise. */
+
+static int solve_error_values(int k, int m, int w, int *matrix, int *s,
+                              int e, int *pos, int *val)
+{
+  int a[32*33];
+  int r, c, i, piv, tmp, f;
+
+  for (r = 0; r < m; r++) {
+    for (c = 0; c < e; c++) a[r*(e+1)+c] = check_entry(k, matrix, r, pos[c]);
+    a[r*(e+1)+e] = s[r];
+  }
+
+  /* Gaussian elimination on the m*(e+1) augmented matrix */
+
+  piv = 0;
+  for (c = 0; c < e; c++) {
+    for (r = piv; r < m && a[r*(e+1)+c] == 0; r++) ;
+    if (r == m) return -1;
+    if (r != piv) {
+      for (i = 0; i <= e; i++) {
+        tmp = a[r*(e+1)+i];
+        a[r*(e+1)+i] = a[piv*(e+1)+i];
+        a[piv*(e+1)+i] = tmp;
+      }
+    }
+    tmp = galois_single_divide(1, a[piv*(e+1)+c], w);
+    for (i = c; i <= e; i++) a[piv*(e+1)+i] = galois_single_multiply(a[piv*(e+1)+i], tmp, w);
+    for (r = 0; r < m; r++) {
+      f = a[r*(e+1)+c];
+      if (r == piv || f == 0) continue;
+      for (i = c; i <= e; i++) {
+        a[r*(e+1)+i] ^= galois_single_multiply(f, a[piv*(e+1)+i], w);
+      }
+    }
+    piv++;
+  }
+
+  /* The rows below the pivots must be consistent */
+
+  for (r = piv; r < m; r++) if (a[r*(e+1)+e] != 0) return -1;
+  for (c = 0; c < e; c++) {
+    val[c] = a[c*(e+1)+e];
+    if (val[c] == 0) return -1;
+  }
+  return 0;
+}
+
+/* Finds the fewest devices, at most t, whose errors explain the syndrome
+   s.  Since the code is MDS, that set is unique.  The set found last time
+   is tried first, because errors tend to come in runs on one device.
+   Returns the number of errors, or -1. */
+
+static int locate_errors(int k, int m, int w, int *matrix, int *s, int t,
+                         int *pos, int *val, int *last, int nlast)
+{
+  int e, i, n;
+
+  if (nlast > 0) {
+    memcpy(pos, last, sizeof(int)*nlast);
+    if (solve_error_values(k, m, w, matrix, s, nlast, pos, val) == 0) return nlast;
+  }
+
+  n = k+m;
+  for (e = 1; e <= t; e++) {
+    for (i = 0; i < e; i++) pos[i] = i;
+    while (1) {
+      if (solve_error_values(k, m, w, matrix, s, e, pos, val) == 0) return e;
+
+      /* Next combination of e devices out of n */
+      for (i = e-1; i >= 0 && pos[i] == n-e+i; i--) ;
+      if (i < 0) break;
+      pos[i]++;
+      for (i++; i < e; i++) pos[i] = pos[i-1]+1;
+    }
+  }
+  return -1;
+}
+
+static int get_word(char *p, int w)
+{
+  uint16_t w16;
+  uint32_t w32;
+
+  switch (w) {
+    case 8: return *((unsigned char *) p);
+    case 16: memcpy(&w16, p, 2); return w16;
+    default: memcpy(&w32, p, 4); return (int) w32;
+  }
+}
+
+static void xor_word(char *p, int w, int val)
+{
+  uint16_t w16;
+  uint32_t w32;
+
+  switch (w) {
+    case 8: *((unsigned char *) p) ^= val; break;
+    case 16: memcpy(&w16, p, 2); w16 ^= val; memcpy(p, &w16, 2); break;
+    default: memcpy(&w32, p, 4); w32 ^= (uint32_t) val; memcpy(p, &w32, 4); break;
+  }
+}
+
+int reed_sol_vandermonde_correct(int k, int m, int w, int *matrix,
+                                 char **data_ptrs, char **coding_ptrs, int size, int *corrected)
+{
+  char **dptrs, **sptrs, *scratch, *p;
+  int *dest_ids;
+  int s[32], pos[32], val[32], last[32];
+  int i, r, e, t, nlast, wb, tile, off, len, x, zero, fixed, shift;
+
+  if (w != 8 && w != 16 && w != 32) return -1;
+  if (m > 32 || size % (w/8) != 0) return -1;
+
+  t = m/2;
+  wb = w/8;
+  if (corrected != NULL) for (i = 0; i < k+m; i++) corrected[i] = 0;
+
+  tile = jerasure_tile_size(k+m);
+
+  /* The syndromes are multiplied into from the data, so they start at the
+     data's address mod 16, as GF-Complete needs. */
+
+  scratch = talloc(char, tile*m + 16);
+  dptrs = talloc(char *, k);
+  sptrs = talloc(char *, m);
+  dest_ids = talloc(int, m);
+  if (scratch == NULL || dptrs == NULL || sptrs == NULL || dest_ids == NULL) {
+    free(scratch);
+    free(dptrs);
+    free(sptrs);
+    free(dest_ids);
+    return -1;
+  }
+  shift = ((uintptr_t) data_ptrs[0] - (uintptr_t) scratch) & 15;
+  for (i = 0; i < m; i++) {
+    sptrs[i] = scratch + shift + i*tile;
+    dest_ids[i] = k+i;
+  }
+
+  fixed = 0;
+  nlast = 0;
+  for (off = 0; off < size && fixed >= 0; off += tile) {
+    len = size - off;
+    if (len > tile) len = tile;
+
+    /* Syndrome of the tile */
+
+    for (i = 0; i < k; i++) dptrs[i] = data_ptrs[i] + off;
+    jerasure_matrix_multi_dotprod(k, w, m, matrix, NULL, dest_ids, dptrs, sptrs, len);
+    zero = 1;
+    for (r = 0; r < m; r++) {
+      galois_region_xor(coding_ptrs[r] + off, sptrs[r], len);
+      if (zero && !jerasure_region_is_zero(sptrs[r], len)) zero = 0;
+    }
+    if (zero) continue;
+
+    /* Locate and correct the errors in each word with a non-zero syndrome */
+
+    for (x = 0; x < len; x += wb) {
+      zero = 1;
+      for (r = 0; r < m; r++) {
+        s[r] = get_word(sptrs[r]+x, w);
+        if (s[r] != 0) zero = 0;
+      }
+      if (zero) continue;
+
+      e = locate_errors(k, m, w, matrix, s, t, pos, val, last, nlast);
+      if (e < 0) {
+        fixed = -1;
+        break;
+      }
+      for (i = 0; i < e; i++) {
+        p = (pos[i] < k) ? data_ptrs[pos[i]] : coding_ptrs[pos[i]-k];
+        xor_word(p + off + x, w, val[i]);
+        if (corrected != NULL) corrected[pos[i]] = 1;
+      }
+      memcpy(last, pos, sizeof(int)*e);
+      nlast = e;
+      fixed++;
+    }
+  }
+
+  free(scratch);
+  free(dptrs);
+  free(sptrs);
+  free(dest_ids);
+  return fixed;
+}
@@ -0,0 +1,415 @@
+/* *
+ * Copyright (c) 2014, James S. Plank and Kevin Greenan
+ * All rights reserved.
+ *
+ * Jerasure - A C/C++ Library for a Variety of Reed-Solomon and RAID-6 Erasure
+ * Coding Techniques
+ *
+ * Revision 2.0: Galois Field backend now links to GF-Complete
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *  - Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ *  - Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ *
+ *  - Neither the name of the University of Tennessee nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY
+ * WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+
+#include "galois.h"
+#include "reed_sol_fft.h"
+
+#define talloc(type, num) (type *) malloc(sizeof(type)*(num))
+
+#define FFT_BITS 16
+#define FFT_ORDER (1 << FFT_BITS)
+#define FFT_MODULUS (FFT_ORDER - 1)
+
+/* Working set of one pass over a chunk of every device, in bytes. */
+
+#define FFT_WORK_BYTES (1 << 20)
+
+/* Notation, after Lin, Chung and Han.  v_0 .. v_15 is a Cantor basis
+   of the field: v_0 = 1 and v_j^2 + v_j = v_{j-1}.  Point i is the sum of
+   the v_j for the bits j of i, so point i + point e is point i^e, and
+   W_j, the span of v_0 .. v_{j-1}, is the points 0 .. 2^j-1.
+
+     s_j(x) = prod over a in W_j of (x - a)   (GF(2)-linear in x)
+     X_i(x) = prod over the bits j of i of s_j(x)
+
+   With a Cantor basis, s_j(v_j) = 1 and s_j has its coefficients in
+   GF(2), so its derivative is 1.  X_0 .. X_{n-1} is the novel basis of
+   polynomials of degree < n.  Since s_j vanishes on W_j and is linear,
+   a polynomial D = D0 + s_j D1 evaluated on the two halves of the coset
+   W_{j+1} + b is D0 + t D1 and D0 + (1+t) D1, with t = s_j(b).  That
+   gives the butterflies below.
+
+   Skew[j][b >> (j+1)] is s_j(b) for every b that is a multiple of
+   2^(j+1), and Point[i] is point i.  Exp has 2 * FFT_MODULUS entries so
+   that a sum of logs never needs reducing. */
+
+static unsigned short *Log;
+static unsigned short *Exp;
+static unsigned short *Point;
+static unsigned short *Skew[FFT_BITS];
+static int Tables_ok;
+static pthread_once_t Tables_once = PTHREAD_ONCE_INIT;
+
+static int mul(int a, int b)
+{
+  if (a == 0 || b == 0) return 0;
+  return Exp[Log[a] + Log[b]];
+}
+
+static void make_tables(void)
+{
+  int v[FFT_BITS], s[FFT_BITS];
+  int i, j, l, x;
+
+  Log = talloc(unsigned short, FFT_ORDER);
+  Exp = talloc(unsigned short, 2 * FFT_MODULUS);
+  Point = talloc(unsigned short, FFT_ORDER);
+  Skew[0] = talloc(unsigned short, FFT_ORDER);
+  if (Log == NULL || Exp == NULL || Point == NULL || Skew[0] == NULL) return;
+
+  x = 1;
+  for (i = 0; i < FFT_MODULUS; i++) {
+    if (x == 1 && i != 0) return;      /* 2 does not generate the field */
+    Exp[i] = Exp[i + FFT_MODULUS] = x;
+    Log[x] = i;
+    x = galois_single_multiply(x, 2, FFT_BITS);
+  }
+  Log[0] = 0;
+
+  v[0] = 1;
+  for (j = 1; j < FFT_BITS; j++) {
+    for (x = 2; x < FFT_ORDER && (mul(x, x) ^ x) != v[j-1]; x++) ;
+    if (x == FFT_ORDER) return;
+    v[j] = x;
+  }
+  Point[0] = 0;
+  for (i = 1; i < FFT_ORDER; i++) Point[i] = Point[i & (i-1)] ^ v[__builtin_ctz(i)];
+
+  /* s_{j+1}(x) = s_j(x) s_j(x + v_j) = s_j(x) (s_j(x) + 1), so s holds
+     s_j(v_l) for the current j. */
+
+  for (l = 0; l < FFT_BITS; l++) s[l] = v[l];
+  for (j = 0; j < FFT_BITS; j++) {
+    if (s[j] != 1) return;
+    if (j > 0) Skew[j] = Skew[j-1] + (FFT_ORDER >> j);
+    Skew[j][0] = 0;
+    for (i = 1; i < (FFT_ORDER >> (j+1)); i++) {
+      Skew[j][i] = Skew[j][i & (i-1)] ^ s[__builtin_ctz(i) + j + 1];
+    }
+    for (l = 0; l < FFT_BITS; l++) s[l] = mul(s[l], s[l] ^ 1);
+  }
+  Tables_ok = 1;
+}
+
+static int get_tables(void)
+{
+  pthread_once(&Tables_once, make_tables);
+  return Tables_ok;
+}
+
+static int log2_ceil(int n)
+{
+  int l;
+
+  for (l = 0; (1 << l) < n; l++) ;
+  return l;
+}
+
+/* Given the novel basis coefficients of a polynomial of degree < 2^lg
+   in r[0 .. 2^lg-1], fft() overwrites them with its values at the
+   points base .. base + 2^lg - 1.  base must be a multiple of 2^lg.
+   If wanted is not NULL, only the values at the points i for which
+   wanted[i+1] > wanted[i] are needed, and blocks without any are
+   skipped.  ifft() is the inverse. */
+
+static void fft(char **r, int lg, int base, int bytes, int *wanted)
+{
+  int j, h, b, i, t;
+
+  for (j = lg-1; j >= 0; j--) {
+    h = 1 << j;
+    for (b = 0; b < (1 << lg); b += 2*h) {
+      if (wanted != NULL && wanted[b+2*h] == wanted[b]) continue;
+      t = Skew[j][(base + b) >> (j+1)];
+      for (i = b; i < b+h; i++) {
+        if (t != 0) galois_w16_region_multiply(r[i+h], t, bytes, r[i], 1);
+        galois_region_xor(r[i], r[i+h], bytes);
+      }
+    }
+  }
+}
+
+static void ifft(char **r, int lg, int base, int bytes)
+{
+  int j, h, b, i, t;
+
+  for (j = 0; j < lg; j++) {
+    h = 1 << j;
+    for (b = 0; b < (1 << lg); b += 2*h) {
+      t = Skew[j][(base + b) >> (j+1)];
+      for (i = b; i < b+h; i++) {
+        galois_region_xor(r[i], r[i+h], bytes);
+        if (t != 0) galois_w16_region_multiply(r[i+h], t, bytes, r[i], 1);
+      }
+    }
+  }
+}
+
+/* Walsh-Hadamard transform of v[0 .. 2^lg-1], modulo FFT_MODULUS. */
+
+static void fwht(int *v, int lg)
+{
+  int h, b, i, x, y;
+
+  for (h = 1; h < (1 << lg); h <<= 1) {
+    for (b = 0; b < (1 << lg); b += 2*h) {
+      for (i = b; i < b+h; i++) {
+        x = v[i];
+        y = v[i+h];
+        v[i] = (x + y) % FFT_MODULUS;
+        v[i+h] = (x + FFT_MODULUS - y) % FFT_MODULUS;
+      }
+    }
+  }
+}
+
+/* Regions for one pass: n of chunk bytes each, where chunk is a
+   multiple of 64 bytes, or all of size if that is smaller.  The regions
+   stay a multiple of 64 bytes apart even then, so that the field's region
+   multiplies see them all at the same alignment. */
+
+static char **alloc_work(int n, int size, int *chunk)
+{
+  char **r;
+  int i, stride;
+
+  stride = (FFT_WORK_BYTES / n) & ~63;
+  if (stride < 64) stride = 64;
+  if (stride > size) stride = (size + 63) & ~63;
+  if (stride == 0) stride = 64;
+  *chunk = (stride > size) ? size : stride;
+  r = talloc(char *, n);
+  if (r == NULL) return NULL;
+  r[0] = talloc(char, (size_t) n * stride);
+  if (r[0] == NULL) { free(r); return NULL; }
+  for (i = 1; i < n; i++) r[i] = r[i-1] + stride;
+  return r;
+}
+
+static void free_work(char **r)
+{
+  free(r[0]);
+  free(r);
+}
+
+static int bad_parameters(int k, int m, int size)
+{
+  if (k < 1 || m < 1 || m > FFT_ORDER || size < 0 || size % sizeof(long) != 0) return 1;
+  if (k > FFT_ORDER - (1 << log2_ceil(m))) return 1;
+  return !get_tables();
+}
+
+/* The m coding devices are points 0 .. m-1, and data device i is point
+   mo+i, where mo is m rounded up to a power of two.  The points after
+   the data, up to n, hold zeros, and points m .. mo-1 are never stored.
+   The code is every set of values at points 0 .. n-1 whose interpolating
+   polynomial has degree < n-mo, so any mo points determine the rest.
+
+   Equivalently, the sum over the cosets W_mo + b of the polynomials of
+   degree < mo that interpolate each coset is zero.  So the encoder
+   interpolates every block of mo data devices, adds up the results and
+   evaluates the sum on points 0 .. mo-1. */
+
+int reed_sol_fft_encode(int k, int m, char **data_ptrs, char **coding_ptrs, int size)
+{
+  char **acc, **tmp, **dst;
+  int lg, mo, chunk, len, off, blk, i, d;
+
+  if (bad_parameters(k, m, size)) return -1;
+  if (size == 0) return 0;
+  lg = log2_ceil(m);
+  mo = 1 << lg;
+
+  acc = alloc_work(2*mo, size, &chunk);
+  if (acc == NULL) return -1;
+  tmp = acc + mo;
+
+  for (off = 0; off < size; off += chunk) {
+    len = (size - off < chunk) ? size - off : chunk;
+    for (blk = 0; blk*mo < k; blk++) {
+      dst = (blk == 0) ? acc : tmp;
+      for (i = 0; i < mo; i++) {
+        d = blk*mo + i;
+        if (d < k) {
+          memcpy(dst[i], data_ptrs[d] + off, len);
+        } else {
+          memset(dst[i], 0, len);
+        }
+      }
+      ifft(dst, lg, (blk+1)*mo, len);
+      if (blk > 0) {
+        for (i = 0; i < mo; i++) galois_region_xor(tmp[i], acc[i], len);
+      }
+    }
+    fft(acc, lg, 0, len, NULL);
+    for (i = 0; i < m; i++) memcpy(coding_ptrs[i] + off, acc[i], len);
+  }
+
+  free_work(acc);
+  return 0;
+}
+
+/* Decoding uses the erasure locator L(x), the product of (x - e) over the
+   erased points e, including m .. mo-1.  If P is the polynomial of the
+   codeword, R = P L has degree < n and its values are known: zero on the
+   erased points.  Since L(e) = 0, R'(e) = P(e) L'(e).  So the decoder
+   interpolates R, takes its derivative in the novel basis, where
+   X_i' is the sum over the bits j of i of X_{i - 2^j}, and evaluates it.
+
+   Since point x - point e is point x^e, log L(x) is the sum over e of
+   the log of point x^e, which is a dyadic convolution, done with
+   Walsh-Hadamard transforms.  With the log of point 0 taken as 0, the
+   same sum at an erased point is log L'(e). */
+
+int reed_sol_fft_decode(int k, int m, int *erasures, char **data_ptrs, char **coding_ptrs,
+                        int size)
+{
+  int *erased, *lg_loc, *a, *wanted;
+  char **work, **cptrs, *scratch;
+  int lg, mo, n, ln, i, j, e, nerased, data_erased, chunk, len, off, inv, rv;
+
+  if (bad_parameters(k, m, size)) return -1;
+  if (size == 0) return 0;
+  lg = log2_ceil(m);
+  mo = 1 << lg;
+  ln = log2_ceil(mo + k);
+  n = 1 << ln;
+
+  erased = talloc(int, n);
+  if (erased == NULL) return -1;
+  for (i = 0; i < n; i++) erased[i] = (i >= m && i < mo);
+  nerased = 0;
+  data_erased = 0;
+  for (i = 0; erasures[i] != -1; i++) {
+    e = erasures[i];
+    if (e < 0 || e >= k+m) { free(erased); return -1; }
+    e = (e < k) ? mo + e : e - k;
+    if (!erased[e]) {
+      erased[e] = 1;
+      nerased++;
+      if (e >= mo) data_erased = 1;
+    }
+  }
+  if (nerased > m) { free(erased); return -1; }
+
+  /* With the data intact, encoding is cheaper.  The coding devices that
+     are not erased are pointed at a scratch region. */
+
+  if (!data_erased) {
+    rv = 0;
+    if (nerased > 0) {
+      cptrs = talloc(char *, m);
+      scratch = talloc(char, size);
+      if (cptrs == NULL || scratch == NULL) {
+        rv = -1;
+      } else {
+        for (i = 0; i < m; i++) cptrs[i] = erased[i] ? coding_ptrs[i] : scratch;
+        rv = reed_sol_fft_encode(k, m, data_ptrs, cptrs, size);
+      }
+      free(cptrs);
+      free(scratch);
+    }
+    free(erased);
+    return rv;
+  }
+
+  lg_loc = talloc(int, 3*n+1);
+  work = alloc_work(n, size, &chunk);
+  if (lg_loc == NULL || work == NULL) {
+    free(erased);
+    free(lg_loc);
+    if (work != NULL) free_work(work);
+    return -1;
+  }
+
+  a = lg_loc + n;
+  wanted = a + n;
+  wanted[0] = 0;
+  for (i = 0; i < n; i++) wanted[i+1] = wanted[i] + (erased[i] && (i < m || i >= mo));
+  for (i = 0; i < n; i++) {
+    a[i] = erased[i];
+    lg_loc[i] = Log[Point[i]];
+  }
+  fwht(a, ln);
+  fwht(lg_loc, ln);
+  for (i = 0; i < n; i++) lg_loc[i] = (int) (((unsigned) lg_loc[i] * a[i]) % FFT_MODULUS);
+  fwht(lg_loc, ln);
+  inv = 1;
+  for (i = 0; i < ln; i++) inv = (inv * (FFT_ORDER/2)) % FFT_MODULUS;    /* 1/2 = 2^15 */
+  for (i = 0; i < n; i++) lg_loc[i] = (int) (((unsigned) lg_loc[i] * inv) % FFT_MODULUS);
+
+  /* The caller's regions may sit at any offset mod 16, which the work
+     regions cannot all match, so they are copied and multiplied in
+     place in work. */
+
+  for (off = 0; off < size; off += chunk) {
+    len = (size - off < chunk) ? size - off : chunk;
+    for (i = 0; i < n; i++) {
+      if (erased[i] || i >= mo+k) {
+        memset(work[i], 0, len);
+      } else {
+        memcpy(work[i], (i < mo) ? coding_ptrs[i] + off : data_ptrs[i-mo] + off, len);
+        galois_w16_region_multiply(work[i], Exp[lg_loc[i]], len, work[i], 0);
+      }
+    }
+    ifft(work, ln, 0, len);
+    for (i = 0; i < n; i++) {
+      for (j = 0; j < ln; j++) {
+        if (!(i & (1 << j))) galois_region_xor(work[i + (1 << j)], work[i], len);
+      }
+    }
+    fft(work, ln, 0, len, wanted);
+    for (i = 0; i < n; i++) {
+      if (wanted[i+1] > wanted[i]) {
+        galois_w16_region_multiply(work[i], Exp[FFT_MODULUS - lg_loc[i]], len, work[i], 0);
+        memcpy((i < mo) ? coding_ptrs[i] + off : data_ptrs[i-mo] + off, work[i], len);
+      }
+    }
+  }
+
+  free(erased);
+  free(lg_loc);
+  free_work(work);
+  return 0;
+}